@@ -0,0 +1,380 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "MatrixKernels.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Policies of summing many values. The compensated policies rely on strict floating point semantics
+   * and lose their benefit when compiled with -ffast-math or /fp:fast
+   */
+  enum class Accumulation : unsigned
+  {
+    /**
+     * \brief Plain running sum, the fastest
+     */
+    Naive = 0,
+    /**
+     * \brief Recursive halving with error growing logarithmically in the count of values
+     */
+    Pairwise = 1,
+    /**
+     * \brief Running sum with a compensation of the rounding errors fed into the next addition. The errors are obtained
+     * branch-free by Knuth's two-sum, hence they stay exact when an addend exceeds the sum as in the Neumaier variant
+     */
+    KahanNeumaier = 2,
+    /**
+     * \brief Running sum in a wider type: double for float, long double for double, 64-bit for integers
+     */
+    Wide = 3
+  };
+
+  /**
+   * \brief Reductions of contiguous values for each accumulation policy
+   * \tparam T Type of values
+   */
+  template <typename T>
+  struct ReductionKernels
+  {
+    /**
+     * \brief Sum of values, indexed by the accumulation policy
+     */
+    T (*sum[4])(const T * values, std::size_t count) noexcept;
+    /**
+     * \brief Sum of products of values, indexed by the accumulation policy
+     */
+    T (*dot[4])(const T * a, const T * b, std::size_t count) noexcept;
+    /**
+     * \brief Instruction set the kernels were compiled for
+     */
+    InstructionSet instructionSet;
+  };
+
+  namespace Kernels
+  {
+    /**
+     * \brief Count of values below which the pairwise policy sums directly
+     */
+    constexpr std::size_t PairwiseBlockSize = 128;
+
+    /**
+     * \brief Type of the accumulator of the wide policy
+     */
+    template <typename T>
+    using WideType = std::conditional_t<std::is_same<T, float>::value, double,
+      std::conditional_t<std::is_floating_point<T>::value, long double,
+      std::conditional_t<std::is_signed<T>::value, std::int64_t, std::uint64_t>>>;
+  }
+
+  namespace Kernels::Scalar
+  {
+    /**
+     * \brief Adds a value to a compensated sum
+     * \param sum Running sum
+     * \param compensation Rounding error of the running sum, at most half a unit in the last place of the sum
+     * \param value Value to add
+     */
+    template <typename T>
+    inline void TwoSum(T & sum, T & compensation, const T value) noexcept
+    {
+      // Folding the compensation into the addend rounds as well, both errors are carried on
+      const T addend = value + compensation;
+      const T virtualCompensation = addend - value;
+      const T addendError = (value - (addend - virtualCompensation)) + (compensation - virtualCompensation);
+      const T total = sum + addend;
+      const T virtualAddend = total - sum;
+      compensation = (sum - (total - virtualAddend)) + (addend - virtualAddend) + addendError;
+      sum = total;
+    }
+
+    template <typename T, bool Dot>
+    inline T Term(const T * a, const T * b, const std::size_t i) noexcept
+    {
+      if constexpr (Dot)
+        return static_cast<T>(a[i] * b[i]);
+      else
+      {
+        (void)b;
+        return a[i];
+      }
+    }
+
+    template <typename T, bool Dot>
+    T NaiveReduce(const T * a, const T * b, const std::size_t count) noexcept
+    {
+      T result = 0;
+      for (std::size_t i = 0; i < count; ++i)
+        result = static_cast<T>(result + Term<T, Dot>(a, b, i));
+
+      return result;
+    }
+
+    template <typename T, bool Dot>
+    T KahanReduce(const T * a, const T * b, const std::size_t count) noexcept
+    {
+      T sum = 0, compensation = 0;
+      for (std::size_t i = 0; i < count; ++i)
+        TwoSum(sum, compensation, Term<T, Dot>(a, b, i));
+
+      return sum + compensation;
+    }
+
+    template <typename T, bool Dot>
+    T PairwiseReduce(const T * a, const T * b, const std::size_t count) noexcept
+    {
+      if (count <= PairwiseBlockSize)
+        return NaiveReduce<T, Dot>(a, b, count);
+
+      const auto half = count / 2;
+      return PairwiseReduce<T, Dot>(a, b, half) + PairwiseReduce<T, Dot>(a + half, Dot ? b + half : b, count - half);
+    }
+
+    template <typename T, bool Dot>
+    T WideReduce(const T * a, const T * b, const std::size_t count) noexcept
+    {
+      using TWide = WideType<T>;
+      TWide result = 0;
+      for (std::size_t i = 0; i < count; ++i)
+        if constexpr (Dot)
+          result += static_cast<TWide>(a[i]) * static_cast<TWide>(b[i]);
+        else
+        {
+          (void)b;
+          result += static_cast<TWide>(a[i]);
+        }
+
+      return static_cast<T>(result);
+    }
+
+    template <typename T> T SumNaive(const T * values, const std::size_t count) noexcept { return NaiveReduce<T, false>(values, nullptr, count); }
+    template <typename T> T SumPairwise(const T * values, const std::size_t count) noexcept { return PairwiseReduce<T, false>(values, nullptr, count); }
+    template <typename T> T SumKahan(const T * values, const std::size_t count) noexcept { return KahanReduce<T, false>(values, nullptr, count); }
+    template <typename T> T SumWide(const T * values, const std::size_t count) noexcept { return WideReduce<T, false>(values, nullptr, count); }
+    template <typename T> T DotNaive(const T * a, const T * b, const std::size_t count) noexcept { return NaiveReduce<T, true>(a, b, count); }
+    template <typename T> T DotPairwise(const T * a, const T * b, const std::size_t count) noexcept { return PairwiseReduce<T, true>(a, b, count); }
+    template <typename T> T DotKahan(const T * a, const T * b, const std::size_t count) noexcept { return KahanReduce<T, true>(a, b, count); }
+    template <typename T> T DotWide(const T * a, const T * b, const std::size_t count) noexcept { return WideReduce<T, true>(a, b, count); }
+  }
+
+#ifdef COMMON_MATH_X86
+  /**
+   * \brief Defines the floating point reductions in terms of the vector primitives of the enclosing namespace.
+   * Each lane keeps its own sum and compensation, the lanes are combined in a fixed order at the end
+   */
+#define COMMON_MATH_DEFINE_REDUCTION_KERNELS \
+  template <typename T, typename TVector> \
+  void StoreLanes(T * lanes, const TVector vector) noexcept { Store(lanes, vector); } \
+  template <typename T, bool Dot> \
+  auto Term(const T * a, const T * b, const std::size_t i) noexcept \
+  { \
+    if constexpr (Dot) return MultiplyVectors(Load(a + i), Load(b + i)); \
+    else { (void)b; return Load(a + i); } \
+  } \
+  template <typename T, bool Dot> \
+  T NaiveReduce(const T * a, const T * b, const std::size_t count) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    auto first = Broadcast(T(0)), second = first; \
+    std::size_t i = 0; \
+    for (; i + 2 * width <= count; i += 2 * width) \
+      if constexpr (Dot) \
+      { \
+        first = MultiplyAddVectors(Load(a + i), Load(b + i), first); \
+        second = MultiplyAddVectors(Load(a + i + width), Load(b + i + width), second); \
+      } \
+      else \
+      { \
+        first = AddVectors(first, Load(a + i)); \
+        second = AddVectors(second, Load(a + i + width)); \
+      } \
+    T lanes[width]; \
+    StoreLanes(lanes, AddVectors(first, second)); \
+    T result = 0; \
+    for (std::size_t lane = 0; lane < width; ++lane) result += lanes[lane]; \
+    for (; i < count; ++i) result += Scalar::Term<T, Dot>(a, b, i); \
+    return result; \
+  } \
+  template <typename T, bool Dot> \
+  T KahanReduce(const T * a, const T * b, const std::size_t count) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    auto sum = Broadcast(T(0)), compensation = sum; \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) \
+    { \
+      const auto value = Term<T, Dot>(a, b, i); \
+      const auto addend = AddVectors(value, compensation); \
+      const auto virtualCompensation = SubtractVectors(addend, value); \
+      const auto addendError = AddVectors(SubtractVectors(value, SubtractVectors(addend, virtualCompensation)), SubtractVectors(compensation, virtualCompensation)); \
+      const auto total = AddVectors(sum, addend); \
+      const auto virtualAddend = SubtractVectors(total, sum); \
+      compensation = AddVectors(AddVectors(SubtractVectors(sum, SubtractVectors(total, virtualAddend)), SubtractVectors(addend, virtualAddend)), addendError); \
+      sum = total; \
+    } \
+    T sums[width], compensations[width]; \
+    StoreLanes(sums, sum); \
+    StoreLanes(compensations, compensation); \
+    T result = 0, error = 0; \
+    for (std::size_t lane = 0; lane < width; ++lane) \
+    { \
+      Scalar::TwoSum(result, error, sums[lane]); \
+      Scalar::TwoSum(result, error, compensations[lane]); \
+    } \
+    for (; i < count; ++i) Scalar::TwoSum(result, error, Scalar::Term<T, Dot>(a, b, i)); \
+    return result + error; \
+  } \
+  template <typename T, bool Dot> \
+  T PairwiseReduce(const T * a, const T * b, const std::size_t count) noexcept \
+  { \
+    if (count <= PairwiseBlockSize) return NaiveReduce<T, Dot>(a, b, count); \
+    const auto half = count / 2; \
+    return PairwiseReduce<T, Dot>(a, b, half) + PairwiseReduce<T, Dot>(a + half, Dot ? b + half : b, count - half); \
+  } \
+  template <typename T, bool Dot> \
+  T WideReduce(const T * a, const T * b, const std::size_t count) noexcept \
+  { \
+    if constexpr (std::is_same<T, float>::value) \
+    { \
+      constexpr std::size_t width = VectorBytes / sizeof(double); \
+      auto sum = Broadcast(0.0); \
+      std::size_t i = 0; \
+      for (; i + width <= count; i += width) \
+        if constexpr (Dot) sum = MultiplyAddVectors(LoadWide(a + i), LoadWide(b + i), sum); \
+        else sum = AddVectors(sum, LoadWide(a + i)); \
+      double lanes[width]; \
+      StoreLanes(lanes, sum); \
+      double result = 0; \
+      for (std::size_t lane = 0; lane < width; ++lane) result += lanes[lane]; \
+      for (; i < count; ++i) \
+        if constexpr (Dot) result += static_cast<double>(a[i]) * b[i]; \
+        else result += a[i]; \
+      return static_cast<float>(result); \
+    } \
+    else \
+      return Scalar::WideReduce<T, Dot>(a, b, count); \
+  } \
+  template <typename T> T SumNaive(const T * values, const std::size_t count) noexcept { return NaiveReduce<T, false>(values, nullptr, count); } \
+  template <typename T> T SumPairwise(const T * values, const std::size_t count) noexcept { return PairwiseReduce<T, false>(values, nullptr, count); } \
+  template <typename T> T SumKahan(const T * values, const std::size_t count) noexcept { return KahanReduce<T, false>(values, nullptr, count); } \
+  template <typename T> T SumWide(const T * values, const std::size_t count) noexcept { return WideReduce<T, false>(values, nullptr, count); } \
+  template <typename T> T DotNaive(const T * a, const T * b, const std::size_t count) noexcept { return NaiveReduce<T, true>(a, b, count); } \
+  template <typename T> T DotPairwise(const T * a, const T * b, const std::size_t count) noexcept { return PairwiseReduce<T, true>(a, b, count); } \
+  template <typename T> T DotKahan(const T * a, const T * b, const std::size_t count) noexcept { return KahanReduce<T, true>(a, b, count); } \
+  template <typename T> T DotWide(const T * a, const T * b, const std::size_t count) noexcept { return WideReduce<T, true>(a, b, count); }
+
+  COMMON_MATH_TARGET_BEGIN("sse4.2")
+  namespace Kernels::Sse42
+  {
+    inline __m128d LoadWide(const float * p) noexcept { return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)))); }
+
+    COMMON_MATH_DEFINE_REDUCTION_KERNELS
+  }
+  COMMON_MATH_TARGET_END
+
+  COMMON_MATH_TARGET_BEGIN("avx2,fma")
+  namespace Kernels::Avx2
+  {
+    inline __m256d LoadWide(const float * p) noexcept { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+    COMMON_MATH_DEFINE_REDUCTION_KERNELS
+  }
+  COMMON_MATH_TARGET_END
+
+  COMMON_MATH_TARGET_BEGIN("avx512f")
+  namespace Kernels::Avx512
+  {
+    inline __m512d LoadWide(const float * p) noexcept { return _mm512_maskz_cvtps_pd(static_cast<__mmask8>(0xFF), _mm256_loadu_ps(p)); }
+
+    COMMON_MATH_DEFINE_REDUCTION_KERNELS
+  }
+  COMMON_MATH_TARGET_END
+
+#undef COMMON_MATH_DEFINE_REDUCTION_KERNELS
+#endif
+
+#define COMMON_MATH_REDUCTION_KERNELS(isa) \
+  { { Kernels::isa::SumNaive<T>, Kernels::isa::SumPairwise<T>, Kernels::isa::SumKahan<T>, Kernels::isa::SumWide<T> }, \
+    { Kernels::isa::DotNaive<T>, Kernels::isa::DotPairwise<T>, Kernels::isa::DotKahan<T>, Kernels::isa::DotWide<T> }, InstructionSet::isa }
+
+  /**
+   * \brief Selects the reductions matching the instruction set chosen by the dispatcher
+   * \tparam T Type of values
+   * \param instructionSet Instruction set to select the reductions for
+   * \return Reductions of the most capable variant not exceeding given instruction set
+   */
+  template <typename T>
+  ReductionKernels<T> SelectReductionKernels(const InstructionSet instructionSet) noexcept
+  {
+#ifdef COMMON_MATH_X86
+    if constexpr (std::is_same<T, float>::value || std::is_same<T, double>::value)
+      switch (instructionSet)
+      {
+      case InstructionSet::Avx512:
+        return COMMON_MATH_REDUCTION_KERNELS(Avx512);
+      case InstructionSet::Avx2:
+        return COMMON_MATH_REDUCTION_KERNELS(Avx2);
+      case InstructionSet::Sse42:
+        return COMMON_MATH_REDUCTION_KERNELS(Sse42);
+      default:
+        break;
+      }
+#endif
+    (void)instructionSet;
+    // Integer sums are exact, only the wide accumulator changes the result by avoiding overflow
+    if constexpr (std::is_integral<T>::value)
+      return { { Kernels::Scalar::SumNaive<T>, Kernels::Scalar::SumNaive<T>, Kernels::Scalar::SumNaive<T>, Kernels::Scalar::SumWide<T> },
+        { Kernels::Scalar::DotNaive<T>, Kernels::Scalar::DotNaive<T>, Kernels::Scalar::DotNaive<T>, Kernels::Scalar::DotWide<T> }, InstructionSet::Scalar };
+    else
+      return COMMON_MATH_REDUCTION_KERNELS(Scalar);
+  }
+
+#undef COMMON_MATH_REDUCTION_KERNELS
+
+  /**
+   * \brief Retrieves the reductions selected for the executing processor
+   * \tparam T Type of values
+   * \return Selected reductions
+   */
+  template <typename T>
+  const ReductionKernels<T> & GetReductionKernels() noexcept
+  {
+    static const auto kernels = SelectReductionKernels<T>(Dispatch::GetInstructionSet());
+    return kernels;
+  }
+
+  /**
+   * \brief Sums and dot products of contiguous values with a selectable accumulation policy
+   */
+  class Reduction
+  {
+  public:
+    /**
+     * \brief Sums values
+     * \param values Values to sum
+     * \param count Number of values
+     * \param accumulation Accumulation policy
+     * \return Sum of the values
+     */
+    template <typename T>
+    static T Sum(const T * values, const std::size_t count, const Accumulation accumulation = Accumulation::Naive) noexcept
+    {
+      return GetReductionKernels<T>().sum[static_cast<unsigned>(accumulation)](values, count);
+    }
+
+    /**
+     * \brief Sums products of values
+     * \param a First values
+     * \param b Second values
+     * \param count Number of values
+     * \param accumulation Accumulation policy, compensation covers the summation but not the rounding of each product
+     * \return Dot product of the values
+     */
+    template <typename T>
+    static T Dot(const T * a, const T * b, const std::size_t count, const Accumulation accumulation = Accumulation::Naive) noexcept
+    {
+      return GetReductionKernels<T>().dot[static_cast<unsigned>(accumulation)](a, b, count);
+    }
+  };
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <limits>
+#include <type_traits>
+#include "NumberInRange.hpp"
+#include "RangeKernels.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Integer value kept in a given range that is shared between threads without locks, e.g. a round-robin
+   * cursor. The offset from the minimum is stored atomically. Ranges of a power of two length let the offset
+   * overflow freely and wrap it when read, other ranges wrap it by a compare and swap loop.
+   * Objects are aligned to a cache line so that neighbouring counters are not falsely shared.
+   * \tparam T Type of value. Anything but integer types are prohibited.
+   */
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value && std::numeric_limits<T>::is_integer && !std::is_same<T, bool>::value>>
+  class alignas(64) AtomicNumberInRange
+  {
+    using Offset = std::make_unsigned_t<T>;
+
+    /**
+     * \brief Offset of the value from the minimum, not wrapped yet if the length is a power of two
+     */
+    std::atomic<Offset> m_offset;
+    /**
+     * \brief Precomputed constants of the range
+     */
+    const RangeParameters<T> m_range;
+    /**
+     * \brief Mask wrapping the offset, all bits set unless the length is a power of two
+     */
+    const Offset m_mask;
+
+    static Offset CalcMask(const Offset length) noexcept
+    {
+      // 2^N is a multiple of power of two lengths, offsets wrapped by the type stay congruent modulo the length
+      return (length & (length - 1u)) == 0 ? static_cast<Offset>(length - 1u) : std::numeric_limits<Offset>::max();
+    }
+
+    /**
+     * \brief Offsets of power of two lengths wrap with the type, other ranges wrap them by compare and swap
+     */
+    bool IsDeferred() const noexcept { return m_mask != std::numeric_limits<Offset>::max() || m_range.length == 0; }
+
+    T FromOffset(const Offset offset) const noexcept
+    {
+      return static_cast<T>(static_cast<Offset>(static_cast<Offset>(m_range.min) + static_cast<Offset>(offset & m_mask)));
+    }
+
+    /**
+     * \brief Calculates the residue of a delta modulo the length
+     */
+    Offset GetResidue(const T delta) const noexcept
+    {
+      return Kernels::Scalar::AddOffsets(Kernels::Scalar::GetOffset(delta, m_range), m_range.minResidue, m_range);
+    }
+
+  public:
+    /**
+     * \brief Default constructor
+     * \param value Value to hold
+     * \param min Range minimum
+     * \param max Range maximum
+     */
+    AtomicNumberInRange(const T & value, const T & min, const T & max)
+      : m_offset(0),
+      m_range(NumberInRange<T>(min, min, max).GetParameters()),
+      m_mask(CalcMask(m_range.length))
+    {
+      m_offset.store(Kernels::Scalar::GetOffset(value, m_range), std::memory_order_relaxed);
+    }
+
+    AtomicNumberInRange(const AtomicNumberInRange &) = delete;
+    AtomicNumberInRange & operator =(const AtomicNumberInRange &) = delete;
+
+    /**
+     * \brief Getter for the Min property
+     * \return Range Minimum
+     */
+    const T & GetMin() const noexcept { return m_range.min; }
+    /**
+     * \brief Getter for the Max property
+     * \return Range Maximum
+     */
+    const T & GetMax() const noexcept { return m_range.max; }
+    /**
+     * \brief Getter for the LockFree property
+     * \return True if the operations never block
+     */
+    bool IsLockFree() const noexcept { return m_offset.is_lock_free(); }
+
+    /**
+     * \brief Getter for the Value property
+     * \param order Memory ordering of the load
+     * \return Value
+     */
+    T GetValue(const std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+      return FromOffset(m_offset.load(order));
+    }
+    /**
+     * \brief Setter for the Value property
+     * \param value New value to set, it is wrapped into the range
+     * \param order Memory ordering of the store
+     */
+    void SetValue(const T & value, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      m_offset.store(Kernels::Scalar::GetOffset(value, m_range), order);
+    }
+
+    /**
+     * \brief Atomically adds a value, the sum wraps around the range
+     * \param delta Value to add
+     * \param order Memory ordering of the modification
+     * \return Value preceding the addition
+     */
+    T FetchAdd(const T & delta, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      if (IsDeferred())
+        return FromOffset(m_offset.fetch_add(static_cast<Offset>(delta), order));
+
+      const auto residue = GetResidue(delta);
+      auto offset = m_offset.load(std::memory_order_relaxed);
+      while (!m_offset.compare_exchange_weak(offset, Kernels::Scalar::AddOffsets(offset, residue, m_range), order, std::memory_order_relaxed)) { }
+
+      return FromOffset(offset);
+    }
+    /**
+     * \brief Atomically subtracts a value, the difference wraps around the range
+     * \param delta Value to subtract
+     * \param order Memory ordering of the modification
+     * \return Value preceding the subtraction
+     */
+    T FetchSubtract(const T & delta, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      if (IsDeferred())
+        return FromOffset(m_offset.fetch_sub(static_cast<Offset>(delta), order));
+
+      const auto residue = GetResidue(delta);
+      auto offset = m_offset.load(std::memory_order_relaxed);
+      while (!m_offset.compare_exchange_weak(offset, Kernels::Scalar::SubtractOffsets(offset, residue, m_range), order, std::memory_order_relaxed)) { }
+
+      return FromOffset(offset);
+    }
+  };
+}
@@ -0,0 +1,353 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Matrix.hpp"
+
+namespace Common::Math
+{
+  template <typename T>
+  class BandMatrix;
+
+  /**
+   * \brief LU factorization of a band matrix with partial pivoting. The row interchanges widen the upper band
+   * of U by the lower bandwidth, memory and work stay linear in the size of the matrix
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class BandFactorization
+  {
+    friend class BandMatrix<T>;
+
+    unsigned m_size;
+    unsigned m_lower;
+    /**
+     * \brief Number of superdiagonals of U
+     */
+    unsigned m_upper;
+    /**
+     * \brief Rows starting kl columns left of the main diagonal. U occupies the main diagonal and the values
+     * to its right, the multipliers of each elimination step remain below the main diagonal
+     */
+    std::vector<T> m_values;
+    /**
+     * \brief Row exchanged with the pivot row in each step
+     */
+    std::vector<unsigned> m_pivots;
+    /**
+     * \brief True if the number of row interchanges is odd
+     */
+    bool m_negated = false;
+
+    BandFactorization(const unsigned size, const unsigned lower, const unsigned upper)
+      : m_size(size),
+      m_lower(lower),
+      m_upper(upper),
+      m_values(std::size_t(size) * GetWidth()),
+      m_pivots(size) { }
+
+    std::size_t GetWidth() const noexcept { return std::size_t(m_lower) + m_upper + 1; }
+    T & At(const unsigned row, const unsigned column) noexcept { return m_values[row * GetWidth() + column + m_lower - row]; }
+    const T & At(const unsigned row, const unsigned column) const noexcept { return m_values[row * GetWidth() + column + m_lower - row]; }
+
+  public:
+    /**
+     * \brief Getter method for the Size property
+     * \return Number of rows and columns
+     */
+    unsigned GetSize() const noexcept { return m_size; }
+
+    /**
+     * \brief Calculates the determinant as the signed product of the diagonal of U
+     * \return Determinant of the factorized matrix
+     */
+    double GetDeterminant() const noexcept
+    {
+      double determinant = m_negated ? -1 : 1;
+      for (unsigned i = 0; i < m_size; ++i)
+        determinant *= At(i, i);
+
+      return determinant;
+    }
+
+    /**
+     * \brief Solves the system A * x = b in O(n * (kl + ku))
+     * \param vector Right-hand side b
+     * \return Solution x
+     */
+    std::vector<T> Solve(const std::vector<T> & vector) const
+    {
+      if (vector.size() != m_size)
+        throw MatrixDimensionException("Number of rows of the matrix must match size of the right-hand side.");
+
+      // Forward elimination replays the interchanges and multipliers of the factorization
+      std::vector<T> solution(vector);
+      for (unsigned k = 0; k < m_size; ++k)
+      {
+        std::swap(solution[k], solution[m_pivots[k]]);
+        const auto last = std::min(k + m_lower, m_size - 1);
+        for (auto i = k + 1; i <= last; ++i)
+          solution[i] -= At(i, k) * solution[k];
+      }
+
+      // Bands are narrow, plain loops are faster than calls of the vector kernels
+      for (auto i = m_size; i-- > 0;)
+      {
+        const auto * row = &At(i, i);
+        const auto count = std::min(m_upper, m_size - 1 - i);
+        T known = 0;
+        for (unsigned j = 1; j <= count; ++j)
+          known += row[j] * solution[i + j];
+        solution[i] = (solution[i] - known) / row[0];
+      }
+
+      return solution;
+    }
+  };
+
+  /**
+   * \brief Square matrix storing only a band of diagonals around the main one. Row i holds the columns
+   * i - kl to i + ku, values outside of the matrix are kept as zeros
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class BandMatrix
+  {
+    static_assert(std::is_arithmetic<T>::value, "Band matrices can only store arithmetic types.");
+
+    /**
+     * \brief Number of rows and columns
+     */
+    unsigned m_size;
+    /**
+     * \brief Number of subdiagonals, kl
+     */
+    unsigned m_lower;
+    /**
+     * \brief Number of superdiagonals, ku
+     */
+    unsigned m_upper;
+    /**
+     * \brief Rows of the band, kl + ku + 1 values each
+     */
+    std::vector<T> m_values;
+
+    static unsigned ValidateSize(const unsigned size)
+    {
+      if (size == 0)
+        throw std::invalid_argument("Size must be greater than 0.");
+
+      return size;
+    }
+
+    std::size_t GetWidth() const noexcept { return std::size_t(m_lower) + m_upper + 1; }
+
+    bool IsStored(const unsigned row, const unsigned column) const noexcept
+    {
+      return column + m_lower >= row && column <= row + std::size_t(m_upper);
+    }
+
+  public:
+    /**
+     * \brief Constructs a zero matrix
+     * \param size Number of rows and columns
+     * \param lower Number of subdiagonals
+     * \param upper Number of superdiagonals
+     */
+    BandMatrix(const unsigned size, const unsigned lower, const unsigned upper)
+      : m_size(ValidateSize(size)),
+      m_lower(std::min(lower, size - 1)),
+      m_upper(std::min(upper, size - 1)),
+      m_values(std::size_t(size) * GetWidth()) { }
+    /**
+     * \brief Copies a band of a square matrix, values outside of the band are ignored
+     * \param matrix Matrix to copy from
+     * \param lower Number of subdiagonals
+     * \param upper Number of superdiagonals
+     */
+    BandMatrix(const Matrix<T> & matrix, const unsigned lower, const unsigned upper)
+      : BandMatrix(matrix.GetRows(), lower, upper)
+    {
+      if (matrix.GetRows() != matrix.GetColumns())
+        throw std::invalid_argument("Argument " + NAMEOF(matrix) + " must be a NxN matrix.");
+
+      const auto & values = matrix.GetMatrixValues();
+      for (unsigned i = 0; i < m_size; ++i)
+        for (auto j = GetRowBegin(i); j < GetRowEnd(i); ++j)
+          m_values[i * GetWidth() + j + m_lower - i] = values[i][j];
+    }
+
+    /**
+     * \brief Getter method for the Size property
+     * \return Number of rows and columns
+     */
+    unsigned GetSize() const noexcept { return m_size; }
+    /**
+     * \brief Getter method for the Lower property
+     * \return Number of subdiagonals
+     */
+    unsigned GetLower() const noexcept { return m_lower; }
+    /**
+     * \brief Getter method for the Upper property
+     * \return Number of superdiagonals
+     */
+    unsigned GetUpper() const noexcept { return m_upper; }
+
+    /**
+     * \brief Retrieves the column of the first stored value of a row within the matrix
+     * \param row Index of the row
+     * \return Index of the column
+     */
+    unsigned GetRowBegin(const unsigned row) const noexcept { return row > m_lower ? row - m_lower : 0; }
+    /**
+     * \brief Retrieves the column after the last stored value of a row within the matrix
+     * \param row Index of the row
+     * \return Index of the column
+     */
+    unsigned GetRowEnd(const unsigned row) const noexcept { return static_cast<unsigned>(std::min<std::size_t>(std::size_t(row) + m_upper + 1, m_size)); }
+
+    /**
+     * \brief Retrieves a single value
+     * \param row Index of the row
+     * \param column Index of the column
+     * \return Value at given position, zero outside of the band
+     */
+    T Get(const unsigned row, const unsigned column) const noexcept
+    {
+      return IsStored(row, column) ? m_values[row * GetWidth() + column + m_lower - row] : T(0);
+    }
+    /**
+     * \brief Changes a single value
+     * \param row Index of the row
+     * \param column Index of the column, has to lie within the band
+     * \param value Value to set
+     */
+    void Set(const unsigned row, const unsigned column, const T value)
+    {
+      if (row >= m_size || column >= m_size)
+        throw std::invalid_argument("Position is outside of the matrix.");
+      if (!IsStored(row, column))
+        throw std::invalid_argument("Position is outside of the band.");
+
+      m_values[row * GetWidth() + column + m_lower - row] = value;
+    }
+
+    /**
+     * \brief Expands the matrix into full storage
+     * \return Matrix with zeros outside of the band
+     */
+    Matrix<T> ToMatrix() const
+    {
+      std::vector<std::vector<T>> values(m_size, std::vector<T>(m_size));
+      for (unsigned i = 0; i < m_size; ++i)
+        for (auto j = GetRowBegin(i); j < GetRowEnd(i); ++j)
+          values[i][j] = Get(i, j);
+
+      return Matrix<T>(std::move(values));
+    }
+
+    /**
+     * \brief Multiplies the matrix by a column vector in O(n * (kl + ku))
+     * \param vector Values of the vector, one per column
+     * \return Values of the product, one per row
+     */
+    std::vector<T> operator * (const std::vector<T> & vector) const
+    {
+      if (vector.size() != m_size)
+        throw MatrixDimensionException("Number of columns of the matrix must match size of the vector.");
+
+      // Bands are narrow, plain loops are faster than calls of the vector kernels
+      std::vector<T> output(m_size);
+      for (unsigned i = 0; i < m_size; ++i)
+      {
+        const auto begin = GetRowBegin(i);
+        const auto count = GetRowEnd(i) - begin;
+        const auto * row = m_values.data() + i * GetWidth() + begin + m_lower - i;
+        const auto * column = vector.data() + begin;
+        T value = 0;
+        for (unsigned j = 0; j < count; ++j)
+          value += row[j] * column[j];
+        output[i] = value;
+      }
+
+      return output;
+    }
+
+    /**
+     * \brief Factorizes the matrix by Gaussian elimination with partial pivoting restricted to the band
+     * \return Factorization reusable for several right-hand sides
+     */
+    BandFactorization<T> Factorize() const
+    {
+      static_assert(std::is_floating_point<T>::value, "Systems can only be solved for floating point values.");
+
+      BandFactorization<T> factorization(m_size, m_lower, m_lower + m_upper);
+      for (unsigned i = 0; i < m_size; ++i)
+        std::copy(m_values.begin() + i * GetWidth(), m_values.begin() + (i + 1) * GetWidth(), factorization.m_values.begin() + i * factorization.GetWidth());
+
+      for (unsigned k = 0; k < m_size; ++k)
+      {
+        const auto last = std::min(k + m_lower, m_size - 1);
+        const auto end = static_cast<unsigned>(std::min<std::size_t>(std::size_t(k) + m_lower + m_upper + 1, m_size));
+
+        auto pivot = k;
+        for (auto i = k + 1; i <= last; ++i)
+          if (std::abs(factorization.At(i, k)) > std::abs(factorization.At(pivot, k)))
+            pivot = i;
+        if (factorization.At(pivot, k) == 0)
+          throw InvertableMatrixOperationException("System cannot be solved for a singular matrix.");
+
+        factorization.m_pivots[k] = pivot;
+        if (pivot != k)
+        {
+          std::swap_ranges(&factorization.At(k, k), &factorization.At(k, k) + (end - k), &factorization.At(pivot, k));
+          factorization.m_negated = !factorization.m_negated;
+        }
+
+        const auto * pivotRow = &factorization.At(k, k);
+        for (auto i = k + 1; i <= last; ++i)
+        {
+          auto * row = &factorization.At(i, k);
+          const auto multiplier = row[0] / pivotRow[0];
+          row[0] = multiplier;
+          for (unsigned j = 1; j < end - k; ++j)
+            row[j] -= multiplier * pivotRow[j];
+        }
+      }
+
+      return factorization;
+    }
+
+    /**
+     * \brief Solves the system A * x = b by band LU factorization in O(n * kl * (kl + ku))
+     * \param vector Right-hand side b
+     * \return Solution x
+     */
+    std::vector<T> Solve(const std::vector<T> & vector) const
+    {
+      if (vector.size() != m_size)
+        throw MatrixDimensionException("Number of rows of the matrix must match size of the right-hand side.");
+
+      return Factorize().Solve(vector);
+    }
+
+    /**
+     * \brief Calculates the determinant from the band LU factorization
+     * \return Determinant of the matrix
+     */
+    double GetDeterminant() const
+    {
+      try
+      {
+        return Factorize().GetDeterminant();
+      }
+      catch (const InvertableMatrixOperationException &)
+      {
+        return 0;
+      }
+    }
+  };
+}
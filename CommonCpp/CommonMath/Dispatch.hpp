@@ -0,0 +1,205 @@
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define COMMON_MATH_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
+#define COMMON_MATH_PRAGMA(x) _Pragma(#x)
+
+/**
+ * \brief Opens a region of code compiled for given instruction set regardless of the global compiler flags.
+ * Code inside the region may only run after the dispatcher confirmed the instruction set is available
+ */
+#if defined(__clang__)
+#define COMMON_MATH_TARGET_BEGIN(isa) COMMON_MATH_PRAGMA(clang attribute push (__attribute__((target(isa))), apply_to = function))
+#define COMMON_MATH_TARGET_END COMMON_MATH_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+#define COMMON_MATH_TARGET_BEGIN(isa) COMMON_MATH_PRAGMA(GCC push_options) COMMON_MATH_PRAGMA(GCC target(isa))
+#define COMMON_MATH_TARGET_END COMMON_MATH_PRAGMA(GCC pop_options)
+#else
+#define COMMON_MATH_TARGET_BEGIN(isa)
+#define COMMON_MATH_TARGET_END
+#endif
+
+namespace Common::Math
+{
+  /**
+   * \brief Instruction set variants of the kernels, ordered from the least to the most capable
+   */
+  enum class InstructionSet : unsigned
+  {
+    /**
+     * \brief Portable code without explicit vectorization
+     */
+    Scalar = 0,
+    /**
+     * \brief 128-bit vectors, SSE up to version 4.2
+     */
+    Sse42 = 1,
+    /**
+     * \brief 256-bit vectors with fused multiply-add
+     */
+    Avx2 = 2,
+    /**
+     * \brief 512-bit vectors, AVX-512 foundation
+     */
+    Avx512 = 3
+  };
+
+  /**
+   * \brief Instruction set extensions reported by the processor and enabled by the operating system
+   */
+  struct CpuFeatures
+  {
+    bool sse42 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+  };
+
+  /**
+   * \brief Runtime selection of kernel variants based on the features of the executing processor.
+   * The selection is made once and can be lowered with the COMMON_MATH_ISA environment variable
+   * (scalar, sse42, avx2 or avx512) for testing
+   */
+  class Dispatch
+  {
+#ifdef COMMON_MATH_X86
+    static void CpuId(const unsigned leaf, const unsigned subleaf, unsigned (&registers)[4]) noexcept
+    {
+#if defined(_MSC_VER)
+      int values[4];
+      __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+      for (auto i = 0; i < 4; ++i)
+        registers[i] = static_cast<unsigned>(values[i]);
+#else
+      __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    }
+
+    static std::uint64_t ReadExtendedControlRegister() noexcept
+    {
+#if defined(_MSC_VER)
+      return _xgetbv(0);
+#else
+      unsigned low, high;
+      __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+      return static_cast<std::uint64_t>(high) << 32 | low;
+#endif
+    }
+#endif
+
+    static CpuFeatures DetectFeatures() noexcept
+    {
+      CpuFeatures features;
+#ifdef COMMON_MATH_X86
+      unsigned registers[4];
+      CpuId(0, 0, registers);
+      const auto maxLeaf = registers[0];
+      if (maxLeaf < 1)
+        return features;
+
+      CpuId(1, 0, registers);
+      const auto ecx = registers[2];
+      features.sse42 = (ecx >> 20 & 1) != 0;
+      const auto osSavesState = (ecx >> 27 & 1) != 0;
+      // The operating system has to preserve the vector registers across context switches
+      const auto xcr0 = osSavesState ? ReadExtendedControlRegister() : 0;
+      const auto ymmState = (xcr0 & 0x6) == 0x6;
+      const auto zmmState = (xcr0 & 0xE6) == 0xE6;
+
+      features.avx = ymmState && (ecx >> 28 & 1) != 0;
+      features.fma = features.avx && (ecx >> 12 & 1) != 0;
+      features.f16c = features.avx && (ecx >> 29 & 1) != 0;
+
+      if (maxLeaf >= 7)
+      {
+        CpuId(7, 0, registers);
+        const auto ebx = registers[1];
+        features.avx2 = features.avx && (ebx >> 5 & 1) != 0;
+        features.avx512f = zmmState && (ebx >> 16 & 1) != 0;
+        features.avx512bw = features.avx512f && (ebx >> 30 & 1) != 0;
+      }
+#endif
+      return features;
+    }
+
+    static InstructionSet SelectInstructionSet() noexcept
+    {
+      const auto & features = GetCpuFeatures();
+      auto supported = InstructionSet::Scalar;
+      if (features.sse42) supported = InstructionSet::Sse42;
+      if (features.avx2 && features.fma) supported = InstructionSet::Avx2;
+      if (features.avx512f && supported == InstructionSet::Avx2) supported = InstructionSet::Avx512;
+
+      const auto requested = ParseInstructionSet(std::getenv("COMMON_MATH_ISA"));
+      return requested < supported ? requested : supported;
+    }
+
+  public:
+    /**
+     * \brief Parses the name of an instruction set
+     * \param name Name of the instruction set, may be null
+     * \return Parsed instruction set, the most capable one for unknown names
+     */
+    static InstructionSet ParseInstructionSet(const char * name) noexcept
+    {
+      if (name == nullptr) return InstructionSet::Avx512;
+
+      const std::string value(name);
+      if (value == "scalar") return InstructionSet::Scalar;
+      if (value == "sse42") return InstructionSet::Sse42;
+      if (value == "avx2") return InstructionSet::Avx2;
+
+      return InstructionSet::Avx512;
+    }
+
+    /**
+     * \brief Retrieves the name of an instruction set
+     * \param instructionSet Instruction set
+     * \return Name accepted by the COMMON_MATH_ISA environment variable
+     */
+    static const char * GetInstructionSetName(const InstructionSet instructionSet) noexcept
+    {
+      switch (instructionSet)
+      {
+      case InstructionSet::Sse42: return "sse42";
+      case InstructionSet::Avx2: return "avx2";
+      case InstructionSet::Avx512: return "avx512";
+      default: return "scalar";
+      }
+    }
+
+    /**
+     * \brief Getter method for the CpuFeatures property
+     * \return Features of the executing processor
+     */
+    static const CpuFeatures & GetCpuFeatures() noexcept
+    {
+      static const auto features = DetectFeatures();
+      return features;
+    }
+
+    /**
+     * \brief Getter method for the InstructionSet property
+     * \return Instruction set of the selected kernels
+     */
+    static InstructionSet GetInstructionSet() noexcept
+    {
+      static const auto instructionSet = SelectInstructionSet();
+      return instructionSet;
+    }
+  };
+}
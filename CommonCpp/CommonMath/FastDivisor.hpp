@@ -0,0 +1,151 @@
+#pragma once
+#include <climits>
+#include <cstdint>
+#include <type_traits>
+#include "WideArithmetic.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Unsigned divisor fixed at run time. Quotients are calculated by a multiplication with a precomputed
+   * reciprocal and a shift as described by Granlund and Montgomery, in the form used by libdivide
+   * \tparam T Type of dividends and of the divisor. Anything but unsigned integer types are prohibited.
+   */
+  template <typename T, typename = std::enable_if_t<std::is_unsigned<T>::value && !std::is_same<T, bool>::value>>
+  class FastDivisor
+  {
+    /**
+     * \brief Type of the reciprocal, narrower types are divided as 32-bit values
+     */
+    using Word = std::conditional_t<(sizeof(T) <= sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+
+    static constexpr unsigned Bits = sizeof(Word) * CHAR_BIT;
+
+    /**
+     * \brief Divisor
+     */
+    Word m_divisor;
+    /**
+     * \brief Reciprocal of the divisor scaled by 2^(Bits + shift), zero if the divisor is a power of two
+     */
+    Word m_multiplier;
+    /**
+     * \brief Right shift applied to the high half of the product
+     */
+    unsigned char m_shift;
+    /**
+     * \brief True if the reciprocal needs Bits + 1 bits, its top bit is then added back to the quotient
+     */
+    bool m_add;
+
+    static unsigned FloorLog2(Word value) noexcept
+    {
+      unsigned result = 0;
+      while (value >>= 1)
+        ++result;
+      return result;
+    }
+
+  public:
+    /**
+     * \brief Precomputes the reciprocal of a divisor
+     * \param divisor Divisor, must not be zero
+     */
+    explicit FastDivisor(const T divisor) noexcept
+      : m_divisor(divisor), m_multiplier(0), m_shift(static_cast<unsigned char>(FloorLog2(divisor))), m_add(false)
+    {
+      // Powers of two are divided by the shift alone
+      if ((m_divisor & (m_divisor - 1)) == 0)
+        return;
+
+      // The smallest reciprocal 2^(Bits + shift) / d rounded up is exact for all dividends if its error is below 2^shift
+      Word remainder;
+      auto multiplier = WideArithmetic::DivideWide<Word>(Word(1) << m_shift, 0, m_divisor, remainder);
+      if (m_divisor - remainder >= Word(1) << m_shift)
+      {
+        // Otherwise one more bit of precision is needed, the reciprocal is doubled and its top bit is added separately
+        multiplier += multiplier;
+        const auto twiceRemainder = static_cast<Word>(remainder + remainder);
+        if (twiceRemainder >= m_divisor || twiceRemainder < remainder)
+          ++multiplier;
+        m_add = true;
+      }
+      m_multiplier = multiplier + 1;
+    }
+
+    /**
+     * \brief Getter for the Divisor property
+     * \return Divisor
+     */
+    T GetDivisor() const noexcept { return static_cast<T>(m_divisor); }
+    /**
+     * \brief Getter for the Multiplier property, vectorized divisions repeat the steps of Divide
+     * \return Reciprocal of the divisor, zero if the divisor is a power of two
+     */
+    auto GetMultiplier() const noexcept { return m_multiplier; }
+    /**
+     * \brief Getter for the Shift property
+     * \return Right shift of the high half of the product
+     */
+    unsigned GetShift() const noexcept { return m_shift; }
+    /**
+     * \brief Getter for the Add property
+     * \return True if the dividend is added back to the high half of the product
+     */
+    bool IsAdding() const noexcept { return m_add; }
+
+    /**
+     * \brief Divides a value by the divisor
+     * \param value Dividend
+     * \return Quotient rounded down
+     */
+    T Divide(const T value) const noexcept { return static_cast<T>(DivideWord(value)); }
+
+    /**
+     * \brief Calculates the remainder of a division by the divisor
+     * \param value Dividend
+     * \return Value modulo the divisor
+     */
+    T Remainder(const T value) const noexcept { return static_cast<T>(RemainderWord(value)); }
+
+    /**
+     * \brief Multiplies values modulo the divisor without overflowing. Products fitting into a single word
+     * are reduced by the reciprocal, wider products by a double width division
+     * \param left Value less than the divisor
+     * \param right Value less than the divisor
+     * \return Product modulo the divisor
+     */
+    T MultiplyModulo(const T left, const T right) const noexcept
+    {
+      const auto high = WideArithmetic::MultiplyHigh<Word>(left, right);
+      const auto low = static_cast<Word>(static_cast<Word>(left) * right);
+      if (high == 0)
+        return static_cast<T>(RemainderWord(low));
+
+      Word remainder;
+      WideArithmetic::DivideWide(high, low, m_divisor, remainder);
+      return static_cast<T>(remainder);
+    }
+
+  private:
+    /**
+     * \brief Divides a value by the divisor, the reciprocal is exact for dividends of the whole word
+     */
+    Word DivideWord(const Word value) const noexcept
+    {
+      if (m_multiplier == 0)
+        return value >> m_shift;
+
+      const auto high = WideArithmetic::MultiplyHigh(m_multiplier, value);
+      if (m_add)
+        return (((value - high) >> 1) + high) >> m_shift;
+
+      return high >> m_shift;
+    }
+
+    Word RemainderWord(const Word value) const noexcept
+    {
+      return value - DivideWord(value) * m_divisor;
+    }
+  };
+}
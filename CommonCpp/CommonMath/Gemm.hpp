@@ -0,0 +1,468 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Accumulation.hpp"
+#include "HalfPrecision.hpp"
+#include "MatrixKernels.hpp"
+#define NAMEOF(x) std::string(#x)
+
+namespace Common::Math
+{
+  /**
+   * \brief Blocking of the matrix multiplication
+   */
+  struct GemmParameters
+  {
+    /**
+     * \brief Rows of the left operand processed per block
+     */
+    unsigned rowBlock;
+    /**
+     * \brief Shared dimension processed per block
+     */
+    unsigned depthBlock;
+    /**
+     * \brief Columns of the right operand processed per block
+     */
+    unsigned columnBlock;
+    /**
+     * \brief Output rows accumulated together in registers by the tile kernel
+     */
+    unsigned microRows;
+
+    bool operator ==(const GemmParameters & other) const noexcept
+    {
+      return rowBlock == other.rowBlock && depthBlock == other.depthBlock && columnBlock == other.columnBlock && microRows == other.microRows;
+    }
+    bool operator !=(const GemmParameters & other) const noexcept { return !(*this == other); }
+  };
+
+  /**
+   * \brief Blocked multiplication kernels
+   */
+  namespace Gemm
+  {
+    /**
+     * \brief Parameters used when no profile is available
+     */
+    constexpr GemmParameters DefaultParameters { 64, 256, 1024, 4 };
+    /**
+     * \brief Largest supported count of micro rows
+     */
+    constexpr unsigned MaxMicroRows = static_cast<unsigned>(Kernels::MaxTileRows);
+
+    /**
+     * \brief Validates blocking parameters
+     * \param parameters Parameters to validate
+     * \return Bypassed parameters
+     */
+    inline const GemmParameters & Validate(const GemmParameters & parameters)
+    {
+      if (parameters.rowBlock == 0 || parameters.depthBlock == 0 || parameters.columnBlock == 0)
+        throw std::invalid_argument("Argument " + NAMEOF(parameters) + " cannot have a block of size 0.");
+      if (parameters.microRows == 0 || parameters.microRows > MaxMicroRows)
+        throw std::invalid_argument("Argument " + NAMEOF(parameters) + " must have between 1 and " + std::to_string(MaxMicroRows) + " micro rows.");
+
+      return parameters;
+    }
+
+    /**
+     * \brief Multiplication of values stored in a narrower type than their accumulator. Blocks of both operands
+     * are converted on the fly and every output element is accumulated in a tile of the wider type,
+     * hence it is rounded to the storage type only once
+     */
+    template <typename T, typename TLeft, typename TRight, typename TOutput>
+    void MultiplyConverted(const TLeft & a, const TRight & b, const TOutput & output, const std::size_t rows, const std::size_t depth, const std::size_t columns, const GemmParameters & parameters)
+    {
+      using TAccumulator = typename NumericTraits<T>::Accumulator;
+      const auto & kernels = GetMatrixKernels<TAccumulator>();
+      const auto rowBlock = std::min<std::size_t>(parameters.rowBlock, rows);
+      const auto depthBlock = std::min<std::size_t>(parameters.depthBlock, depth);
+      const auto columnBlock = std::min<std::size_t>(parameters.columnBlock, columns);
+
+      std::vector<TAccumulator> left(rowBlock * depthBlock), right(depthBlock * columnBlock), tile(rowBlock * columnBlock);
+      std::vector<const TAccumulator *> rightRows(depthBlock);
+      const TAccumulator * leftRows[Kernels::MaxTileRows];
+      TAccumulator * tileRows[Kernels::MaxTileRows];
+      for (std::size_t jj = 0; jj < columns; jj += columnBlock)
+      {
+        const auto count = std::min<std::size_t>(columnBlock, columns - jj);
+        for (std::size_t ii = 0; ii < rows; ii += rowBlock)
+        {
+          const auto iEnd = std::min<std::size_t>(ii + rowBlock, rows);
+          for (auto i = ii; i < iEnd; ++i)
+            ConvertValues(output(i) + jj, tile.data() + (i - ii) * count, count);
+
+          for (std::size_t kk = 0; kk < depth; kk += depthBlock)
+          {
+            const auto kCount = std::min<std::size_t>(depthBlock, depth - kk);
+            for (auto i = ii; i < iEnd; ++i)
+              ConvertValues(a(i) + kk, left.data() + (i - ii) * kCount, kCount);
+            for (std::size_t k = 0; k < kCount; ++k)
+              ConvertValues(b(kk + k) + jj, right.data() + k * count, count);
+
+            for (std::size_t k = 0; k < kCount; ++k)
+              rightRows[k] = right.data() + k * count;
+            for (auto i = ii; i < iEnd; i += parameters.microRows)
+            {
+              const auto microCount = std::min<std::size_t>(parameters.microRows, iEnd - i);
+              for (std::size_t r = 0; r < microCount; ++r)
+              {
+                leftRows[r] = left.data() + (i - ii + r) * kCount;
+                tileRows[r] = tile.data() + (i - ii + r) * count;
+              }
+              kernels.multiplyAddTile(leftRows, rightRows.data(), tileRows, microCount, kCount, count);
+            }
+          }
+
+          for (auto i = ii; i < iEnd; ++i)
+            ConvertValues(tile.data() + (i - ii) * count, output(i) + jj, count);
+        }
+      }
+    }
+
+    /**
+     * \brief Blocked multiplication of operands given by functions returning pointers to their rows
+     */
+    template <typename T, typename TLeft, typename TRight, typename TOutput>
+    void MultiplyRows(const TLeft & a, const TRight & b, const TOutput & output, const std::size_t rows, const std::size_t depth, const std::size_t columns, const GemmParameters & parameters)
+    {
+      if constexpr (IsStorageOnly<T>)
+        return MultiplyConverted<T>(a, b, output, rows, depth, columns, parameters);
+
+      const auto & kernels = GetMatrixKernels<T>();
+      std::vector<const T *> rightRows(std::min<std::size_t>(parameters.depthBlock, depth));
+      const T * leftRows[Kernels::MaxTileRows];
+      T * outputRows[Kernels::MaxTileRows];
+      for (std::size_t jj = 0; jj < columns; jj += parameters.columnBlock)
+      {
+        const auto count = std::min<std::size_t>(parameters.columnBlock, columns - jj);
+        for (std::size_t kk = 0; kk < depth; kk += parameters.depthBlock)
+        {
+          const auto kCount = std::min<std::size_t>(parameters.depthBlock, depth - kk);
+          for (std::size_t k = 0; k < kCount; ++k)
+            rightRows[k] = b(kk + k) + jj;
+
+          for (std::size_t ii = 0; ii < rows; ii += parameters.rowBlock)
+          {
+            const auto iEnd = std::min<std::size_t>(ii + parameters.rowBlock, rows);
+            // The block of the right operand stays in cache while tiles of the output are accumulated in registers
+            for (auto i = ii; i < iEnd; i += parameters.microRows)
+            {
+              const auto microCount = std::min<std::size_t>(parameters.microRows, iEnd - i);
+              for (std::size_t r = 0; r < microCount; ++r)
+              {
+                leftRows[r] = a(i + r) + kk;
+                outputRows[r] = output(i + r) + jj;
+              }
+              kernels.multiplyAddTile(leftRows, rightRows.data(), outputRows, microCount, kCount, count);
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * \brief Accumulates the product of two matrices into the output. The shared dimension is traversed in order
+     * for every output element, hence the result equals the unblocked multiplication exactly. Values of storage-only
+     * types are accumulated in their wider type
+     * \param a Left operand
+     * \param b Right operand
+     * \param output Output of matching dimensions, usually zero initialized
+     * \param parameters Blocking to use
+     */
+    template <typename T>
+    void Multiply(const std::vector<std::vector<T>> & a, const std::vector<std::vector<T>> & b, std::vector<std::vector<T>> & output, const GemmParameters & parameters)
+    {
+      MultiplyRows<T>([&a](const std::size_t i) { return a[i].data(); }, [&b](const std::size_t i) { return b[i].data(); },
+        [&output](const std::size_t i) { return output[i].data(); }, a.size(), b.size(), b[0].size(), parameters);
+    }
+
+    /**
+     * \brief Accumulates the product of two densely packed row-major matrices into the output, as the overload above
+     * \param a Left operand of rows x depth values
+     * \param b Right operand of depth x columns values
+     * \param output Output of rows x columns values, usually zero initialized
+     * \param rows Number of rows of the left operand and of the output
+     * \param depth Number of columns of the left operand and rows of the right operand
+     * \param columns Number of columns of the right operand and of the output
+     * \param parameters Blocking to use
+     */
+    template <typename T>
+    void Multiply(const T * a, const T * b, T * output, const std::size_t rows, const std::size_t depth, const std::size_t columns, const GemmParameters & parameters)
+    {
+      MultiplyRows<T>([a, depth](const std::size_t i) { return a + i * depth; }, [b, columns](const std::size_t i) { return b + i * columns; },
+        [output, columns](const std::size_t i) { return output + i * columns; }, rows, depth, columns, parameters);
+    }
+
+    /**
+     * \brief Multiplies a matrix by a vector, each output value is a dot product accumulated in the accumulator type
+     * \param a Matrix operand
+     * \param vector Values of the vector, one per column of the matrix
+     * \param output Values of the product, one per row of the matrix
+     */
+    template <typename T>
+    void MultiplyVector(const std::vector<std::vector<T>> & a, const T * vector, T * output)
+    {
+      const std::size_t columns = a[0].size();
+      if constexpr (IsStorageOnly<T>)
+      {
+        using TAccumulator = typename NumericTraits<T>::Accumulator;
+        std::vector<TAccumulator> right(columns), row(columns);
+        ConvertValues(vector, right.data(), columns);
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+          ConvertValues(a[i].data(), row.data(), columns);
+          output[i] = Reduction::Dot(row.data(), right.data(), columns);
+        }
+      }
+      else
+        for (std::size_t i = 0; i < a.size(); ++i)
+          output[i] = Reduction::Dot(a[i].data(), vector, columns);
+    }
+  }
+
+  /**
+   * \brief Blocking parameters per value type, persisted as a text file of key=value lines
+   */
+  class GemmProfile
+  {
+    std::map<std::string, GemmParameters> m_parameters;
+
+    static unsigned ParseValue(const std::string & key, const std::string & value)
+    {
+      unsigned long result;
+      std::size_t length;
+      try
+      {
+        result = std::stoul(value, &length);
+      }
+      catch (const std::logic_error &)
+      {
+        throw std::invalid_argument("Profile value of " + key + " is not a number.");
+      }
+      if (length != value.size())
+        throw std::invalid_argument("Profile value of " + key + " is not a number.");
+
+      return static_cast<unsigned>(result);
+    }
+
+    static GemmProfile LoadActive()
+    {
+      // A damaged profile must not break multiplication, the defaults are used instead
+      try
+      {
+        return Load(GetDefaultPath());
+      }
+      catch (const std::exception &)
+      {
+        return GemmProfile();
+      }
+    }
+
+  public:
+    /**
+     * \brief Retrieves the profile key of a value type
+     * \tparam T Type of matrix values
+     * \return Key such as float64, int32 or bfloat16
+     */
+    template <typename T>
+    static std::string GetKey()
+    {
+      if constexpr (std::is_same<T, BFloat16>::value)
+        return "bfloat16";
+      else
+        return (NumericTraits<T>::IsFloatingPoint ? "float" : std::is_signed<T>::value ? "int" : "uint") + std::to_string(sizeof(T) * 8);
+    }
+
+    /**
+     * \brief Retrieves the path of the profile loaded at startup, given by the COMMON_MATH_GEMM_PROFILE
+     * environment variable or .commonmath-gemm.profile in the home directory
+     * \return Path of the profile, empty if it cannot be determined
+     */
+    static std::string GetDefaultPath()
+    {
+      if (const auto path = std::getenv("COMMON_MATH_GEMM_PROFILE"))
+        return path;
+
+      auto home = std::getenv("HOME");
+      if (home == nullptr)
+        home = std::getenv("USERPROFILE");
+
+      return home != nullptr ? std::string(home) + "/.commonmath-gemm.profile" : std::string();
+    }
+
+    /**
+     * \brief Loads a profile
+     * \param path Path of the profile
+     * \return Loaded profile, empty if the file does not exist
+     */
+    static GemmProfile Load(const std::string & path)
+    {
+      GemmProfile profile;
+      std::ifstream file(path);
+      std::string line;
+      while (std::getline(file, line))
+      {
+        if (!line.empty() && line.back() == '\r')
+          line.pop_back();
+        if (line.empty() || line[0] == '#')
+          continue;
+
+        const auto separator = line.find('=');
+        const auto dot = line.rfind('.', separator);
+        if (separator == std::string::npos || dot == std::string::npos)
+          throw std::invalid_argument("Profile line " + line + " is not a key=value pair.");
+
+        const auto type = line.substr(0, dot);
+        const auto name = line.substr(dot + 1, separator - dot - 1);
+        const auto value = ParseValue(line.substr(0, separator), line.substr(separator + 1));
+
+        auto & parameters = profile.m_parameters.emplace(type, Gemm::DefaultParameters).first->second;
+        if (name == "rowBlock") parameters.rowBlock = value;
+        else if (name == "depthBlock") parameters.depthBlock = value;
+        else if (name == "columnBlock") parameters.columnBlock = value;
+        else if (name == "microRows") parameters.microRows = value;
+      }
+
+      for (const auto & entry : profile.m_parameters)
+        Gemm::Validate(entry.second);
+
+      return profile;
+    }
+
+    /**
+     * \brief Saves the profile
+     * \param path Path of the profile
+     */
+    void Save(const std::string & path) const
+    {
+      std::ofstream file(path);
+      if (!file)
+        throw std::runtime_error("Profile " + path + " cannot be opened.");
+
+      file << "# Matrix multiplication blocking tuned by BenchCommonMath --tune\n";
+      for (const auto &[type, parameters] : m_parameters)
+        file << type << ".rowBlock=" << parameters.rowBlock << '\n'
+          << type << ".depthBlock=" << parameters.depthBlock << '\n'
+          << type << ".columnBlock=" << parameters.columnBlock << '\n'
+          << type << ".microRows=" << parameters.microRows << '\n';
+    }
+
+    /**
+     * \brief Retrieves the parameters of a value type
+     * \tparam T Type of matrix values
+     * \return Stored parameters, the defaults if none are stored
+     */
+    template <typename T>
+    GemmParameters Get() const
+    {
+      const auto found = m_parameters.find(GetKey<T>());
+      return found != m_parameters.end() ? found->second : Gemm::DefaultParameters;
+    }
+
+    /**
+     * \brief Stores the parameters of a value type
+     * \tparam T Type of matrix values
+     * \param parameters Parameters to store
+     */
+    template <typename T>
+    void Set(const GemmParameters & parameters)
+    {
+      m_parameters[GetKey<T>()] = Gemm::Validate(parameters);
+    }
+
+    /**
+     * \brief Retrieves the parameters used by Matrix multiplication, loaded once from the default profile path
+     * \tparam T Type of matrix values
+     * \return Active parameters
+     */
+    template <typename T>
+    static const GemmParameters & GetActive()
+    {
+      static const auto parameters = LoadActive().Get<T>();
+      return parameters;
+    }
+  };
+
+  /**
+   * \brief Searches for the fastest blocking on the executing machine
+   */
+  class GemmTuner
+  {
+    template <typename T>
+    static double Measure(const std::vector<std::vector<T>> & a, const std::vector<std::vector<T>> & b, const GemmParameters & parameters, const unsigned repetitions)
+    {
+      auto best = 0.0;
+      for (unsigned repetition = 0; repetition < repetitions; ++repetition)
+      {
+        std::vector<std::vector<T>> output(a.size(), std::vector<T>(b[0].size()));
+        const auto start = std::chrono::steady_clock::now();
+        Gemm::Multiply(a, b, output, parameters);
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (repetition == 0 || elapsed < best)
+          best = elapsed;
+      }
+
+      return best;
+    }
+
+  public:
+    /**
+     * \brief Tunes the parameters one at a time, keeping the fastest candidate of each before moving to the next
+     * \tparam T Type of matrix values
+     * \param size Size of the square matrices multiplied during the search
+     * \param repetitions Number of measurements per candidate, the fastest one counts
+     * \return Fastest parameters found
+     */
+    template <typename T>
+    static GemmParameters Tune(const unsigned size, const unsigned repetitions = 3)
+    {
+      if (size == 0)
+        throw std::invalid_argument("Argument " + NAMEOF(size) + " cannot be 0.");
+
+      std::vector<std::vector<T>> a(size, std::vector<T>(size)), b(size, std::vector<T>(size));
+      for (unsigned i = 0; i < size; ++i)
+        for (unsigned j = 0; j < size; ++j)
+        {
+          a[i][j] = static_cast<T>((i * 7 + j * 3) % 11);
+          b[i][j] = static_cast<T>((i * 5 + j) % 13);
+        }
+
+      auto best = Gemm::DefaultParameters;
+      auto bestTime = Measure(a, b, best, repetitions);
+      const auto search = [&](unsigned GemmParameters::* field, const std::vector<unsigned> & candidates)
+      {
+        for (const auto candidate : candidates)
+        {
+          auto parameters = best;
+          parameters.*field = candidate;
+          if (parameters == best)
+            continue;
+
+          const auto time = Measure(a, b, parameters, repetitions);
+          if (time < bestTime)
+          {
+            best = parameters;
+            bestTime = time;
+          }
+        }
+      };
+
+      search(&GemmParameters::columnBlock, { 128, 256, 512, 1024, 2048, 4096 });
+      search(&GemmParameters::depthBlock, { 32, 64, 128, 256, 512 });
+      search(&GemmParameters::rowBlock, { 16, 32, 64, 128, 256 });
+      search(&GemmParameters::microRows, { 1, 2, 4, 8 });
+
+      return best;
+    }
+  };
+}
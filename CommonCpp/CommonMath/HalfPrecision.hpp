@@ -0,0 +1,335 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include "Dispatch.hpp"
+#include "NumericTraits.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief IEEE 754 half precision value. The value only stores numbers, arithmetic converts it to float
+   * and the result is rounded back to nearest even when assigned
+   */
+  class Float16
+  {
+    struct BitsTag { };
+    std::uint16_t m_bits;
+
+    constexpr Float16(BitsTag, const std::uint16_t bits) noexcept : m_bits(bits) { }
+
+  public:
+    Float16() = default;
+    Float16(const float value) noexcept : m_bits(Encode(value)) { }
+
+    /**
+     * \brief Constructs a value from its binary representation
+     * \param bits Sign, 5 exponent and 10 mantissa bits
+     * \return Constructed value
+     */
+    static constexpr Float16 FromBits(const std::uint16_t bits) noexcept { return Float16(BitsTag(), bits); }
+
+    /**
+     * \brief Rounds a float to the nearest half precision value, ties to even
+     * \param value Value to round
+     * \return Binary representation of the rounded value
+     */
+    static std::uint16_t Encode(const float value) noexcept
+    {
+      std::uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      const auto sign = static_cast<std::uint16_t>(bits >> 16 & 0x8000);
+      bits &= 0x7FFFFFFF;
+
+      // Infinity and NaN, the NaN stays quiet and keeps the upper bits of its payload
+      if (bits >= 0x7F800000)
+        return static_cast<std::uint16_t>(sign | (bits > 0x7F800000 ? 0x7E00 | (bits >> 13 & 0x3FF) : 0x7C00));
+      if (bits >= 0x47800000)
+        return static_cast<std::uint16_t>(sign | 0x7C00);
+      // Values below half of the smallest subnormal round to zero
+      if (bits <= 0x33000000)
+        return sign;
+
+      std::uint32_t result, remainder, halfway;
+      if (bits < 0x38800000)
+      {
+        // Subnormal result, the implicit bit becomes part of the shifted mantissa
+        const auto shift = 126 - (bits >> 23);
+        const auto mantissa = (bits & 0x7FFFFF) | 0x800000;
+        result = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+      }
+      else
+      {
+        // Rebias the exponent from 127 to 15, a carry of the rounding propagates into the exponent
+        result = (bits - 0x38000000) >> 13;
+        remainder = bits & 0x1FFF;
+        halfway = 0x1000;
+      }
+      if (remainder > halfway || (remainder == halfway && (result & 1) != 0))
+        ++result;
+
+      return static_cast<std::uint16_t>(sign | result);
+    }
+
+    /**
+     * \brief Converts a half precision value to float, the conversion is exact
+     * \param bits Binary representation of the value
+     * \return Converted value
+     */
+    static float Decode(const std::uint16_t bits) noexcept
+    {
+      const auto sign = static_cast<std::uint32_t>(bits & 0x8000) << 16;
+      const auto exponent = bits >> 10 & 0x1F;
+      const auto mantissa = static_cast<std::uint32_t>(bits & 0x3FF);
+
+      std::uint32_t result;
+      // Infinity and NaN, the NaN is quieted as by the hardware conversion
+      if (exponent == 0x1F)
+        result = sign | 0x7F800000 | (mantissa != 0 ? 0x400000 : 0) | mantissa << 13;
+      else if (exponent == 0)
+      {
+        // Zero or subnormal, mantissa * 2^-24 is exact in float
+        const auto magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+        std::memcpy(&result, &magnitude, sizeof(result));
+        result |= sign;
+      }
+      else
+        result = sign | (exponent + 112) << 23 | mantissa << 13;
+
+      float value;
+      std::memcpy(&value, &result, sizeof(value));
+      return value;
+    }
+
+    /**
+     * \brief Getter method for the Bits property
+     * \return Binary representation of the value
+     */
+    constexpr std::uint16_t GetBits() const noexcept { return m_bits; }
+
+    operator float() const noexcept { return Decode(m_bits); }
+
+    template <typename TOther>
+    Float16 & operator +=(const TOther & other) noexcept { return *this = Float16(static_cast<float>(*this + other)); }
+    template <typename TOther>
+    Float16 & operator -=(const TOther & other) noexcept { return *this = Float16(static_cast<float>(*this - other)); }
+    template <typename TOther>
+    Float16 & operator *=(const TOther & other) noexcept { return *this = Float16(static_cast<float>(*this * other)); }
+    template <typename TOther>
+    Float16 & operator /=(const TOther & other) noexcept { return *this = Float16(static_cast<float>(*this / other)); }
+
+    friend std::ostream & operator <<(std::ostream & output, const Float16 & value) { return output << static_cast<float>(value); }
+  };
+
+  /**
+   * \brief Brain floating point value, the upper half of a float. The value only stores numbers, arithmetic converts it
+   * to float and the result is rounded back to nearest even when assigned
+   */
+  class BFloat16
+  {
+    struct BitsTag { };
+    std::uint16_t m_bits;
+
+    constexpr BFloat16(BitsTag, const std::uint16_t bits) noexcept : m_bits(bits) { }
+
+  public:
+    BFloat16() = default;
+    BFloat16(const float value) noexcept : m_bits(Encode(value)) { }
+
+    /**
+     * \brief Constructs a value from its binary representation
+     * \param bits Sign, 8 exponent and 7 mantissa bits
+     * \return Constructed value
+     */
+    static constexpr BFloat16 FromBits(const std::uint16_t bits) noexcept { return BFloat16(BitsTag(), bits); }
+
+    /**
+     * \brief Rounds a float to the nearest brain floating point value, ties to even
+     * \param value Value to round
+     * \return Binary representation of the rounded value
+     */
+    static std::uint16_t Encode(const float value) noexcept
+    {
+      std::uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+
+      // Rounding could turn a NaN into infinity, it is quieted instead
+      if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        return static_cast<std::uint16_t>((bits | 0x400000) >> 16);
+
+      return static_cast<std::uint16_t>((bits + 0x7FFF + (bits >> 16 & 1)) >> 16);
+    }
+
+    /**
+     * \brief Converts a brain floating point value to float, the conversion is exact
+     * \param bits Binary representation of the value
+     * \return Converted value
+     */
+    static float Decode(const std::uint16_t bits) noexcept
+    {
+      const auto result = static_cast<std::uint32_t>(bits) << 16;
+      float value;
+      std::memcpy(&value, &result, sizeof(value));
+      return value;
+    }
+
+    /**
+     * \brief Getter method for the Bits property
+     * \return Binary representation of the value
+     */
+    constexpr std::uint16_t GetBits() const noexcept { return m_bits; }
+
+    operator float() const noexcept { return Decode(m_bits); }
+
+    template <typename TOther>
+    BFloat16 & operator +=(const TOther & other) noexcept { return *this = BFloat16(static_cast<float>(*this + other)); }
+    template <typename TOther>
+    BFloat16 & operator -=(const TOther & other) noexcept { return *this = BFloat16(static_cast<float>(*this - other)); }
+    template <typename TOther>
+    BFloat16 & operator *=(const TOther & other) noexcept { return *this = BFloat16(static_cast<float>(*this * other)); }
+    template <typename TOther>
+    BFloat16 & operator /=(const TOther & other) noexcept { return *this = BFloat16(static_cast<float>(*this / other)); }
+
+    friend std::ostream & operator <<(std::ostream & output, const BFloat16 & value) { return output << static_cast<float>(value); }
+  };
+
+  static_assert(sizeof(Float16) == 2 && sizeof(BFloat16) == 2, "Half precision values must be stored in 16 bits.");
+
+  template <>
+  struct NumericTraits<Float16>
+  {
+    static constexpr bool IsNumeric = true;
+    static constexpr bool IsFloatingPoint = true;
+    using Accumulator = float;
+  };
+
+  template <>
+  struct NumericTraits<BFloat16>
+  {
+    static constexpr bool IsNumeric = true;
+    static constexpr bool IsFloatingPoint = true;
+    using Accumulator = float;
+  };
+
+  /**
+   * \brief Batch conversions between half precision values and float
+   */
+  struct HalfKernels
+  {
+    void (*float16ToFloat)(const Float16 * input, float * output, std::size_t count) noexcept;
+    void (*floatToFloat16)(const float * input, Float16 * output, std::size_t count) noexcept;
+    void (*bfloat16ToFloat)(const BFloat16 * input, float * output, std::size_t count) noexcept;
+    void (*floatToBFloat16)(const float * input, BFloat16 * output, std::size_t count) noexcept;
+    /**
+     * \brief Instruction set the kernels were compiled for
+     */
+    InstructionSet instructionSet;
+  };
+
+  namespace Kernels::Scalar
+  {
+    template <typename TInput, typename TOutput>
+    void Convert(const TInput * input, TOutput * output, const std::size_t count) noexcept
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        output[i] = static_cast<TOutput>(input[i]);
+    }
+  }
+
+#ifdef COMMON_MATH_X86
+  COMMON_MATH_TARGET_BEGIN("avx2,fma,f16c")
+  namespace Kernels::Avx2
+  {
+    inline void ConvertFloat16ToFloat(const Float16 * input, float * output, const std::size_t count) noexcept
+    {
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(output + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i))));
+      for (; i < count; ++i) output[i] = input[i];
+    }
+
+    inline void ConvertFloatToFloat16(const float * input, Float16 * output, const std::size_t count) noexcept
+    {
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+      for (; i < count; ++i) output[i] = input[i];
+    }
+
+    inline void ConvertBFloat16ToFloat(const BFloat16 * input, float * output, const std::size_t count) noexcept
+    {
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+        const auto bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i)));
+        _mm256_storeu_ps(output + i, _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+      }
+      for (; i < count; ++i) output[i] = input[i];
+    }
+
+    inline void ConvertFloatToBFloat16(const float * input, BFloat16 * output, const std::size_t count) noexcept
+    {
+      const auto roundingBias = _mm256_set1_epi32(0x7FFF);
+      const auto one = _mm256_set1_epi32(1);
+      const auto quietBit = _mm256_set1_epi32(0x400000);
+      std::size_t i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+        const auto values = _mm256_loadu_ps(input + i);
+        const auto bits = _mm256_castps_si256(values);
+        const auto odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        const auto rounded = _mm256_add_epi32(bits, _mm256_add_epi32(roundingBias, odd));
+        const auto nan = _mm256_castps_si256(_mm256_cmp_ps(values, values, _CMP_UNORD_Q));
+        const auto result = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, _mm256_or_si256(bits, quietBit), nan), 16);
+        // Packing works within 128-bit lanes, the permutation gathers both lower halves
+        const auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm256_castsi256_si128(packed));
+      }
+      for (; i < count; ++i) output[i] = input[i];
+    }
+  }
+  COMMON_MATH_TARGET_END
+#endif
+
+  /**
+   * \brief Selects the conversions matching the instruction set chosen by the dispatcher. The vector variant
+   * requires AVX2 together with F16C
+   * \param instructionSet Instruction set to select the conversions for
+   * \return Conversions of the most capable variant not exceeding given instruction set
+   */
+  inline HalfKernels SelectHalfKernels(const InstructionSet instructionSet) noexcept
+  {
+#ifdef COMMON_MATH_X86
+    if (instructionSet >= InstructionSet::Avx2 && Dispatch::GetCpuFeatures().f16c)
+      return { Kernels::Avx2::ConvertFloat16ToFloat, Kernels::Avx2::ConvertFloatToFloat16,
+        Kernels::Avx2::ConvertBFloat16ToFloat, Kernels::Avx2::ConvertFloatToBFloat16, InstructionSet::Avx2 };
+#endif
+    (void)instructionSet;
+    return { Kernels::Scalar::Convert<Float16, float>, Kernels::Scalar::Convert<float, Float16>,
+      Kernels::Scalar::Convert<BFloat16, float>, Kernels::Scalar::Convert<float, BFloat16>, InstructionSet::Scalar };
+  }
+
+  /**
+   * \brief Retrieves the conversions selected for the executing processor
+   * \return Selected conversions
+   */
+  inline const HalfKernels & GetHalfKernels() noexcept
+  {
+    static const auto kernels = SelectHalfKernels(Dispatch::GetInstructionSet());
+    return kernels;
+  }
+
+  /**
+   * \brief Converts contiguous values between a storage type and its accumulator
+   * \param input Values to convert
+   * \param output Converted values
+   * \param count Number of values
+   */
+  inline void ConvertValues(const Float16 * input, float * output, const std::size_t count) noexcept { GetHalfKernels().float16ToFloat(input, output, count); }
+  inline void ConvertValues(const float * input, Float16 * output, const std::size_t count) noexcept { GetHalfKernels().floatToFloat16(input, output, count); }
+  inline void ConvertValues(const BFloat16 * input, float * output, const std::size_t count) noexcept { GetHalfKernels().bfloat16ToFloat(input, output, count); }
+  inline void ConvertValues(const float * input, BFloat16 * output, const std::size_t count) noexcept { GetHalfKernels().floatToBFloat16(input, output, count); }
+}
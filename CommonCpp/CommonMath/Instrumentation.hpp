@@ -0,0 +1,308 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Common::Math
+{
+  /**
+   * \brief Operations tracked by the instrumentation
+   */
+  enum class Operation : unsigned
+  {
+    Add = 0,
+    Subtract,
+    Multiply,
+    Scale,
+    Divide,
+    Transpose,
+    Determinant,
+    Inverse,
+    /**
+     * \brief Number of tracked operations
+     */
+    Count
+  };
+
+  /**
+   * \brief Statistics of a single operation
+   */
+  struct OperationStatistics
+  {
+    /**
+     * \brief Number of calls
+     */
+    std::uint64_t calls = 0;
+    /**
+     * \brief Number of matrix elements produced
+     */
+    std::uint64_t elements = 0;
+    /**
+     * \brief Number of arithmetic operations performed. Determinant and inverse count the operations of the algorithm
+     * taken, the inverse excludes the determinant it uses
+     */
+    std::uint64_t flops = 0;
+    /**
+     * \brief Cumulative wall time including nested operations
+     */
+    std::uint64_t nanoseconds = 0;
+  };
+
+  /**
+   * \brief Statistics accumulated over all threads since the last reset
+   */
+  struct InstrumentationSnapshot
+  {
+    std::array<OperationStatistics, static_cast<std::size_t>(Operation::Count)> operations {};
+    /**
+     * \brief Number of matrix storage allocations
+     */
+    std::uint64_t allocations = 0;
+    /**
+     * \brief Bytes of matrix storage allocated
+     */
+    std::uint64_t bytesAllocated = 0;
+
+    const OperationStatistics & operator [](const Operation operation) const noexcept { return operations[static_cast<std::size_t>(operation)]; }
+  };
+
+  /**
+   * \brief Opt-in counters of the Matrix hot paths. The hooks are compiled only when COMMON_MATH_INSTRUMENTATION
+   * is defined, otherwise snapshots stay empty. Each thread is the only writer of its own counters and updates them
+   * without locking or atomic read-modify-write, the registry mutex is taken only when a thread starts or stops
+   * counting and when taking a snapshot. A reset never writes the counters of a thread, it moves its baseline
+   */
+  class Instrumentation
+  {
+    struct Counters
+    {
+      std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Operation::Count) * 4> operations {};
+      std::atomic<std::uint64_t> allocations { 0 };
+      std::atomic<std::uint64_t> bytesAllocated { 0 };
+
+      /**
+       * \brief Adds the counts since given baseline to a snapshot
+       */
+      void AddTo(InstrumentationSnapshot & snapshot, const InstrumentationSnapshot & baseline) const noexcept
+      {
+        for (std::size_t i = 0; i < snapshot.operations.size(); ++i)
+        {
+          auto & statistics = snapshot.operations[i];
+          const auto & base = baseline.operations[i];
+          statistics.calls += operations[i * 4].load(std::memory_order_relaxed) - base.calls;
+          statistics.elements += operations[i * 4 + 1].load(std::memory_order_relaxed) - base.elements;
+          statistics.flops += operations[i * 4 + 2].load(std::memory_order_relaxed) - base.flops;
+          statistics.nanoseconds += operations[i * 4 + 3].load(std::memory_order_relaxed) - base.nanoseconds;
+        }
+        snapshot.allocations += allocations.load(std::memory_order_relaxed) - baseline.allocations;
+        snapshot.bytesAllocated += bytesAllocated.load(std::memory_order_relaxed) - baseline.bytesAllocated;
+      }
+    };
+
+    /**
+     * \brief Increments a counter of the calling thread, no other thread writes it
+     */
+    static void Increment(std::atomic<std::uint64_t> & counter, const std::uint64_t value) noexcept
+    {
+      counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct ThreadEntry
+    {
+      std::shared_ptr<Counters> counters;
+      /**
+       * \brief Counts at the last reset
+       */
+      InstrumentationSnapshot baseline;
+    };
+
+    struct Registry
+    {
+      std::mutex mutex;
+      std::vector<ThreadEntry> threads;
+      /**
+       * \brief Totals of threads which have already exited
+       */
+      InstrumentationSnapshot retired;
+    };
+
+    /**
+     * \brief Registers the counters of the calling thread and folds them into the retired totals when the thread exits
+     */
+    class ThreadCounters
+    {
+      std::shared_ptr<Counters> m_counters = std::make_shared<Counters>();
+
+    public:
+      ThreadCounters()
+      {
+        auto & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back({ m_counters, InstrumentationSnapshot() });
+      }
+      ~ThreadCounters()
+      {
+        auto & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto entry = std::find_if(registry.threads.begin(), registry.threads.end(), [this](const ThreadEntry & thread) { return thread.counters == m_counters; });
+        m_counters->AddTo(registry.retired, entry->baseline);
+        registry.threads.erase(entry);
+      }
+
+      Counters & Get() const noexcept { return *m_counters; }
+    };
+
+    static Registry & GetRegistry()
+    {
+      // Never destroyed, threads may exit after static destruction has started
+      static auto registry = new Registry();
+      return *registry;
+    }
+
+    static Counters * GetCounters() noexcept
+    {
+      try
+      {
+        // A failed registration is retried on the next call
+        thread_local ThreadCounters counters;
+        return &counters.Get();
+      }
+      catch (...)
+      {
+        return nullptr;
+      }
+    }
+
+  public:
+    /**
+     * \brief Records a completed operation of the calling thread, nothing is recorded if the thread cannot be registered
+     * \param operation Completed operation
+     * \param elements Number of matrix elements produced
+     * \param flops Number of arithmetic operations performed
+     * \param nanoseconds Duration of the operation
+     */
+    static void RecordOperation(const Operation operation, const std::uint64_t elements, const std::uint64_t flops, const std::uint64_t nanoseconds) noexcept
+    {
+      const auto thread = GetCounters();
+      if (thread == nullptr)
+        return;
+
+      auto * counters = &thread->operations[static_cast<std::size_t>(operation) * 4];
+      Increment(counters[0], 1);
+      Increment(counters[1], elements);
+      Increment(counters[2], flops);
+      Increment(counters[3], nanoseconds);
+    }
+
+    /**
+     * \brief Records allocations of matrix storage by the calling thread, nothing is recorded if the thread cannot be
+     * registered
+     * \param allocations Number of allocations
+     * \param bytes Number of allocated bytes
+     */
+    static void RecordAllocation(const std::uint64_t allocations, const std::uint64_t bytes) noexcept
+    {
+      const auto counters = GetCounters();
+      if (counters == nullptr)
+        return;
+
+      Increment(counters->allocations, allocations);
+      Increment(counters->bytesAllocated, bytes);
+    }
+
+    /**
+     * \brief Sums the counters of all threads
+     * \return Statistics since the last reset
+     */
+    static InstrumentationSnapshot Snapshot()
+    {
+      auto & registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+
+      auto snapshot = registry.retired;
+      for (const auto & thread : registry.threads)
+        thread.counters->AddTo(snapshot, thread.baseline);
+
+      return snapshot;
+    }
+
+    /**
+     * \brief Sets the counters of all threads to zero
+     */
+    static void Reset()
+    {
+      auto & registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+
+      registry.retired = InstrumentationSnapshot();
+      for (auto & thread : registry.threads)
+      {
+        thread.baseline = InstrumentationSnapshot();
+        thread.counters->AddTo(thread.baseline, InstrumentationSnapshot());
+      }
+    }
+
+    /**
+     * \brief Retrieves the name of an operation
+     * \param operation Operation
+     * \return Name suitable for metric labels
+     */
+    static const char * GetOperationName(const Operation operation) noexcept
+    {
+      switch (operation)
+      {
+      case Operation::Add: return "add";
+      case Operation::Subtract: return "subtract";
+      case Operation::Multiply: return "multiply";
+      case Operation::Scale: return "scale";
+      case Operation::Divide: return "divide";
+      case Operation::Transpose: return "transpose";
+      case Operation::Determinant: return "determinant";
+      case Operation::Inverse: return "inverse";
+      default: return "unknown";
+      }
+    }
+  };
+
+  /**
+   * \brief Measures the wall time of the enclosing scope and records it as an operation on destruction
+   */
+  class InstrumentationScope
+  {
+    Operation m_operation;
+    std::uint64_t m_elements;
+    std::uint64_t m_flops;
+    std::chrono::steady_clock::time_point m_start;
+
+  public:
+    InstrumentationScope(const Operation operation, const std::uint64_t elements, const std::uint64_t flops) noexcept
+      : m_operation(operation), m_elements(elements), m_flops(flops), m_start(std::chrono::steady_clock::now()) { }
+    InstrumentationScope(const InstrumentationScope &) = delete;
+    InstrumentationScope & operator =(const InstrumentationScope &) = delete;
+    ~InstrumentationScope()
+    {
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+      Instrumentation::RecordOperation(m_operation, m_elements, m_flops, static_cast<std::uint64_t>(elapsed));
+    }
+  };
+}
+
+/**
+ * \brief COMMON_MATH_INSTRUMENT instruments the rest of the enclosing scope as given operation,
+ * COMMON_MATH_INSTRUMENT_ALLOCATION records allocated matrix storage
+ */
+#ifdef COMMON_MATH_INSTRUMENTATION
+#define COMMON_MATH_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define COMMON_MATH_INSTRUMENT_CONCAT(a, b) COMMON_MATH_INSTRUMENT_CONCAT_IMPL(a, b)
+#define COMMON_MATH_INSTRUMENT(operation, elements, flops) \
+  const Common::Math::InstrumentationScope COMMON_MATH_INSTRUMENT_CONCAT(instrumentationScope, __LINE__)(operation, elements, flops)
+#define COMMON_MATH_INSTRUMENT_ALLOCATION(allocations, bytes) Common::Math::Instrumentation::RecordAllocation(allocations, bytes)
+#else
+#define COMMON_MATH_INSTRUMENT(operation, elements, flops) ((void)0)
+#define COMMON_MATH_INSTRUMENT_ALLOCATION(allocations, bytes) ((void)0)
+#endif
@@ -1,7 +1,18 @@
 ﻿#pragma once
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <sstream>
 #include <memory>
+#include <optional>
+#include "Accumulation.hpp"
+#include "Gemm.hpp"
+#include "HalfPrecision.hpp"
+#include "Instrumentation.hpp"
+#include "MatrixFormat.hpp"
+#include "MatrixKernels.hpp"
+#include "NumericTraits.hpp"
+#include "Tracing.hpp"
 #define NAMEOF(x) std::string(#x)
 
 namespace Common
@@ -9,7 +20,8 @@ namespace Common
   namespace Math
   {
     /**
-     * \brief Matrix properties
+     * \brief Matrix properties. Structural properties are guaranteed to hold, results of operations derive them
+     * from their operands and may omit structure arising from cancellation of values
      */
     enum class Type : unsigned
     {
@@ -24,7 +36,27 @@ namespace Common
       /**
        * \brief Matrix with ones on the main diagonal and zeros elsewhere
        */
-      Identity = 4
+      Identity = 4,
+      /**
+       * \brief N-by-N Matrix with zeros below the main diagonal
+       */
+      UpperTriangular = 8,
+      /**
+       * \brief N-by-N Matrix with zeros above the main diagonal
+       */
+      LowerTriangular = 16,
+      /**
+       * \brief N-by-N Matrix equal to its transpose
+       */
+      Symmetric = 32,
+      /**
+       * \brief N-by-N Matrix with zeros outside of the main diagonal
+       */
+      Diagonal = 64,
+      /**
+       * \brief N-by-N Matrix with a single one in every row and column and zeros elsewhere
+       */
+      Permutation = 128
     };
 
     constexpr Type operator | (const Type & selfValue, const Type & inValue)
@@ -32,6 +64,11 @@ namespace Common
       return static_cast<Type>(unsigned(selfValue) | unsigned(inValue));
     }
 
+    constexpr Type operator & (const Type & selfValue, const Type & inValue)
+    {
+      return static_cast<Type>(unsigned(selfValue) & unsigned(inValue));
+    }
+
     constexpr bool operator && (const Type & selfValue, const Type & inValue)
     {
       return (unsigned(selfValue) & unsigned(inValue)) != 0;
@@ -51,33 +88,70 @@ namespace Common
 
     /**
      * \brief Class representing a mathematical matrix
-     * \tparam T Type of matrix values. Type can only be numeric
+     * \tparam T Type of matrix values. Type can only be numeric, as decided by NumericTraits. Half precision
+     * types are stored as they are and accumulated in float by the multiplications
      */
-    template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value && (std::is_floating_point<T>::value || std::is_integral<T>::value)>>
+    template <typename T, typename = std::enable_if_t<NumericTraits<T>::IsNumeric>>
     class Matrix
     {
     protected:
+      /**
+       * \brief Type of a square matrix with zeros outside of the main diagonal
+       */
+      static constexpr Type DiagonalType = Type::Invertable | Type::Diagonal | Type::UpperTriangular | Type::LowerTriangular | Type::Symmetric;
+      /**
+       * \brief Type of an identity matrix
+       */
+      static constexpr Type IdentityType = DiagonalType | Type::Identity | Type::Permutation;
+      /**
+       * \brief Properties kept by element-wise operations on matrices sharing them
+       */
+      static constexpr Type ElementWiseMask = Type::NonInvertable | Type::Invertable | Type::UpperTriangular | Type::LowerTriangular | Type::Symmetric | Type::Diagonal;
+
       /**
        * \brief Type of given matrix
        */
       Type m_matrixType;
       /**
-       * \brief  Determinant of the matrix.
+       * \brief  Determinant of the matrix. Calculated on first use
        */
-      double m_determinant = 0;
+      mutable std::optional<double> m_determinant;
       /**
-       * \brief Inverse of the matrix
+       * \brief Inverse of the matrix. Calculated on first use
        */
-      std::shared_ptr<Matrix<T>> m_inverse;
+      mutable std::shared_ptr<Matrix<T>> m_inverse;
       /**
        * \brief Matrix data
        */
       std::vector<std::vector<T>> m_matrixValues;
 
-      void Recalculate()
+      /**
+       * \brief Records allocation of storage for given number of values
+       * \param rows Number of rows
+       * \param cols Number of columns
+       */
+      static void RecordAllocation(const std::size_t rows, const std::size_t cols) noexcept
       {
-        m_determinant = CalculateDeterminant(m_matrixValues);
-        m_inverse = CalculateInverse();
+        (void)rows;
+        (void)cols;
+        COMMON_MATH_INSTRUMENT_ALLOCATION(rows + 1, rows * sizeof(std::vector<T>) + rows * cols * sizeof(T));
+      }
+      /**
+       * \brief Discards properties derived from the matrix values after they have changed
+       * \param type Type known to hold for the new values
+       */
+      void Invalidate(const Type type)
+      {
+        m_matrixType = type;
+        m_determinant.reset();
+        m_inverse.reset();
+      }
+      /**
+       * \brief Discards properties derived from the matrix values after they have changed, classifying the new values
+       */
+      void Invalidate()
+      {
+        Invalidate(CalculateMatrixType(m_matrixValues));
       }
 
       /**
@@ -112,6 +186,7 @@ namespace Common
         if (rows <= 0 || cols <= 0)
           throw std::invalid_argument("Size must be greater than 0.");
 
+        RecordAllocation(rows, cols);
         std::vector<std::vector<T>> arr;
         arr.resize(rows);
         for (auto i = 0; i < rows; ++i)
@@ -137,26 +212,411 @@ namespace Common
 
         return Matrix<T>(cofactorValues);
       }
+      /**
+       * \brief Classifies the structure of given values in a single pass, stopping once no structure can hold
+       * \param matrix Values of the matrix
+       * \return Type of the matrix
+       */
       static Type CalculateMatrixType(const std::vector<std::vector<T>> & matrix)
       {
-        Type result;
-        if (matrix.size() == matrix[0].size())
+        const auto size = matrix.size();
+        if (size != matrix[0].size())
+          return Type::NonInvertable;
+
+        auto upper = true, lower = true, symmetric = true, permutation = true;
+        std::vector<bool> usedColumns(size);
+        for (std::size_t i = 0; i < size && (upper || lower || symmetric || permutation); ++i)
         {
-          result = Type::Identity;
-          if (IsIdentity(matrix)) result = result | Type::Identity;
+          std::size_t ones = 0;
+          for (std::size_t j = 0; j < size; ++j)
+          {
+            const auto & value = matrix[i][j];
+            if (symmetric && j > i && value != matrix[j][i])
+              symmetric = false;
+            if (value == 0)
+              continue;
+
+            if (j < i) upper = false;
+            if (j > i) lower = false;
+            if (value == 1 && !usedColumns[j])
+            {
+              usedColumns[j] = true;
+              ++ones;
+            }
+            else
+              permutation = false;
+          }
+
+          if (ones != 1) permutation = false;
+        }
+
+        auto result = Type::Invertable;
+        if (upper) result = result | Type::UpperTriangular;
+        if (lower) result = result | Type::LowerTriangular;
+        if (upper && lower) result = result | Type::Diagonal;
+        if (symmetric) result = result | Type::Symmetric;
+        if (permutation) result = result | Type::Permutation;
+
+        return CompleteType(matrix, result);
+      }
+      /**
+       * \brief Adds properties implied by the known ones, a diagonal or permutation matrix is checked for identity in O(n)
+       * \param matrix Values of the matrix
+       * \param type Known type of the matrix
+       * \return Completed type of the matrix
+       */
+      static Type CompleteType(const std::vector<std::vector<T>> & matrix, Type type)
+      {
+        if (type && Type::Diagonal)
+          type = type | Type::Symmetric;
+        if (!(type && (Type::Diagonal | Type::Permutation)))
+          return type;
+
+        for (std::size_t i = 0; i < matrix.size(); ++i)
+          if (matrix[i][i] != 1)
+            return type;
+
+        return IdentityType;
+      }
+      /**
+       * \brief Calculates the type of a product, keeping the structure shared by both operands
+       * \param left Type of the left operand
+       * \param right Type of the right operand
+       * \param square True if the product is a NxN matrix
+       * \return Type of the product, symmetry is not kept
+       */
+      static Type GetProductType(const Type left, const Type right, const bool square)
+      {
+        const auto shared = left & right & (Type::UpperTriangular | Type::LowerTriangular | Type::Diagonal | Type::Permutation);
+        return shared | (square ? Type::Invertable : Type::NonInvertable);
+      }
+      /**
+       * \brief Calculates the type of a transposed matrix
+       * \param type Type of the matrix
+       * \return Type with the triangles swapped
+       */
+      static Type GetTransposedType(const Type type)
+      {
+        auto result = type & (Type::NonInvertable | Type::Invertable | Type::Identity | Type::Symmetric | Type::Diagonal | Type::Permutation);
+        if (type && Type::UpperTriangular) result = result | Type::LowerTriangular;
+        if (type && Type::LowerTriangular) result = result | Type::UpperTriangular;
+
+        return result;
+      }
+      /**
+       * \brief Derives the type of values scaled element by element
+       * \param keepsZeros True if scaling a zero results in zero
+       * \param values Scaled values, classified again if the zeros were not kept
+       * \return Type of the scaled values
+       */
+      Type GetScaledType(const bool keepsZeros, const std::vector<std::vector<T>> & values) const
+      {
+        return keepsZeros ? CompleteType(values, m_matrixType & ElementWiseMask) : CalculateMatrixType(values);
+      }
+      /**
+       * \brief Retrieves the column of the single one in each row of a permutation matrix
+       * \return Permuted indices
+       */
+      std::vector<unsigned> GetPermutation() const
+      {
+        std::vector<unsigned> permutation(GetRows());
+        for (unsigned i = 0; i < GetRows(); ++i)
+          permutation[i] = static_cast<unsigned>(std::find_if(m_matrixValues[i].begin(), m_matrixValues[i].end(), [](const T & value) { return value != 0; }) - m_matrixValues[i].begin());
+
+        return permutation;
+      }
+      /**
+       * \brief Checks whether the product with given matrix only scales or permutes values
+       * \param other Right operand
+       * \return True if either operand is diagonal or a permutation
+       */
+      bool IsScalingOrPermutation(const Matrix<T> & other) const noexcept
+      {
+        const auto structure = Type::Diagonal | Type::Permutation;
+        return (m_matrixType && structure) || (other.m_matrixType && structure);
+      }
+      /**
+       * \brief Multiplies by scaling or permuting rows or columns in O(n^2), one of the operands is diagonal or a permutation
+       * \param other Right operand
+       * \return Product of the matrices
+       */
+      Matrix<T> MultiplyStructured(const Matrix<T> & other) const
+      {
+        COMMON_MATH_INSTRUMENT(Operation::Multiply, std::uint64_t(GetRows()) * other.GetColumns(), std::uint64_t(GetRows()) * other.GetColumns());
+        if (m_matrixType && Type::Identity)
+          return other;
+        if (other.m_matrixType && Type::Identity)
+          return *this;
+
+        auto outputValues = InitVector(GetRows(), other.GetColumns());
+        if (m_matrixType && Type::Diagonal)
+        {
+          // Row i of the product is row i of the right operand scaled by the i-th diagonal value
+          const auto & kernels = GetMatrixKernels<T>();
+          for (unsigned i = 0; i < GetRows(); ++i)
+            kernels.scale(other.m_matrixValues[i].data(), m_matrixValues[i][i], outputValues[i].data(), other.GetColumns());
+        }
+        else if (other.m_matrixType && Type::Diagonal)
+        {
+          // Column j of the product is column j of the left operand scaled by the j-th diagonal value
+          std::vector<T> diagonal(GetColumns());
+          for (unsigned j = 0; j < GetColumns(); ++j)
+            diagonal[j] = other.m_matrixValues[j][j];
+          for (unsigned i = 0; i < GetRows(); ++i)
+            for (unsigned j = 0; j < GetColumns(); ++j)
+              outputValues[i][j] = m_matrixValues[i][j] * diagonal[j];
+        }
+        else if (m_matrixType && Type::Permutation)
+        {
+          // Row i of the product is the row of the right operand selected by the one in row i
+          const auto permutation = GetPermutation();
+          for (unsigned i = 0; i < GetRows(); ++i)
+            outputValues[i] = other.m_matrixValues[permutation[i]];
         }
         else
-          result = Type::NonInvertable;
+        {
+          // Column k of the left operand moves to the column selected by the one in row k of the right operand
+          const auto permutation = other.GetPermutation();
+          for (unsigned i = 0; i < GetRows(); ++i)
+            for (unsigned k = 0; k < GetColumns(); ++k)
+              outputValues[i][permutation[k]] = m_matrixValues[i][k];
+        }
+
+        const auto type = CompleteType(outputValues, GetProductType(m_matrixType, other.m_matrixType, GetRows() == other.GetColumns()));
+        return Matrix<T>(std::move(outputValues), type);
+      }
+      /**
+       * \brief Calculates the determinant of a triangular matrix from its main diagonal and the determinant
+       * of a permutation matrix from the parity of its cycles, both in O(n)
+       * \return Determinant of the matrix
+       */
+      double CalculateStructuredDeterminant() const
+      {
+        double determinant = 1;
+        if (m_matrixType && (Type::UpperTriangular | Type::LowerTriangular))
+        {
+          for (unsigned i = 0; i < GetRows(); ++i)
+            determinant *= static_cast<double>(m_matrixValues[i][i]);
+
+          return determinant;
+        }
+
+        // Every cycle of even length is an odd number of transpositions
+        const auto permutation = GetPermutation();
+        std::vector<bool> visited(permutation.size());
+        for (unsigned i = 0; i < permutation.size(); ++i)
+        {
+          unsigned length = 0;
+          for (auto j = i; !visited[j]; j = permutation[j])
+          {
+            visited[j] = true;
+            ++length;
+          }
+
+          if (length != 0 && length % 2 == 0)
+            determinant = -determinant;
+        }
+
+        return determinant;
+      }
+      /**
+       * \brief Checks whether the determinant can be calculated in O(n)
+       * \return True if the matrix is triangular or a permutation
+       */
+      bool HasStructuredDeterminant() const noexcept
+      {
+        return m_matrixType && (Type::UpperTriangular | Type::LowerTriangular | Type::Permutation);
+      }
+      /**
+       * \brief Counts the arithmetic operations of the cofactor expansion of a matrix
+       * \param size Number of rows and columns
+       * \return Number of operations, saturated for expansions too large to ever finish
+       */
+      static std::uint64_t CountExpansionFlops(const std::uint64_t size) noexcept
+      {
+        // Closed formulas up to 3x3, above them every minor is multiplied by its value and sign and summed
+        if (size <= 1)
+          return 0;
+        if (size == 2)
+          return 3;
+
+        std::uint64_t flops = 17;
+        for (std::uint64_t n = 4; n <= size; ++n)
+        {
+          if (flops > std::numeric_limits<std::uint64_t>::max() / n - 3)
+            return std::numeric_limits<std::uint64_t>::max();
+          flops = n * (flops + 3);
+        }
+
+        return flops;
+      }
+      /**
+       * \brief Counts the arithmetic operations of the determinant by the algorithm GetDeterminant selects
+       * \return Number of operations
+       */
+      std::uint64_t CountDeterminantFlops() const noexcept
+      {
+        if (m_matrixType && Type::NonInvertable)
+          return 0;
+        if (HasStructuredDeterminant())
+          return m_matrixType && (Type::UpperTriangular | Type::LowerTriangular) ? GetRows() : 0;
+
+        return CountExpansionFlops(GetRows());
+      }
+      /**
+       * \brief Counts the arithmetic operations of the inverse by the algorithm CalculateInverse selects,
+       * excluding the determinant which is counted on its own
+       * \return Number of operations
+       */
+      std::uint64_t CountInverseFlops() const noexcept
+      {
+        const std::uint64_t size = GetRows();
+        if (m_matrixType && (Type::NonInvertable | Type::Identity | Type::Permutation))
+          return 0;
+        if (m_matrixType && Type::Diagonal)
+          return size;
+        // Substitution multiplies and adds the resolved rows, every row is then scaled by its reciprocal diagonal value
+        if (m_matrixType && (Type::UpperTriangular | Type::LowerTriangular))
+          return size * (size * size - 1) / 3 + size * size + size;
+        if (size <= 2)
+          return size == 1 ? 1 : 8;
+
+        // Signed minor of every value, the adjugate is then divided by the determinant
+        const auto minor = CountExpansionFlops(size - 1);
+        if (minor > std::numeric_limits<std::uint64_t>::max() / (size * size) - 3)
+          return std::numeric_limits<std::uint64_t>::max();
+
+        return size * size * (minor + 3);
+      }
+      /**
+       * \brief Inverts a triangular matrix by substitution of whole rows in O(n^3), the inverse keeps the triangle
+       * \return Inverse of the matrix
+       */
+      Matrix<T> CalculateTriangularInverse() const
+      {
+        const auto size = GetRows();
+        const auto upper = m_matrixType && Type::UpperTriangular;
+        const auto & kernels = GetMatrixKernels<double>();
+        std::vector<std::vector<double>> inverse(size, std::vector<double>(size));
+        for (unsigned step = 0; step < size; ++step)
+        {
+          // Rows of the inverse are resolved starting at the one with a single nonzero value
+          const auto i = upper ? size - 1 - step : step;
+          inverse[i][i] = 1;
+          for (auto k = upper ? i + 1 : 0; k < (upper ? size : i); ++k)
+          {
+            const auto begin = upper ? k : 0;
+            kernels.multiplyAdd(-static_cast<double>(m_matrixValues[i][k]), inverse[k].data() + begin, inverse[i].data() + begin, upper ? size - k : k + 1);
+          }
+
+          kernels.scale(inverse[i].data(), 1 / static_cast<double>(m_matrixValues[i][i]), inverse[i].data(), size);
+        }
+
+        auto inverseValues = InitVector(size, size);
+        for (unsigned i = 0; i < size; ++i)
+          for (unsigned j = 0; j < size; ++j)
+            inverseValues[i][j] = static_cast<T>(inverse[i][j]);
+
+        return Matrix<T>(std::move(inverseValues), m_matrixType & (Type::Invertable | Type::UpperTriangular | Type::LowerTriangular | Type::Symmetric));
+      }
+      /**
+       * \brief Raises a single value to a power by repeated squaring in the accumulator type
+       * \param value Value to raise
+       * \param exponent Exponent
+       * \return Raised value
+       */
+      static T RaiseValue(const T value, unsigned exponent)
+      {
+        using Accumulator = typename NumericTraits<T>::Accumulator;
+        Accumulator result = 1, base = static_cast<Accumulator>(value);
+        for (; exponent > 0; exponent >>= 1)
+        {
+          if (exponent & 1u) result *= base;
+          if (exponent > 1) base *= base;
+        }
+
+        return static_cast<T>(result);
+      }
+      /**
+       * \brief Raises the matrix to a non-negative power
+       * \param exponent Exponent
+       * \return Raised matrix
+       */
+      Matrix<T> Raise(unsigned exponent) const
+      {
+        const auto size = GetRows();
+        if (exponent == 0 || (m_matrixType && Type::Identity))
+          return Matrix<T>(static_cast<int>(size), true);
+
+        if (m_matrixType && Type::Diagonal)
+        {
+          auto values = InitVector(size, size);
+          for (unsigned i = 0; i < size; ++i)
+            values[i][i] = RaiseValue(m_matrixValues[i][i], exponent);
+
+          const auto type = CompleteType(values, DiagonalType);
+          return Matrix<T>(std::move(values), type);
+        }
+
+        if (m_matrixType && Type::Permutation)
+        {
+          // Powers of a permutation compose its indices, row i of the product of P and Q has its one in column q[p[i]]
+          std::vector<unsigned> result(size), base = GetPermutation(), next(size);
+          for (unsigned i = 0; i < size; ++i)
+            result[i] = i;
+          for (; exponent > 0; exponent >>= 1)
+          {
+            if (exponent & 1u)
+            {
+              for (unsigned i = 0; i < size; ++i)
+                next[i] = base[result[i]];
+              result.swap(next);
+            }
+            if (exponent > 1)
+            {
+              for (unsigned i = 0; i < size; ++i)
+                next[i] = base[base[i]];
+              base.swap(next);
+            }
+          }
+
+          auto values = InitVector(size, size);
+          for (unsigned i = 0; i < size; ++i)
+            values[i][result[i]] = 1;
+
+          const auto type = CompleteType(values, Type::Invertable | Type::Permutation);
+          return Matrix<T>(std::move(values), type);
+        }
+
+        // The identity start is multiplied in O(n^2) by the structured product
+        Matrix<T> result(static_cast<int>(size), true);
+        auto base = *this;
+        for (; exponent > 0; exponent >>= 1)
+        {
+          if (exponent & 1u) result = result * base;
+          if (exponent > 1) base = base * base;
+        }
 
         return result;
       }
-      static double CalculateDeterminant(const std::vector<std::vector<T>> & matrix)
+      /**
+       * \brief Calculates the determinant by cofactor expansion, summing the terms of each expansion by given policy
+       * \param matrix Values of the matrix
+       * \param accumulation Accumulation policy of the expansion terms
+       * \return Determinant of the matrix
+       */
+      static double CalculateDeterminant(const std::vector<std::vector<T>> & matrix, const Accumulation accumulation)
       {
         if (matrix.size() != matrix[0].size())
           throw InvertableMatrixOperationException("Determinant can be calculated only for NxN matricies.");
 
+        if (accumulation != Accumulation::Naive && matrix.size() > 1)
+          return CalculateDeterminantTerms(matrix, accumulation);
+
         switch (matrix.size())
         {
+        case 1:
+          return static_cast<double>(matrix[0][0]);
         case 2:
           return static_cast<double>(matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0]);
         case 3:
@@ -191,7 +651,7 @@ namespace Common
               }
             }
 
-            determinant = matrix[0][i] * CalculateDeterminant(data) * sign + determinant;
+            determinant = matrix[0][i] * CalculateDeterminant(data, accumulation) * sign + determinant;
             sign = -sign;
           }
 
@@ -199,11 +659,58 @@ namespace Common
         }
         }
       }
+      static double CalculateDeterminantTerms(const std::vector<std::vector<T>> & matrix, const Accumulation accumulation)
+      {
+        const auto size = matrix.size();
+        std::vector<double> terms;
+        if (size == 2)
+          terms = { static_cast<double>(matrix[0][0]) * matrix[1][1], -static_cast<double>(matrix[0][1]) * matrix[1][0] };
+        else
+        {
+          terms.resize(size);
+          auto data = InitVector(size - 1, size - 1);
+          for (unsigned i = 0; i < size; ++i)
+          {
+            // Minor of the first row and the i-th column
+            for (unsigned row = 1; row < size; ++row)
+              for (unsigned col = 0, target = 0; col < size; ++col)
+                if (col != i)
+                  data[row - 1][target++] = matrix[row][col];
+
+            terms[i] = static_cast<double>(matrix[0][i]) * CalculateDeterminant(data, accumulation) * (i % 2 == 0 ? 1 : -1);
+          }
+        }
+
+        return Reduction::Sum(terms.data(), terms.size(), accumulation);
+      }
       std::shared_ptr<Matrix<T>> CalculateInverse() const
       {
         if (m_matrixType && Type::NonInvertable)
           throw InvertableMatrixOperationException("Inverse can be calculated only for NxN matricies.");
 
+        if (GetDeterminant() == 0)
+          throw InvertableMatrixOperationException("Inverse cannot be calculated for a singular matrix.");
+
+        if (m_matrixType && Type::Identity)
+          return std::make_shared<Matrix<T>>(*this);
+        if (m_matrixType && Type::Diagonal)
+        {
+          auto inverse = InitVector(GetRows(), GetColumns());
+          for (unsigned i = 0; i < GetRows(); ++i)
+            inverse[i][i] = static_cast<T>(1 / static_cast<double>(m_matrixValues[i][i]));
+
+          const auto type = CompleteType(inverse, DiagonalType);
+          return std::make_shared<Matrix<T>>(Matrix<T>(std::move(inverse), type));
+        }
+        // The inverse of a permutation is its transpose
+        if (m_matrixType && Type::Permutation)
+          return std::make_shared<Matrix<T>>(Transpose());
+        if (m_matrixType && (Type::UpperTriangular | Type::LowerTriangular))
+          return std::make_shared<Matrix<T>>(CalculateTriangularInverse());
+
+        if (GetRows() == 1)
+          return std::make_shared<Matrix<T>>(std::vector<std::vector<T>> { { static_cast<T>(1 / GetDeterminant()) } });
+
         if (GetRows() == 2)
         {
           auto inverse = InitVector(2, 2);
@@ -235,40 +742,45 @@ namespace Common
               coords[1] = 0;
             }
 
-            matrixofminors[i][j] = CalculateDeterminant(submatrix);
+            matrixofminors[i][j] = CalculateDeterminant(submatrix, Accumulation::Naive) * ((i + j) % 2 == 0 ? 1 : -1);
           }
         }
 
-        auto minorMatrix = Matrix<T>(matrixofminors);
-        std::vector<std::vector<T>> cofactorMatrix = minorMatrix.Transpose()->GetMatrixValues();
+        auto minorMatrix = Matrix<T>(std::move(matrixofminors));
+        std::vector<std::vector<T>> cofactorMatrix = minorMatrix.Transpose().GetMatrixValues();
 
         for (unsigned i = 0; i < GetColumns(); i++)
           for (unsigned j = 0; j < GetColumns(); j++)
             cofactorMatrix[i][j] = static_cast<T>(cofactorMatrix[i][j] * 1 / GetDeterminant());
 
-        return std::make_shared<Matrix<T>>(cofactorMatrix);
+        return std::make_shared<Matrix<T>>(std::move(cofactorMatrix));
       }
 
-      static bool IsIdentity(const std::vector<std::vector<T>> & matrix)
-      {
-        unsigned index = 0;
-        for (unsigned i = 0; i < matrix.size(); i++)
-        {
-          for (unsigned j = 0; j < matrix[0].size(); j++)
-            if (matrix[i][j] != (index == j ? 1 : 0))
-              return false;
-          ++index;
-        }
-
-        return true;
-      }
+      /**
+       * \brief Constructs the matrix from values of a known type
+       * \param values Collection of values to move from
+       * \param type Type of the values
+       */
+      Matrix(std::vector<std::vector<T>> && values, const Type type)
+        : m_matrixType(type),
+        m_matrixValues(std::move(values)) { }
 
     public:
       explicit Matrix(const std::vector<std::vector<T>> & values)
-        : m_matrixType(CalculateMatrixType(values)),
-        m_matrixValues(ValidateArray(values)) { }
+        : m_matrixType(CalculateMatrixType(ValidateArray(values))),
+        m_matrixValues(values)
+      {
+        RecordAllocation(GetRows(), GetColumns());
+      }
+      /**
+       * \brief Constructs the matrix by taking ownership of given values
+       * \param values Collection of values to move from
+       */
+      explicit Matrix(std::vector<std::vector<T>> && values)
+        : m_matrixType(CalculateMatrixType(ValidateArray(values))),
+        m_matrixValues(std::move(values)) { }
       Matrix(const int size, const bool identity)
-        : m_matrixType(identity ? Type::Identity | Type::Invertable : Type::Invertable),
+        : m_matrixType(identity ? IdentityType : DiagonalType),
         m_matrixValues(InitVector(size, size))
       {
         if (identity)
@@ -276,7 +788,7 @@ namespace Common
             m_matrixValues[i][i] = 1;
       }
       Matrix(const int length, const int height)
-        : m_matrixType(length == height ? Type::Invertable : Type::NonInvertable),
+        : m_matrixType(length == height ? DiagonalType : Type::NonInvertable),
         m_matrixValues(InitVector(length, height)) { }
       /**
        * \brief Copy constructor
@@ -287,7 +799,9 @@ namespace Common
         m_determinant(matrix.m_determinant),
         m_inverse(matrix.m_inverse),
         m_matrixValues(matrix.m_matrixValues)
-      { }
+      {
+        RecordAllocation(GetRows(), GetColumns());
+      }
       /**
        * \brief Move constructor
        * \param other Matrix instance to move from
@@ -323,7 +837,7 @@ namespace Common
       void SetMatrixValues(const std::vector<std::vector<T>> & values)
       {
         m_matrixValues = ValidateArray(values);
-        Recalculate();
+        Invalidate();
       }
       /**
        * \brie Getter method for the Type property
@@ -334,24 +848,103 @@ namespace Common
        * \brief Getter method for the Inverse property
        * \return Inverse of the matrix
        */
-      const Matrix<T> & GetInverse() const noexcept { return m_inverse; }
+      const Matrix<T> & GetInverse() const
+      {
+        if (!m_inverse)
+        {
+          COMMON_MATH_INSTRUMENT(Operation::Inverse, std::uint64_t(GetRows()) * GetColumns(), CountInverseFlops());
+          COMMON_MATH_TRACE("Matrix::Inverse", GetRows());
+          m_inverse = CalculateInverse();
+        }
+
+        return *m_inverse;
+      }
       /**
        * \brief Getter method for the Determinant property
        * \return Determinant of the matrix
        */
-      double GetDeterminant() const noexcept { return m_determinant; }
-      Matrix<T> Transpose() const noexcept
+      double GetDeterminant() const
+      {
+        if (!m_determinant)
+        {
+          COMMON_MATH_INSTRUMENT(Operation::Determinant, 1, CountDeterminantFlops());
+          COMMON_MATH_TRACE("Matrix::Determinant", GetRows());
+          m_determinant = HasStructuredDeterminant() ? CalculateStructuredDeterminant() : CalculateDeterminant(m_matrixValues, Accumulation::Naive);
+        }
+
+        return *m_determinant;
+      }
+      /**
+       * \brief Calculates the determinant summing the terms of the cofactor expansion by given policy
+       * \param accumulation Accumulation policy, the naive one and matrices with a structured determinant return
+       * the cached determinant
+       * \return Determinant of the matrix
+       */
+      double GetDeterminant(const Accumulation accumulation) const
+      {
+        if (accumulation == Accumulation::Naive || HasStructuredDeterminant())
+          return GetDeterminant();
+
+        COMMON_MATH_INSTRUMENT(Operation::Determinant, 1, CountDeterminantFlops());
+        COMMON_MATH_TRACE("Matrix::Determinant", GetRows());
+        return CalculateDeterminant(m_matrixValues, accumulation);
+      }
+      /**
+       * \brief Raises the matrix to an integer power by repeated squaring. Diagonal and permutation matrices
+       * are raised without any matrix product
+       * \param exponent Exponent, zero results in the identity and negative exponents raise the inverse
+       * \return Raised matrix
+       */
+      Matrix<T> Power(const int exponent) const
+      {
+        if (m_matrixType && Type::NonInvertable)
+          throw InvertableMatrixOperationException("Power can be calculated only for NxN matricies.");
+
+        COMMON_MATH_TRACE("Matrix::Power", GetRows());
+        if (exponent < 0)
+          return GetInverse().Raise(0u - static_cast<unsigned>(exponent));
+
+        return Raise(static_cast<unsigned>(exponent));
+      }
+      /**
+       * \brief Sums all values of the matrix
+       * \param accumulation Accumulation policy applied to the values
+       * \return Sum of the values
+       */
+      T Sum(const Accumulation accumulation = Accumulation::Naive) const
+      {
+        // Compensated and wide accumulators hold more than T, rounding them at the end of every row would discard it.
+        // Their values are gathered so that a single accumulator covers the whole matrix
+        if (GetRows() > 1 && (accumulation == Accumulation::KahanNeumaier || accumulation == Accumulation::Wide))
+        {
+          std::vector<T> values;
+          values.reserve(std::size_t(GetRows()) * GetColumns());
+          for (const auto & row : m_matrixValues)
+            values.insert(values.end(), row.begin(), row.end());
+
+          return Reduction::Sum(values.data(), values.size(), accumulation);
+        }
+
+        std::vector<T> rowSums(GetRows());
+        for (unsigned i = 0; i < GetRows(); ++i)
+          rowSums[i] = Reduction::Sum(m_matrixValues[i].data(), GetColumns(), accumulation);
+
+        return Reduction::Sum(rowSums.data(), rowSums.size(), accumulation);
+      }
+      Matrix<T> Transpose() const
       {
-        auto transposedValues = InitVector(GetRows(), GetColumns());
+        COMMON_MATH_INSTRUMENT(Operation::Transpose, std::uint64_t(GetRows()) * GetColumns(), 0);
+        auto transposedValues = InitVector(GetColumns(), GetRows());
         for (unsigned i = 0; i < GetColumns(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
+          for (unsigned j = 0; j < GetRows(); ++j)
             transposedValues[i][j] = m_matrixValues[j][i];
 
-        return Matrix<T>(transposedValues);
+        return Matrix<T>(std::move(transposedValues), GetTransposedType(m_matrixType));
       }
 
       Matrix<T> & operator = (const Matrix<T> & other)
       {
+        RecordAllocation(other.GetRows(), other.GetColumns());
         m_matrixValues = other.m_matrixValues;
         m_matrixType = other.m_matrixType;
         m_determinant = other.m_determinant;
@@ -374,22 +967,26 @@ namespace Common
         if (GetRows() != other.GetRows() || GetColumns() != other.GetColumns())
           throw MatrixDimensionException("Matricies of different dimensions cannot be summed.");
 
+        COMMON_MATH_INSTRUMENT(Operation::Add, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
         std::vector<std::vector<T>> outputValues = InitVector(GetRows(), GetColumns());
+        const auto & kernels = GetMatrixKernels<T>();
 
         for (unsigned i = 0; i < GetRows(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
-            outputValues[i][j] = m_matrixValues[i][j] + other.m_matrixValues[i][j];
+          kernels.add(m_matrixValues[i].data(), other.m_matrixValues[i].data(), outputValues[i].data(), GetColumns());
 
-        return Matrix<T>(outputValues);
+        const auto type = CompleteType(outputValues, m_matrixType & other.m_matrixType & ElementWiseMask);
+        return Matrix<T>(std::move(outputValues), type);
       }
       Matrix<T> & operator +=(const Matrix<T> & other)
       {
         if (GetRows() != other.GetRows() || GetColumns() != other.GetColumns())
           throw MatrixDimensionException("Matricies of different dimensions cannot be summed.");
 
+        COMMON_MATH_INSTRUMENT(Operation::Add, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
+        const auto & kernels = GetMatrixKernels<T>();
         for (unsigned i = 0; i < GetRows(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
-            m_matrixValues[i][j] += other.m_matrixValues[i][j];
+          kernels.add(m_matrixValues[i].data(), other.m_matrixValues[i].data(), m_matrixValues[i].data(), GetColumns());
+        Invalidate(CompleteType(m_matrixValues, m_matrixType & other.m_matrixType & ElementWiseMask));
 
         return *this;
       }
@@ -399,100 +996,183 @@ namespace Common
         if (GetRows() != other.GetRows() || GetColumns() != other.GetColumns())
           throw MatrixDimensionException("Matricies of different dimensions cannot be summed.");
 
+        COMMON_MATH_INSTRUMENT(Operation::Subtract, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
         std::vector<std::vector<T>> outputValues = InitVector(GetRows(), GetColumns());
+        const auto & kernels = GetMatrixKernels<T>();
 
         for (unsigned i = 0; i < GetRows(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
-            outputValues[i][j] = m_matrixValues[i][j] - other.m_matrixValues[i][j];
+          kernels.subtract(m_matrixValues[i].data(), other.m_matrixValues[i].data(), outputValues[i].data(), GetColumns());
 
-        return Matrix<T>(outputValues);
+        const auto type = CompleteType(outputValues, m_matrixType & other.m_matrixType & ElementWiseMask);
+        return Matrix<T>(std::move(outputValues), type);
       }
       Matrix<T> & operator -=(const Matrix<T> & other)
       {
         if (GetRows() != other.GetRows() || GetColumns() != other.GetColumns())
           throw MatrixDimensionException("Matricies of different dimensions cannot be summed.");
 
+        COMMON_MATH_INSTRUMENT(Operation::Subtract, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
+        const auto & kernels = GetMatrixKernels<T>();
         for (unsigned i = 0; i < GetRows(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
-            m_matrixValues[i][j] -= other.m_matrixValues[i][j];
+          kernels.subtract(m_matrixValues[i].data(), other.m_matrixValues[i].data(), m_matrixValues[i].data(), GetColumns());
+        Invalidate(CompleteType(m_matrixValues, m_matrixType & other.m_matrixType & ElementWiseMask));
 
         return *this;
       }
 
       Matrix<T> operator * (const Matrix<T> & other) const
       {
-        if (GetRows() != other.GetColumns())
-          throw MatrixDimensionException("");
+        if (GetColumns() != other.GetRows())
+          throw MatrixDimensionException("Number of columns of the left operand must match number of rows of the right operand.");
+        if (IsScalingOrPermutation(other))
+          return MultiplyStructured(other);
 
+        COMMON_MATH_INSTRUMENT(Operation::Multiply, std::uint64_t(GetRows()) * other.GetColumns(), 2 * std::uint64_t(GetRows()) * GetColumns() * other.GetColumns());
+        COMMON_MATH_TRACE("Matrix::Multiply", std::uint64_t(GetRows()) * GetColumns() * other.GetColumns());
         std::vector<std::vector<T>> outputValues = InitVector(GetRows(), other.GetColumns());
+        Gemm::Multiply(m_matrixValues, other.m_matrixValues, outputValues, GemmProfile::GetActive<T>());
 
-        for (unsigned i = 0; i < other.GetColumns(); i++)
-          for (unsigned j = 0; j < GetRows(); j++)
-            for (unsigned k = 0; k < GetRows(); k++)
-              outputValues[i][j] = outputValues[i][j] + m_matrixValues[i][k] * other.m_matrixValues[k][j];
-
-        return Matrix<T>(outputValues);
+        return Matrix<T>(std::move(outputValues));
       }
 
-      template <typename TOther, typename = std::enable_if_t<std::is_arithmetic<TOther>::value && (std::is_floating_point<TOther>::value || std::is_integral<TOther>::value)>>
-      Matrix<T> operator * (const TOther & other) const
+      /**
+       * \brief Multiplies matrices computing each element as a dot product summed by given policy
+       * \param other Right operand
+       * \param accumulation Accumulation policy, the naive one equals the multiplication operator. Products
+       * scaling or permuting values sum no terms and ignore it
+       * \return Product of the matrices
+       */
+      Matrix<T> Multiply(const Matrix<T> & other, const Accumulation accumulation) const
       {
-        std::vector<std::vector<T>> outputValues = InitVector(GetRows(), GetColumns());
+        if (accumulation == Accumulation::Naive || IsScalingOrPermutation(other))
+          return *this * other;
+        if (GetColumns() != other.GetRows())
+          throw MatrixDimensionException("Number of columns of the left operand must match number of rows of the right operand.");
+
+        COMMON_MATH_INSTRUMENT(Operation::Multiply, std::uint64_t(GetRows()) * other.GetColumns(), 2 * std::uint64_t(GetRows()) * GetColumns() * other.GetColumns());
+        COMMON_MATH_TRACE("Matrix::Multiply", std::uint64_t(GetRows()) * GetColumns() * other.GetColumns());
+        // Columns of the right operand become contiguous rows
+        const auto columns = other.Transpose();
+        std::vector<std::vector<T>> outputValues = InitVector(GetRows(), other.GetColumns());
 
         for (unsigned i = 0; i < GetRows(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
-            outputValues[i][j] = m_matrixValues[i][j] * other;
+          for (unsigned j = 0; j < other.GetColumns(); ++j)
+            outputValues[i][j] = Reduction::Dot(m_matrixValues[i].data(), columns.m_matrixValues[j].data(), GetColumns(), accumulation);
 
-        return Matrix<T>(outputValues);
+        return Matrix<T>(std::move(outputValues));
       }
-      template <typename TOther, typename = std::enable_if_t<std::is_arithmetic<TOther>::value && (std::is_floating_point<TOther>::value || std::is_integral<TOther>::value)>>
-      Matrix<T> & operator *=(const TOther & other) const
+
+      /**
+       * \brief Multiplies the matrix by a column vector
+       * \param vector Values of the vector, one per column of the matrix
+       * \return Values of the product, one per row of the matrix
+       */
+      std::vector<T> operator * (const std::vector<T> & vector) const
       {
+        if (GetColumns() != vector.size())
+          throw MatrixDimensionException("Number of columns of the matrix must match size of the vector.");
+
+        std::vector<T> output(GetRows());
+        if (m_matrixType && (Type::Diagonal | Type::Permutation))
+        {
+          COMMON_MATH_INSTRUMENT(Operation::Multiply, GetRows(), GetRows());
+          const auto permutation = m_matrixType && Type::Diagonal ? std::vector<unsigned>() : GetPermutation();
+          for (unsigned i = 0; i < GetRows(); ++i)
+            output[i] = permutation.empty() ? static_cast<T>(m_matrixValues[i][i] * vector[i]) : vector[permutation[i]];
+
+          return output;
+        }
+
+        COMMON_MATH_INSTRUMENT(Operation::Multiply, GetRows(), 2 * std::uint64_t(GetRows()) * GetColumns());
+        Gemm::MultiplyVector(m_matrixValues, vector.data(), output.data());
+
+        return output;
+      }
+
+      template <typename TOther, typename = std::enable_if_t<NumericTraits<TOther>::IsNumeric>>
+      Matrix<T> operator * (const TOther & other) const
+      {
+        COMMON_MATH_INSTRUMENT(Operation::Scale, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
         std::vector<std::vector<T>> outputValues = InitVector(GetRows(), GetColumns());
 
         for (unsigned i = 0; i < GetRows(); ++i)
-          for (unsigned j = 0; j < GetColumns(); ++j)
-            m_matrixValues[i][j] *= other;
+          if constexpr (std::is_same<T, TOther>::value)
+            GetMatrixKernels<T>().scale(m_matrixValues[i].data(), other, outputValues[i].data(), GetColumns());
+          else
+            for (unsigned j = 0; j < GetColumns(); ++j)
+              outputValues[i][j] = m_matrixValues[i][j] * other;
+
+        const auto type = GetScaledType(T(0) * other == 0, outputValues);
+        return Matrix<T>(std::move(outputValues), type);
+      }
+      template <typename TOther, typename = std::enable_if_t<NumericTraits<TOther>::IsNumeric>>
+      Matrix<T> & operator *=(const TOther & other)
+      {
+        COMMON_MATH_INSTRUMENT(Operation::Scale, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
+        for (unsigned i = 0; i < GetRows(); ++i)
+          if constexpr (std::is_same<T, TOther>::value)
+            GetMatrixKernels<T>().scale(m_matrixValues[i].data(), other, m_matrixValues[i].data(), GetColumns());
+          else
+            for (unsigned j = 0; j < GetColumns(); ++j)
+              m_matrixValues[i][j] *= other;
+        Invalidate(GetScaledType(T(0) * other == 0, m_matrixValues));
 
         return *this;
       }
 
-      template <typename TOther, typename = std::enable_if_t<std::is_arithmetic<TOther>::value && (std::is_floating_point<TOther>::value || std::is_integral<TOther>::value)>>
+      template <typename TOther, typename = std::enable_if_t<NumericTraits<TOther>::IsNumeric>>
       Matrix<T> operator / (const TOther & other) const
       {
+        COMMON_MATH_INSTRUMENT(Operation::Divide, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
         std::vector<std::vector<T>> outputValues = InitVector(GetRows(), GetColumns());
 
         for (unsigned i = 0; i < GetRows(); ++i)
           for (unsigned j = 0; j < GetColumns(); ++j)
             outputValues[i][j] = m_matrixValues[i][j] / other;
 
-        return Matrix<T>(outputValues);
+        const auto type = GetScaledType(T(0) / other == 0, outputValues);
+        return Matrix<T>(std::move(outputValues), type);
       }
-      template <typename TOther, typename = std::enable_if_t<std::is_arithmetic<TOther>::value && (std::is_floating_point<TOther>::value || std::is_integral<TOther>::value)>>
-      Matrix<T> & operator /=(const TOther & other) const
+      template <typename TOther, typename = std::enable_if_t<NumericTraits<TOther>::IsNumeric>>
+      Matrix<T> & operator /=(const TOther & other)
       {
-        std::vector<std::vector<T>> outputValues = InitVector(GetRows(), GetColumns());
-
+        COMMON_MATH_INSTRUMENT(Operation::Divide, std::uint64_t(GetRows()) * GetColumns(), std::uint64_t(GetRows()) * GetColumns());
         for (unsigned i = 0; i < GetRows(); ++i)
           for (unsigned j = 0; j < GetColumns(); ++j)
             m_matrixValues[i][j] /= other;
+        Invalidate(GetScaledType(T(0) / other == 0, m_matrixValues));
 
         return *this;
       }
 
-      std::string ToString() const
+      /**
+       * \brief Formats the matrix into a string which can be parsed back
+       * \param format Layout of the output
+       * \return Formatted matrix
+       */
+      std::string ToString(const MatrixFormat & format = MatrixFormat()) const
       {
-        std::ostringstream result;
-        for (unsigned row = 0; row < GetRows(); row++)
-        {
-          for (unsigned column = 0; column < GetColumns() - 1; column++)
-            result << m_matrixValues[row][column];
-          result << m_matrixValues[row][GetColumns() - 1];
-
-          if (row != GetRows() - 1) result << '\n';
-        }
-
-        return result.str();
+        return MatrixFormatter::ToString(GetRows(), GetColumns(), [this](const unsigned row) { return m_matrixValues[row].data(); }, format);
+      }
+      /**
+       * \brief Formats the matrix into a caller-provided buffer
+       * \param first Beginning of the output buffer
+       * \param last End of the output buffer
+       * \param format Layout of the output
+       * \return End of the written characters
+       */
+      char * Format(char * first, char * last, const MatrixFormat & format = MatrixFormat()) const
+      {
+        return MatrixFormatter::Format(first, last, GetRows(), GetColumns(), [this](const unsigned row) { return m_matrixValues[row].data(); }, format);
+      }
+      /**
+       * \brief Writes the formatted matrix to a stream
+       * \param output Stream to write to
+       * \param format Layout of the output
+       */
+      void Write(std::ostream & output, const MatrixFormat & format = MatrixFormat()) const
+      {
+        MatrixFormatter::Write(output, GetRows(), GetColumns(), [this](const unsigned row) { return m_matrixValues[row].data(); }, format);
       }
     };
   }
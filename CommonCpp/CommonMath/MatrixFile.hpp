@@ -0,0 +1,570 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common::Math
+{
+  class MatrixFileException : public std::runtime_error
+  {
+  public:
+    explicit MatrixFileException(const std::string & msg) noexcept : std::runtime_error(msg) {  }
+  };
+
+  /**
+   * \brief Type of values stored in a matrix file
+   */
+  enum class ElementType : std::uint16_t
+  {
+    Int8 = 1,
+    UInt8 = 2,
+    Int16 = 3,
+    UInt16 = 4,
+    Int32 = 5,
+    UInt32 = 6,
+    Int64 = 7,
+    UInt64 = 8,
+    Float32 = 9,
+    Float64 = 10
+  };
+
+  /**
+   * \brief Resolves the file element type of given value type
+   * \tparam T Type of matrix values
+   * \return Element type tag
+   */
+  template <typename T>
+  constexpr ElementType GetElementType() noexcept
+  {
+    static_assert(std::is_arithmetic<T>::value, "GetElementType: T must be an arithmetic type.");
+    if constexpr (std::is_floating_point<T>::value)
+    {
+      static_assert(sizeof(T) == 4 || sizeof(T) == 8, "GetElementType: only 32 and 64 bit floating point types are supported.");
+      return sizeof(T) == 4 ? ElementType::Float32 : ElementType::Float64;
+    }
+    else
+    {
+      constexpr auto isSigned = std::is_signed<T>::value;
+      switch (sizeof(T))
+      {
+      case 1: return isSigned ? ElementType::Int8 : ElementType::UInt8;
+      case 2: return isSigned ? ElementType::Int16 : ElementType::UInt16;
+      case 4: return isSigned ? ElementType::Int32 : ElementType::UInt32;
+      default: return isSigned ? ElementType::Int64 : ElementType::UInt64;
+      }
+    }
+  }
+
+  /**
+   * \brief Fixed size header preceding the payload of a matrix file
+   */
+  struct MatrixFileHeader
+  {
+    /**
+     * \brief File signature
+     */
+    char magic[4];
+    /**
+     * \brief Format version
+     */
+    std::uint16_t version;
+    /**
+     * \brief Byte order mark written in the byte order of the producing machine
+     */
+    std::uint16_t byteOrder;
+    /**
+     * \brief Type of stored values
+     */
+    std::uint16_t elementType;
+    /**
+     * \brief Reserved for future use, always zero
+     */
+    std::uint16_t reserved;
+    /**
+     * \brief Size of a single value in bytes
+     */
+    std::uint32_t elementSize;
+    /**
+     * \brief Alignment of the payload in bytes
+     */
+    std::uint32_t alignment;
+    /**
+     * \brief Padding keeping the following fields aligned, always zero
+     */
+    std::uint32_t padding;
+    /**
+     * \brief Number of rows
+     */
+    std::uint64_t rows;
+    /**
+     * \brief Number of columns
+     */
+    std::uint64_t columns;
+    /**
+     * \brief Offset of the payload from the beginning of the file
+     */
+    std::uint64_t payloadOffset;
+    /**
+     * \brief Size of the payload in bytes
+     */
+    std::uint64_t payloadSize;
+    /**
+     * \brief Checksum of the payload
+     */
+    std::uint64_t checksum;
+  };
+
+  static_assert(sizeof(MatrixFileHeader) == 64, "MatrixFileHeader must be 64 bytes long.");
+
+  /**
+   * \brief Streaming FNV-1a checksum computed over 64-bit words of the payload
+   */
+  class MatrixFileChecksum
+  {
+    std::uint64_t m_hash = 14695981039346656037ull;
+    std::uint64_t m_pending = 0;
+    unsigned m_pendingBytes = 0;
+
+    void Mix(const std::uint64_t word) noexcept
+    {
+      m_hash ^= word;
+      m_hash *= 1099511628211ull;
+    }
+
+  public:
+    /**
+     * \brief Feeds a block of bytes into the checksum
+     * \param data Bytes to process
+     * \param size Number of bytes
+     */
+    void Update(const void * data, std::size_t size) noexcept
+    {
+      auto bytes = static_cast<const unsigned char *>(data);
+      while (m_pendingBytes != 0 && size != 0)
+      {
+        m_pending |= static_cast<std::uint64_t>(*bytes++) << (8 * m_pendingBytes);
+        --size;
+        if (++m_pendingBytes == 8)
+        {
+          Mix(m_pending);
+          m_pending = 0;
+          m_pendingBytes = 0;
+        }
+      }
+
+      for (; size >= 8; size -= 8, bytes += 8)
+      {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        Mix(word);
+      }
+
+      for (; size != 0; --size)
+        m_pending |= static_cast<std::uint64_t>(*bytes++) << (8 * m_pendingBytes++);
+    }
+
+    /**
+     * \brief Finishes the computation
+     * \return Checksum of all processed bytes
+     */
+    std::uint64_t GetValue() const noexcept
+    {
+      auto copy = *this;
+      if (copy.m_pendingBytes != 0)
+        copy.Mix(copy.m_pending);
+
+      return copy.m_hash;
+    }
+  };
+
+  /**
+   * \brief Versioned binary matrix file format consisting of a header followed by an aligned, row-major payload
+   */
+  class MatrixFile
+  {
+    /**
+     * \brief Checks whether a payload alignment is a power of two within the supported limits
+     */
+    static constexpr bool IsValidAlignment(const std::uint64_t alignment, const std::uint64_t minAlignment) noexcept
+    {
+      return alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= MaxAlignment && alignment >= minAlignment;
+    }
+
+  public:
+    /**
+     * \brief Current format version
+     */
+    static constexpr std::uint16_t Version = 1;
+    /**
+     * \brief Byte order mark of the current machine
+     */
+    static constexpr std::uint16_t ByteOrderMark = 0xFEFF;
+    /**
+     * \brief Largest supported payload alignment. Mappings start at a page boundary, hence the limit
+     */
+    static constexpr unsigned MaxAlignment = 4096;
+
+    /**
+     * \brief Creates a header describing a matrix of given size
+     * \tparam T Type of matrix values
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param alignment Alignment of the payload in bytes
+     * \return Header with a zero checksum
+     */
+    template <typename T>
+    static MatrixFileHeader CreateHeader(const std::uint64_t rows, const std::uint64_t columns, const unsigned alignment)
+    {
+      if (!IsValidAlignment(alignment, alignof(T)))
+        throw std::invalid_argument("Argument " + NAMEOF(alignment) + " must be a power of two between the alignment of T and " + std::to_string(MaxAlignment) + ".");
+      if (rows == 0 || columns == 0)
+        throw std::invalid_argument("Size must be greater than 0.");
+
+      MatrixFileHeader header{};
+      std::memcpy(header.magic, "CMMX", 4);
+      header.version = Version;
+      header.byteOrder = ByteOrderMark;
+      header.elementType = static_cast<std::uint16_t>(GetElementType<T>());
+      header.elementSize = sizeof(T);
+      header.alignment = alignment;
+      header.rows = rows;
+      header.columns = columns;
+      header.payloadOffset = (sizeof(MatrixFileHeader) + alignment - 1) / alignment * alignment;
+      header.payloadSize = rows * columns * sizeof(T);
+
+      return header;
+    }
+
+    /**
+     * \brief Validates a header read from a file against the expected value type
+     * \tparam T Type of matrix values
+     * \param header Header to validate
+     * \param fileSize Size of the whole file in bytes
+     */
+    template <typename T>
+    static void ValidateHeader(const MatrixFileHeader & header, const std::uint64_t fileSize)
+    {
+      if (std::memcmp(header.magic, "CMMX", 4) != 0)
+        throw MatrixFileException("File is not a matrix file.");
+      if (header.byteOrder != ByteOrderMark)
+        throw MatrixFileException("File was written with a different byte order.");
+      if (header.version != Version)
+        throw MatrixFileException("Unsupported matrix file version " + std::to_string(header.version) + ".");
+      if (header.elementType != static_cast<std::uint16_t>(GetElementType<T>()) || header.elementSize != sizeof(T))
+        throw MatrixFileException("File element type does not match the requested matrix type.");
+      if (header.rows == 0 || header.columns == 0
+        || header.rows > std::numeric_limits<unsigned>::max() || header.columns > std::numeric_limits<unsigned>::max())
+        throw MatrixFileException("File contains invalid matrix dimensions.");
+      if (!IsValidAlignment(header.alignment, alignof(T)) || header.payloadOffset % header.alignment != 0 || header.payloadOffset < sizeof(MatrixFileHeader))
+        throw MatrixFileException("File contains an invalid payload alignment.");
+      if (header.columns > std::numeric_limits<std::uint64_t>::max() / sizeof(T) / header.rows
+        || header.payloadSize != header.rows * header.columns * sizeof(T))
+        throw MatrixFileException("File payload size does not match its dimensions.");
+      // Compared without summing, a crafted offset near the maximum would wrap the sum around
+      if (header.payloadOffset > fileSize || header.payloadSize > fileSize - header.payloadOffset)
+        throw MatrixFileException("File is truncated.");
+    }
+
+    /**
+     * \brief Reads the header of a matrix file
+     * \param path Path to the file
+     * \return File header
+     */
+    static MatrixFileHeader ReadHeader(const std::string & path)
+    {
+      std::ifstream file(path, std::ios::binary);
+      if (!file)
+        throw MatrixFileException("Cannot open file '" + path + "'.");
+
+      MatrixFileHeader header{};
+      if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        throw MatrixFileException("File is not a matrix file.");
+
+      return header;
+    }
+
+    /**
+     * \brief Writes values viewed by given view to a matrix file
+     * \tparam T Type of matrix values
+     * \param view Values to write
+     * \param path Path to the file
+     * \param alignment Alignment of the payload in bytes
+     */
+    template <typename T>
+    static void Save(const MatrixView<T> & view, const std::string & path, const unsigned alignment = 64)
+    {
+      const auto rowBytes = view.GetColumns() * sizeof(T);
+      auto header = CreateHeader<T>(view.GetRows(), view.GetColumns(), alignment);
+      MatrixFileChecksum checksum;
+      for (unsigned row = 0; row < view.GetRows(); ++row)
+        checksum.Update(view.GetRow(row), rowBytes);
+      header.checksum = checksum.GetValue();
+
+      Write(header, path, [&view, rowBytes](std::ofstream & file)
+      {
+        for (unsigned row = 0; row < view.GetRows(); ++row)
+          file.write(reinterpret_cast<const char *>(view.GetRow(row)), rowBytes);
+      });
+    }
+
+    /**
+     * \brief Writes given matrix to a matrix file
+     * \tparam T Type of matrix values
+     * \param matrix Matrix to write
+     * \param path Path to the file
+     * \param alignment Alignment of the payload in bytes
+     */
+    template <typename T>
+    static void Save(const Matrix<T> & matrix, const std::string & path, const unsigned alignment = 64)
+    {
+      const auto & values = matrix.GetMatrixValues();
+      const auto rowBytes = matrix.GetColumns() * sizeof(T);
+      auto header = CreateHeader<T>(matrix.GetRows(), matrix.GetColumns(), alignment);
+      MatrixFileChecksum checksum;
+      for (const auto & row : values)
+        checksum.Update(row.data(), rowBytes);
+      header.checksum = checksum.GetValue();
+
+      Write(header, path, [&values, rowBytes](std::ofstream & file)
+      {
+        for (const auto & row : values)
+          file.write(reinterpret_cast<const char *>(row.data()), rowBytes);
+      });
+    }
+
+    /**
+     * \brief Writes a header, the padding up to the payload and the payload itself
+     * \param header Header to write
+     * \param path Path to the file
+     * \param writePayload Callback writing the payload
+     */
+    template <typename TWriter>
+    static void Write(const MatrixFileHeader & header, const std::string & path, TWriter && writePayload)
+    {
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      if (!file)
+        throw MatrixFileException("Cannot create file '" + path + "'.");
+
+      file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      const std::string padding(header.payloadOffset - sizeof(header), '\0');
+      file.write(padding.data(), padding.size());
+      writePayload(file);
+
+      if (!file.flush())
+        throw MatrixFileException("Failed to write file '" + path + "'.");
+    }
+  };
+
+  /**
+   * \brief Read-only memory mapping of a matrix file. Values are accessed in place without being copied
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class MappedMatrix
+  {
+    /**
+     * \brief Beginning of the mapping
+     */
+    void * m_address = nullptr;
+    /**
+     * \brief Size of the mapping in bytes
+     */
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+    /**
+     * \brief Header of the mapped file
+     */
+    MatrixFileHeader m_header{};
+
+    void Release() noexcept
+    {
+#ifdef _WIN32
+      if (m_address != nullptr) UnmapViewOfFile(m_address);
+      if (m_mapping != nullptr) CloseHandle(m_mapping);
+      if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+      m_mapping = nullptr;
+      m_file = INVALID_HANDLE_VALUE;
+#else
+      if (m_address != nullptr) munmap(m_address, m_size);
+#endif
+      m_address = nullptr;
+      m_size = 0;
+    }
+
+    void Map(const std::string & path)
+    {
+#ifdef _WIN32
+      m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (m_file == INVALID_HANDLE_VALUE)
+        throw MatrixFileException("Cannot open file '" + path + "'.");
+
+      LARGE_INTEGER size;
+      if (!GetFileSizeEx(m_file, &size))
+        throw MatrixFileException("Cannot read size of file '" + path + "'.");
+      m_size = static_cast<std::size_t>(size.QuadPart);
+      if (m_size < sizeof(MatrixFileHeader))
+        throw MatrixFileException("File is not a matrix file.");
+
+      m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (m_mapping == nullptr)
+        throw MatrixFileException("Cannot map file '" + path + "'.");
+      m_address = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+      if (m_address == nullptr)
+        throw MatrixFileException("Cannot map file '" + path + "'.");
+#else
+      const auto descriptor = open(path.c_str(), O_RDONLY);
+      if (descriptor < 0)
+        throw MatrixFileException("Cannot open file '" + path + "'.");
+
+      struct stat status{};
+      if (fstat(descriptor, &status) != 0)
+      {
+        close(descriptor);
+        throw MatrixFileException("Cannot read size of file '" + path + "'.");
+      }
+      if (static_cast<std::size_t>(status.st_size) < sizeof(MatrixFileHeader))
+      {
+        close(descriptor);
+        throw MatrixFileException("File is not a matrix file.");
+      }
+
+      const auto size = static_cast<std::size_t>(status.st_size);
+      const auto address = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+      close(descriptor);
+      if (address == MAP_FAILED)
+        throw MatrixFileException("Cannot map file '" + path + "'.");
+
+      m_address = address;
+      m_size = size;
+#endif
+    }
+
+  public:
+    /**
+     * \brief Default constructor
+     * \param path Path to the matrix file
+     * \param verifyChecksum Whether to verify the payload checksum. Verification reads the whole payload
+     */
+    explicit MappedMatrix(const std::string & path, const bool verifyChecksum = false)
+    {
+      try
+      {
+        Map(path);
+        std::memcpy(&m_header, m_address, sizeof(m_header));
+        MatrixFile::ValidateHeader<T>(m_header, m_size);
+
+        if (verifyChecksum)
+        {
+          MatrixFileChecksum checksum;
+          checksum.Update(GetData(), m_header.payloadSize);
+          if (checksum.GetValue() != m_header.checksum)
+            throw MatrixFileException("Checksum of file '" + path + "' does not match.");
+        }
+      }
+      catch (...)
+      {
+        Release();
+        throw;
+      }
+    }
+    MappedMatrix(const MappedMatrix &) = delete;
+    /**
+     * \brief Move constructor
+     * \param other Mapping to move from
+     */
+    MappedMatrix(MappedMatrix && other) noexcept
+      : m_address(other.m_address),
+      m_size(other.m_size),
+#ifdef _WIN32
+      m_file(other.m_file),
+      m_mapping(other.m_mapping),
+#endif
+      m_header(other.m_header)
+    {
+      other.m_address = nullptr;
+      other.m_size = 0;
+#ifdef _WIN32
+      other.m_file = INVALID_HANDLE_VALUE;
+      other.m_mapping = nullptr;
+#endif
+    }
+
+    ~MappedMatrix() { Release(); }
+
+    MappedMatrix & operator = (const MappedMatrix &) = delete;
+    MappedMatrix & operator = (MappedMatrix && other) noexcept
+    {
+      if (this != &other)
+      {
+        Release();
+        m_address = other.m_address;
+        m_size = other.m_size;
+        m_header = other.m_header;
+        other.m_address = nullptr;
+        other.m_size = 0;
+#ifdef _WIN32
+        m_file = other.m_file;
+        m_mapping = other.m_mapping;
+        other.m_file = INVALID_HANDLE_VALUE;
+        other.m_mapping = nullptr;
+#endif
+      }
+
+      return *this;
+    }
+
+    /**
+     * \brief Getter method for the Header property
+     * \return Header of the mapped file
+     */
+    const MatrixFileHeader & GetHeader() const noexcept { return m_header; }
+    /**
+     * \brief Getter method for the Rows property
+     * \return Rows count
+     */
+    unsigned GetRows() const noexcept { return static_cast<unsigned>(m_header.rows); }
+    /**
+     * \brief Getter method for the Columns property
+     * \return Columns count
+     */
+    unsigned GetColumns() const noexcept { return static_cast<unsigned>(m_header.columns); }
+    /**
+     * \brief Getter method for the Data property
+     * \return Pointer to the first value of the mapped payload
+     */
+    const T * GetData() const noexcept
+    {
+      return reinterpret_cast<const T *>(static_cast<const char *>(m_address) + m_header.payloadOffset);
+    }
+    /**
+     * \brief Creates a zero-copy view over the mapped values. The view is valid while the mapping exists
+     * \return View over the mapped values
+     */
+    MatrixView<T> GetView() const { return MatrixView<T>(GetData(), GetRows(), GetColumns()); }
+    /**
+     * \brief Copies the mapped values into a new matrix
+     * \return Matrix owning a copy of the values
+     */
+    Matrix<T> ToMatrix() const { return GetView().ToMatrix(); }
+  };
+}
@@ -0,0 +1,218 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "NumericTraits.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Textual layout of formatted matrices
+   */
+  struct MatrixFormat
+  {
+    /**
+     * \brief Character separating values of a row
+     */
+    char columnDelimiter = ',';
+    /**
+     * \brief Character separating rows
+     */
+    char rowDelimiter = '\n';
+    /**
+     * \brief Number of digits of floating point values. Negative values select the shortest exact representation
+     */
+    int precision = -1;
+    /**
+     * \brief Notation of floating point values with an explicit precision
+     */
+    std::chars_format notation = std::chars_format::general;
+  };
+
+  /**
+   * \brief Locale independent matrix formatter built on std::to_chars. Storage-only types are formatted through
+   * their accumulator type
+   */
+  class MatrixFormatter
+  {
+  public:
+    /**
+     * \brief Calculates the longest representation of a single value
+     * \tparam T Type of matrix values
+     * \param format Layout of the output
+     * \return Upper bound of characters written per value
+     */
+    template <typename T>
+    static constexpr std::size_t GetMaxValueLength(const MatrixFormat & format) noexcept
+    {
+      if constexpr (IsStorageOnly<T>)
+        return GetMaxValueLength<typename NumericTraits<T>::Accumulator>(format);
+      else if constexpr (std::is_integral<T>::value)
+        return std::numeric_limits<T>::digits10 + 2;
+      else
+      {
+        // Sign, point, exponent and its sign around the significant digits
+        const auto digits = static_cast<std::size_t>(format.precision < 0 ? std::numeric_limits<T>::max_digits10 : format.precision);
+        const auto exponent = static_cast<std::size_t>(std::numeric_limits<T>::max_exponent10);
+        return format.notation == std::chars_format::fixed && format.precision >= 0
+          ? exponent + digits + 4
+          : digits + 10;
+      }
+    }
+
+    /**
+     * \brief Calculates the size of a buffer large enough to hold any matrix of given size
+     * \tparam T Type of matrix values
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param format Layout of the output
+     * \return Upper bound of characters written
+     */
+    template <typename T>
+    static constexpr std::size_t GetMaxLength(const std::size_t rows, const std::size_t columns, const MatrixFormat & format) noexcept
+    {
+      return rows * columns * (GetMaxValueLength<T>(format) + 1);
+    }
+
+    /**
+     * \brief Formats a single value
+     * \param first Beginning of the output buffer
+     * \param last End of the output buffer
+     * \param value Value to format
+     * \param format Layout of the output
+     * \return End of the written characters or null if the buffer is too small
+     */
+    template <typename T>
+    static char * FormatValue(char * first, char * last, const T & value, const MatrixFormat & format) noexcept
+    {
+      if constexpr (IsStorageOnly<T>)
+        return FormatValue(first, last, static_cast<typename NumericTraits<T>::Accumulator>(value), format);
+      else
+      {
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point<T>::value)
+          result = format.precision < 0
+            ? std::to_chars(first, last, value)
+            : std::to_chars(first, last, value, format.notation, format.precision);
+        else
+          result = std::to_chars(first, last, value);
+
+        return result.ec == std::errc() ? result.ptr : nullptr;
+      }
+    }
+
+    /**
+     * \brief Formats matrix values into a caller-provided buffer
+     * \param first Beginning of the output buffer
+     * \param last End of the output buffer
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param getRow Callable returning a pointer to the first value of given row
+     * \param format Layout of the output
+     * \return End of the written characters
+     */
+    template <typename TGetRow>
+    static char * Format(char * first, char * last, const unsigned rows, const unsigned columns, TGetRow && getRow, const MatrixFormat & format)
+    {
+      for (unsigned row = 0; row < rows; ++row)
+      {
+        const auto values = getRow(row);
+        for (unsigned column = 0; column < columns; ++column)
+        {
+          first = FormatValue(first, last, values[column], format);
+          if (column == columns - 1 && row == rows - 1)
+            break;
+          if (first == nullptr || first == last)
+            throw std::length_error("Buffer is too small to hold the formatted matrix.");
+
+          *first++ = column != columns - 1 ? format.columnDelimiter : format.rowDelimiter;
+        }
+      }
+
+      if (first == nullptr)
+        throw std::length_error("Buffer is too small to hold the formatted matrix.");
+
+      return first;
+    }
+
+    /**
+     * \brief Writes matrix values to a stream through an intermediate buffer
+     * \param output Stream to write to
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param getRow Callable returning a pointer to the first value of given row
+     * \param format Layout of the output
+     */
+    template <typename TGetRow>
+    static void Write(std::ostream & output, const unsigned rows, const unsigned columns, TGetRow && getRow, const MatrixFormat & format)
+    {
+      FormatChunks(rows, columns, getRow, format, [&output](const char * data, const std::size_t size) { output.write(data, size); });
+    }
+
+    /**
+     * \brief Formats matrix values into a string, the string grows with the formatted values
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param getRow Callable returning a pointer to the first value of given row
+     * \param format Layout of the output
+     * \return Formatted matrix
+     */
+    template <typename TGetRow>
+    static std::string ToString(const unsigned rows, const unsigned columns, TGetRow && getRow, const MatrixFormat & format)
+    {
+      std::string result;
+      FormatChunks(rows, columns, getRow, format, [&result](const char * data, const std::size_t size) { result.append(data, size); });
+
+      return result;
+    }
+
+  private:
+    /**
+     * \brief Size of the intermediate buffer used when writing to streams and strings
+     */
+    static constexpr std::size_t BufferSize = 64u << 10;
+
+    /**
+     * \brief Formats matrix values into a fixed intermediate buffer and hands over every filled chunk
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param getRow Callable returning a pointer to the first value of given row
+     * \param format Layout of the output
+     * \param flush Callable receiving a pointer to the formatted characters and their count
+     */
+    template <typename TGetRow, typename TFlush>
+    static void FormatChunks(const unsigned rows, const unsigned columns, TGetRow && getRow, const MatrixFormat & format, TFlush && flush)
+    {
+      using T = std::remove_cv_t<std::remove_pointer_t<decltype(getRow(0u))>>;
+      const auto reserve = GetMaxValueLength<T>(format) + 1;
+      char buffer[BufferSize];
+      const auto end = buffer + BufferSize;
+      auto current = buffer;
+
+      for (unsigned row = 0; row < rows; ++row)
+      {
+        const auto values = getRow(row);
+        for (unsigned column = 0; column < columns; ++column)
+        {
+          if (static_cast<std::size_t>(end - current) < reserve)
+          {
+            flush(buffer, static_cast<std::size_t>(current - buffer));
+            current = buffer;
+          }
+
+          current = FormatValue(current, end, values[column], format);
+          if (current == nullptr || current == end)
+            throw std::length_error("Precision is too large to format the matrix.");
+          *current++ = column != columns - 1 ? format.columnDelimiter : format.rowDelimiter;
+        }
+      }
+
+      // The last row is not terminated
+      flush(buffer, static_cast<std::size_t>(current - buffer - (rows != 0 && columns != 0 ? 1 : 0)));
+    }
+  };
+}
@@ -0,0 +1,384 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include "Dispatch.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Element-wise kernels operating on rows of matrix values
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  struct MatrixKernels
+  {
+    /**
+     * \brief output[i] = a[i] + b[i]
+     */
+    void (*add)(const T * a, const T * b, T * output, std::size_t count) noexcept;
+    /**
+     * \brief output[i] = a[i] - b[i]
+     */
+    void (*subtract)(const T * a, const T * b, T * output, std::size_t count) noexcept;
+    /**
+     * \brief output[i] = a[i] * scalar
+     */
+    void (*scale)(const T * a, T scalar, T * output, std::size_t count) noexcept;
+    /**
+     * \brief output[i] += scalar * a[i]
+     */
+    void (*multiplyAdd)(T scalar, const T * a, T * output, std::size_t count) noexcept;
+    /**
+     * \brief output[r][j] += a[r][k] * b[k][j] summed over k in order, for up to MaxTileRows rows of the output.
+     * The tile of the output is kept in registers while the shared dimension is traversed
+     */
+    void (*multiplyAddTile)(const T * const * a, const T * const * b, T * const * output, std::size_t rows, std::size_t depth, std::size_t count) noexcept;
+    /**
+     * \brief Instruction set the kernels were compiled for
+     */
+    InstructionSet instructionSet;
+  };
+
+  namespace Kernels
+  {
+    /**
+     * \brief Largest count of output rows updated together by the tile kernels
+     */
+    constexpr std::size_t MaxTileRows = 8;
+
+    /**
+     * \brief Calls a tile kernel instantiated for given count of rows
+     */
+    template <template <std::size_t> typename TKernel, typename T>
+    void DispatchTileRows(const T * const * a, const T * const * b, T * const * output, const std::size_t rows, const std::size_t depth, const std::size_t count) noexcept
+    {
+      switch (rows)
+      {
+      case 1: return TKernel<1>::Run(a, b, output, depth, count);
+      case 2: return TKernel<2>::Run(a, b, output, depth, count);
+      case 3: return TKernel<3>::Run(a, b, output, depth, count);
+      case 4: return TKernel<4>::Run(a, b, output, depth, count);
+      case 5: return TKernel<5>::Run(a, b, output, depth, count);
+      case 6: return TKernel<6>::Run(a, b, output, depth, count);
+      case 7: return TKernel<7>::Run(a, b, output, depth, count);
+      default: return TKernel<8>::Run(a, b, output, depth, count);
+      }
+    }
+  }
+
+  /**
+   * \brief Defines the kernels as plain loops, vectorized by the compiler for the instruction set of the enclosing target region
+   */
+#define COMMON_MATH_DEFINE_SCALAR_KERNELS \
+  template <typename T> \
+  void Add(const T * a, const T * b, T * output, const std::size_t count) noexcept \
+  { \
+    for (std::size_t i = 0; i < count; ++i) \
+      output[i] = static_cast<T>(a[i] + b[i]); \
+  } \
+  template <typename T> \
+  void Subtract(const T * a, const T * b, T * output, const std::size_t count) noexcept \
+  { \
+    for (std::size_t i = 0; i < count; ++i) \
+      output[i] = static_cast<T>(a[i] - b[i]); \
+  } \
+  template <typename T> \
+  void Scale(const T * a, const T scalar, T * output, const std::size_t count) noexcept \
+  { \
+    for (std::size_t i = 0; i < count; ++i) \
+      output[i] = static_cast<T>(a[i] * scalar); \
+  } \
+  template <typename T> \
+  void MultiplyAdd(const T scalar, const T * a, T * output, const std::size_t count) noexcept \
+  { \
+    for (std::size_t i = 0; i < count; ++i) \
+      output[i] = static_cast<T>(output[i] + scalar * a[i]); \
+  } \
+  /* Tile of Rows output rows. Columns are processed in groups held in local arrays, which the compiler keeps in registers and vectorizes */ \
+  template <std::size_t Rows> \
+  struct MultiplyAddTileRows \
+  { \
+    static constexpr std::size_t Columns = Rows <= 4 ? 8 : 4; \
+    template <typename T> \
+    static void Run(const T * const * a, const T * const * b, T * const * output, const std::size_t depth, const std::size_t count) noexcept \
+    { \
+      std::size_t j = 0; \
+      for (; j + Columns <= count; j += Columns) \
+      { \
+        T sums[Rows][Columns]; \
+        for (std::size_t r = 0; r < Rows; ++r) \
+          for (std::size_t c = 0; c < Columns; ++c) \
+            sums[r][c] = output[r][j + c]; \
+        for (std::size_t k = 0; k < depth; ++k) \
+        { \
+          const auto * right = b[k] + j; \
+          for (std::size_t r = 0; r < Rows; ++r) \
+          { \
+            const auto factor = a[r][k]; \
+            for (std::size_t c = 0; c < Columns; ++c) \
+              sums[r][c] = static_cast<T>(sums[r][c] + factor * right[c]); \
+          } \
+        } \
+        for (std::size_t r = 0; r < Rows; ++r) \
+          for (std::size_t c = 0; c < Columns; ++c) \
+            output[r][j + c] = sums[r][c]; \
+      } \
+      for (; j < count; ++j) \
+        for (std::size_t r = 0; r < Rows; ++r) \
+        { \
+          auto sum = output[r][j]; \
+          for (std::size_t k = 0; k < depth; ++k) \
+            sum = static_cast<T>(sum + a[r][k] * b[k][j]); \
+          output[r][j] = sum; \
+        } \
+    } \
+  }; \
+  template <typename T> \
+  void MultiplyAddTile(const T * const * a, const T * const * b, T * const * output, const std::size_t rows, const std::size_t depth, const std::size_t count) noexcept \
+  { \
+    DispatchTileRows<MultiplyAddTileRows>(a, b, output, rows, depth, count); \
+  }
+
+  namespace Kernels::Scalar
+  {
+    COMMON_MATH_DEFINE_SCALAR_KERNELS
+  }
+
+#ifdef COMMON_MATH_X86
+  /**
+   * \brief Defines the floating point kernels in terms of the vector primitives of the enclosing namespace
+   */
+#define COMMON_MATH_DEFINE_VECTOR_KERNELS \
+  template <typename T> \
+  void Add(const T * a, const T * b, T * output, const std::size_t count) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) Store(output + i, AddVectors(Load(a + i), Load(b + i))); \
+    for (; i < count; ++i) output[i] = a[i] + b[i]; \
+  } \
+  template <typename T> \
+  void Subtract(const T * a, const T * b, T * output, const std::size_t count) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) Store(output + i, SubtractVectors(Load(a + i), Load(b + i))); \
+    for (; i < count; ++i) output[i] = a[i] - b[i]; \
+  } \
+  template <typename T> \
+  void Scale(const T * a, const T scalar, T * output, const std::size_t count) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const auto factor = Broadcast(scalar); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) Store(output + i, MultiplyVectors(Load(a + i), factor)); \
+    for (; i < count; ++i) output[i] = a[i] * scalar; \
+  } \
+  template <typename T> \
+  void MultiplyAdd(const T scalar, const T * a, T * output, const std::size_t count) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const auto factor = Broadcast(scalar); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) Store(output + i, MultiplyAddVectors(factor, Load(a + i), Load(output + i))); \
+    for (; i < count; ++i) output[i] += scalar * a[i]; \
+  } \
+  /* Tile of Rows output rows, each Vectors registers wide. With up to four rows two registers per row are used, */ \
+  /* leaving room for the loaded row of b and the broadcast factor */ \
+  template <std::size_t Rows> \
+  struct MultiplyAddTileRows \
+  { \
+    template <std::size_t Vectors, typename T> \
+    static void RunColumns(const T * const * a, const T * const * b, T * const * output, const std::size_t depth, const std::size_t j) noexcept \
+    { \
+      constexpr std::size_t width = VectorBytes / sizeof(T); \
+      decltype(Load(b[0])) sums[Rows][Vectors]; \
+      for (std::size_t r = 0; r < Rows; ++r) \
+        for (std::size_t v = 0; v < Vectors; ++v) sums[r][v] = Load(output[r] + j + v * width); \
+      for (std::size_t k = 0; k < depth; ++k) \
+      { \
+        decltype(Load(b[0])) right[Vectors]; \
+        for (std::size_t v = 0; v < Vectors; ++v) right[v] = Load(b[k] + j + v * width); \
+        for (std::size_t r = 0; r < Rows; ++r) \
+        { \
+          const auto factor = Broadcast(a[r][k]); \
+          for (std::size_t v = 0; v < Vectors; ++v) sums[r][v] = MultiplyAddVectors(factor, right[v], sums[r][v]); \
+        } \
+      } \
+      for (std::size_t r = 0; r < Rows; ++r) \
+        for (std::size_t v = 0; v < Vectors; ++v) Store(output[r] + j + v * width, sums[r][v]); \
+    } \
+    template <typename T> \
+    static void Run(const T * const * a, const T * const * b, T * const * output, const std::size_t depth, const std::size_t count) noexcept \
+    { \
+      constexpr std::size_t width = VectorBytes / sizeof(T); \
+      constexpr std::size_t vectors = Rows <= 4 ? 2 : 1; \
+      std::size_t j = 0; \
+      for (; j + vectors * width <= count; j += vectors * width) RunColumns<vectors>(a, b, output, depth, j); \
+      for (; j + width <= count; j += width) RunColumns<1>(a, b, output, depth, j); \
+      for (; j < count; ++j) \
+        for (std::size_t r = 0; r < Rows; ++r) \
+        { \
+          auto sum = output[r][j]; \
+          for (std::size_t k = 0; k < depth; ++k) sum += a[r][k] * b[k][j]; \
+          output[r][j] = sum; \
+        } \
+    } \
+  }; \
+  template <typename T> \
+  void MultiplyAddTile(const T * const * a, const T * const * b, T * const * output, const std::size_t rows, const std::size_t depth, const std::size_t count) noexcept \
+  { \
+    DispatchTileRows<MultiplyAddTileRows>(a, b, output, rows, depth, count); \
+  }
+
+  COMMON_MATH_TARGET_BEGIN("sse4.2")
+  namespace Kernels::Sse42
+  {
+    constexpr std::size_t VectorBytes = 16;
+
+    inline __m128 Load(const float * p) noexcept { return _mm_loadu_ps(p); }
+    inline __m128d Load(const double * p) noexcept { return _mm_loadu_pd(p); }
+    inline void Store(float * p, const __m128 v) noexcept { _mm_storeu_ps(p, v); }
+    inline void Store(double * p, const __m128d v) noexcept { _mm_storeu_pd(p, v); }
+    inline __m128 Broadcast(const float v) noexcept { return _mm_set1_ps(v); }
+    inline __m128d Broadcast(const double v) noexcept { return _mm_set1_pd(v); }
+    inline __m128 AddVectors(const __m128 a, const __m128 b) noexcept { return _mm_add_ps(a, b); }
+    inline __m128d AddVectors(const __m128d a, const __m128d b) noexcept { return _mm_add_pd(a, b); }
+    inline __m128 SubtractVectors(const __m128 a, const __m128 b) noexcept { return _mm_sub_ps(a, b); }
+    inline __m128d SubtractVectors(const __m128d a, const __m128d b) noexcept { return _mm_sub_pd(a, b); }
+    inline __m128 MultiplyVectors(const __m128 a, const __m128 b) noexcept { return _mm_mul_ps(a, b); }
+    inline __m128d MultiplyVectors(const __m128d a, const __m128d b) noexcept { return _mm_mul_pd(a, b); }
+    inline __m128 MultiplyAddVectors(const __m128 a, const __m128 b, const __m128 c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    inline __m128d MultiplyAddVectors(const __m128d a, const __m128d b, const __m128d c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+    COMMON_MATH_DEFINE_VECTOR_KERNELS
+
+    /**
+     * \brief Kernels of integer values, which have no vector primitives here
+     */
+    namespace Integer
+    {
+      COMMON_MATH_DEFINE_SCALAR_KERNELS
+    }
+  }
+  COMMON_MATH_TARGET_END
+
+  COMMON_MATH_TARGET_BEGIN("avx2,fma")
+  namespace Kernels::Avx2
+  {
+    constexpr std::size_t VectorBytes = 32;
+
+    inline __m256 Load(const float * p) noexcept { return _mm256_loadu_ps(p); }
+    inline __m256d Load(const double * p) noexcept { return _mm256_loadu_pd(p); }
+    inline void Store(float * p, const __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+    inline void Store(double * p, const __m256d v) noexcept { _mm256_storeu_pd(p, v); }
+    inline __m256 Broadcast(const float v) noexcept { return _mm256_set1_ps(v); }
+    inline __m256d Broadcast(const double v) noexcept { return _mm256_set1_pd(v); }
+    inline __m256 AddVectors(const __m256 a, const __m256 b) noexcept { return _mm256_add_ps(a, b); }
+    inline __m256d AddVectors(const __m256d a, const __m256d b) noexcept { return _mm256_add_pd(a, b); }
+    inline __m256 SubtractVectors(const __m256 a, const __m256 b) noexcept { return _mm256_sub_ps(a, b); }
+    inline __m256d SubtractVectors(const __m256d a, const __m256d b) noexcept { return _mm256_sub_pd(a, b); }
+    inline __m256 MultiplyVectors(const __m256 a, const __m256 b) noexcept { return _mm256_mul_ps(a, b); }
+    inline __m256d MultiplyVectors(const __m256d a, const __m256d b) noexcept { return _mm256_mul_pd(a, b); }
+    inline __m256 MultiplyAddVectors(const __m256 a, const __m256 b, const __m256 c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+    inline __m256d MultiplyAddVectors(const __m256d a, const __m256d b, const __m256d c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+
+    COMMON_MATH_DEFINE_VECTOR_KERNELS
+
+    /**
+     * \brief Kernels of integer values, which have no vector primitives here
+     */
+    namespace Integer
+    {
+      COMMON_MATH_DEFINE_SCALAR_KERNELS
+    }
+  }
+  COMMON_MATH_TARGET_END
+
+  COMMON_MATH_TARGET_BEGIN("avx512f")
+  namespace Kernels::Avx512
+  {
+    constexpr std::size_t VectorBytes = 64;
+
+    inline __m512 Load(const float * p) noexcept { return _mm512_loadu_ps(p); }
+    inline __m512d Load(const double * p) noexcept { return _mm512_loadu_pd(p); }
+    inline void Store(float * p, const __m512 v) noexcept { _mm512_storeu_ps(p, v); }
+    inline void Store(double * p, const __m512d v) noexcept { _mm512_storeu_pd(p, v); }
+    inline __m512 Broadcast(const float v) noexcept { return _mm512_set1_ps(v); }
+    inline __m512d Broadcast(const double v) noexcept { return _mm512_set1_pd(v); }
+    inline __m512 AddVectors(const __m512 a, const __m512 b) noexcept { return _mm512_add_ps(a, b); }
+    inline __m512d AddVectors(const __m512d a, const __m512d b) noexcept { return _mm512_add_pd(a, b); }
+    inline __m512 SubtractVectors(const __m512 a, const __m512 b) noexcept { return _mm512_sub_ps(a, b); }
+    inline __m512d SubtractVectors(const __m512d a, const __m512d b) noexcept { return _mm512_sub_pd(a, b); }
+    inline __m512 MultiplyVectors(const __m512 a, const __m512 b) noexcept { return _mm512_mul_ps(a, b); }
+    inline __m512d MultiplyVectors(const __m512d a, const __m512d b) noexcept { return _mm512_mul_pd(a, b); }
+    inline __m512 MultiplyAddVectors(const __m512 a, const __m512 b, const __m512 c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+    inline __m512d MultiplyAddVectors(const __m512d a, const __m512d b, const __m512d c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+
+    COMMON_MATH_DEFINE_VECTOR_KERNELS
+
+    /**
+     * \brief Kernels of integer values, which have no vector primitives here
+     */
+    namespace Integer
+    {
+      COMMON_MATH_DEFINE_SCALAR_KERNELS
+    }
+  }
+  COMMON_MATH_TARGET_END
+
+#undef COMMON_MATH_DEFINE_VECTOR_KERNELS
+#endif
+#undef COMMON_MATH_DEFINE_SCALAR_KERNELS
+
+  /**
+   * \brief Selects the kernels matching the instruction set chosen by the dispatcher
+   * \tparam T Type of matrix values
+   * \param instructionSet Instruction set to select the kernels for
+   * \return Kernels of the most capable variant not exceeding given instruction set
+   */
+  template <typename T>
+  MatrixKernels<T> SelectMatrixKernels(const InstructionSet instructionSet) noexcept
+  {
+#ifdef COMMON_MATH_X86
+    if constexpr (std::is_same<T, float>::value || std::is_same<T, double>::value)
+      switch (instructionSet)
+      {
+      case InstructionSet::Avx512:
+        return { Kernels::Avx512::Add<T>, Kernels::Avx512::Subtract<T>, Kernels::Avx512::Scale<T>, Kernels::Avx512::MultiplyAdd<T>, Kernels::Avx512::MultiplyAddTile<T>, InstructionSet::Avx512 };
+      case InstructionSet::Avx2:
+        return { Kernels::Avx2::Add<T>, Kernels::Avx2::Subtract<T>, Kernels::Avx2::Scale<T>, Kernels::Avx2::MultiplyAdd<T>, Kernels::Avx2::MultiplyAddTile<T>, InstructionSet::Avx2 };
+      case InstructionSet::Sse42:
+        return { Kernels::Sse42::Add<T>, Kernels::Sse42::Subtract<T>, Kernels::Sse42::Scale<T>, Kernels::Sse42::MultiplyAdd<T>, Kernels::Sse42::MultiplyAddTile<T>, InstructionSet::Sse42 };
+      default:
+        break;
+      }
+    else if constexpr (std::is_integral<T>::value)
+      switch (instructionSet)
+      {
+      case InstructionSet::Avx512:
+        return { Kernels::Avx512::Integer::Add<T>, Kernels::Avx512::Integer::Subtract<T>, Kernels::Avx512::Integer::Scale<T>, Kernels::Avx512::Integer::MultiplyAdd<T>, Kernels::Avx512::Integer::MultiplyAddTile<T>, InstructionSet::Avx512 };
+      case InstructionSet::Avx2:
+        return { Kernels::Avx2::Integer::Add<T>, Kernels::Avx2::Integer::Subtract<T>, Kernels::Avx2::Integer::Scale<T>, Kernels::Avx2::Integer::MultiplyAdd<T>, Kernels::Avx2::Integer::MultiplyAddTile<T>, InstructionSet::Avx2 };
+      case InstructionSet::Sse42:
+        return { Kernels::Sse42::Integer::Add<T>, Kernels::Sse42::Integer::Subtract<T>, Kernels::Sse42::Integer::Scale<T>, Kernels::Sse42::Integer::MultiplyAdd<T>, Kernels::Sse42::Integer::MultiplyAddTile<T>, InstructionSet::Sse42 };
+      default:
+        break;
+      }
+#endif
+    (void)instructionSet;
+    return { Kernels::Scalar::Add<T>, Kernels::Scalar::Subtract<T>, Kernels::Scalar::Scale<T>, Kernels::Scalar::MultiplyAdd<T>, Kernels::Scalar::MultiplyAddTile<T>, InstructionSet::Scalar };
+  }
+
+  /**
+   * \brief Retrieves the kernels selected for the executing processor
+   * \tparam T Type of matrix values
+   * \return Selected kernels
+   */
+  template <typename T>
+  const MatrixKernels<T> & GetMatrixKernels() noexcept
+  {
+    static const auto kernels = SelectMatrixKernels<T>(Dispatch::GetInstructionSet());
+    return kernels;
+  }
+}
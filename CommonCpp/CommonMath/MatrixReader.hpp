@@ -0,0 +1,567 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Matrix.hpp"
+
+namespace Common::Math
+{
+  class MatrixParseException : public std::runtime_error
+  {
+  public:
+    explicit MatrixParseException(const std::string & msg) noexcept : std::runtime_error(msg) {  }
+  };
+
+  /**
+   * \brief Streaming reader building matrices from CSV and Matrix Market input.
+   * Input is consumed in blocks, every block is split on line boundaries and its parts are parsed in parallel
+   * by a pool of threads kept for the whole read
+   */
+  class MatrixReader
+  {
+  public:
+    /**
+     * \brief Size of a single block read from the input
+     */
+    static constexpr std::size_t BlockSize = 16u << 20;
+    /**
+     * \brief Smallest part of a block worth handing to a separate thread
+     */
+    static constexpr std::size_t MinPartSize = 256u << 10;
+
+    /**
+     * \brief Reads a matrix from delimiter separated values. Every line is a row, empty lines are skipped
+     * \tparam T Type of matrix values
+     * \param input Stream to read from
+     * \param delimiter Character separating values of a row
+     * \param threads Number of parsing threads. Zero selects the number of hardware threads
+     * \return Parsed matrix
+     */
+    template <typename T>
+    static Matrix<T> ReadCsv(std::istream & input, const char delimiter = ',', const unsigned threads = 0)
+    {
+      std::vector<std::vector<T>> values;
+      std::size_t columns = 0;
+
+      ReadBlocks(input, threads, [&values, &columns, delimiter](const std::vector<Part> & parts, WorkerPool & pool)
+      {
+        // The first row of the input decides the number of columns
+        if (columns == 0)
+        {
+          const auto line = FindLine(parts.front().first, parts.back().last);
+          if (line.first == line.last)
+            return;
+
+          std::vector<T> row;
+          ParseRow(line.first, line.last, delimiter, row);
+          columns = row.size();
+        }
+
+        std::vector<std::vector<std::vector<T>>> rows(parts.size());
+        pool.ParallelFor(parts.size(), [&](const std::size_t index)
+        {
+          ForEachLine(parts[index].first, parts[index].last, [&](const char * first, const char * last)
+          {
+            std::vector<T> row;
+            row.reserve(columns);
+            ParseRow(first, last, delimiter, row);
+            if (row.size() != columns)
+              throw MatrixParseException("Argument " + NAMEOF(input) + " cannot be jagged.");
+            rows[index].push_back(std::move(row));
+          });
+        });
+
+        for (auto & part : rows)
+          std::move(part.begin(), part.end(), std::back_inserter(values));
+      });
+
+      if (values.empty())
+        throw MatrixParseException("CSV input does not contain any values.");
+
+      return Matrix<T>(std::move(values));
+    }
+
+    /**
+     * \brief Reads a matrix from a delimiter separated values file
+     * \tparam T Type of matrix values
+     * \param path Path to the file
+     * \param delimiter Character separating values of a row
+     * \param threads Number of parsing threads. Zero selects the number of hardware threads
+     * \return Parsed matrix
+     */
+    template <typename T>
+    static Matrix<T> ReadCsv(const std::string & path, const char delimiter = ',', const unsigned threads = 0)
+    {
+      auto file = Open(path);
+      return ReadCsv<T>(file, delimiter, threads);
+    }
+
+    /**
+     * \brief Reads a matrix in the Matrix Market exchange format. Both the array (dense) and the coordinate (sparse)
+     * formats are supported with real, integer and pattern fields and general, symmetric and skew-symmetric symmetries
+     * \tparam T Type of matrix values
+     * \param input Stream to read from
+     * \param threads Number of parsing threads. Zero selects the number of hardware threads
+     * \return Parsed matrix
+     */
+    template <typename T>
+    static Matrix<T> ReadMatrixMarket(std::istream & input, const unsigned threads = 0)
+    {
+      const auto banner = ReadBanner(input);
+      std::string line;
+      do
+      {
+        if (!std::getline(input, line))
+          throw MatrixParseException("Matrix Market input does not contain a size line.");
+      } while (line.empty() || line[0] == '%' || SkipBlanks(line.data(), line.data() + line.size()) == line.data() + line.size());
+
+      std::size_t rows = 0, columns = 0, entries = 0;
+      auto current = ParseValue(line.data(), line.data() + line.size(), rows);
+      current = ParseValue(current, line.data() + line.size(), columns);
+      if (banner.coordinate)
+        current = ParseValue(current, line.data() + line.size(), entries);
+      if (SkipBlanks(current, line.data() + line.size()) != line.data() + line.size() || rows == 0 || columns == 0)
+        throw MatrixParseException("Matrix Market input contains an invalid size line.");
+      if (banner.symmetry != Symmetry::General && rows != columns)
+        throw MatrixParseException("Symmetric Matrix Market matrices must be square.");
+
+      std::vector<std::vector<T>> values(rows, std::vector<T>(columns));
+      std::size_t read = 0;
+
+      if (banner.coordinate)
+        ReadBlocks(input, threads, [&](const std::vector<Part> & parts, WorkerPool & pool)
+        {
+          // Entries of different parts may hit the same cell, hence they are gathered per part and stored in input order
+          std::vector<std::vector<Entry<T>>> parsed(parts.size());
+          pool.ParallelFor(parts.size(), [&](const std::size_t index)
+          {
+            ForEachLine(parts[index].first, parts[index].last, [&](const char * first, const char * last)
+            {
+              std::size_t row, column;
+              T value = 1;
+              auto position = ParseValue(first, last, row);
+              position = ParseValue(position, last, column);
+              if (!banner.pattern)
+                position = ParseValue(position, last, value);
+              if (SkipBlanks(position, last) != last)
+                throw MatrixParseException("Matrix Market entry contains unexpected characters.");
+              if (row == 0 || column == 0 || row > rows || column > columns)
+                throw MatrixParseException("Matrix Market entry lies outside of the matrix.");
+
+              parsed[index].push_back({ row - 1, column - 1, value });
+            });
+          });
+
+          for (const auto & part : parsed)
+          {
+            for (const auto & entry : part)
+            {
+              values[entry.row][entry.column] = entry.value;
+              if (banner.symmetry == Symmetry::Symmetric)
+                values[entry.column][entry.row] = entry.value;
+              else if (banner.symmetry == Symmetry::SkewSymmetric)
+                values[entry.column][entry.row] = static_cast<T>(-entry.value);
+            }
+            read += part.size();
+          }
+        });
+      else
+      {
+        entries = banner.symmetry == Symmetry::General ? rows * columns
+          : banner.symmetry == Symmetry::Symmetric ? rows * (rows + 1) / 2
+          : rows * (rows - 1) / 2;
+
+        ReadBlocks(input, threads, [&](const std::vector<Part> & parts, WorkerPool & pool)
+        {
+          // Entries are stored column by column, hence every part needs to know the index of its first entry
+          std::vector<std::size_t> offsets(parts.size() + 1);
+          pool.ParallelFor(parts.size(), [&](const std::size_t index)
+          {
+            ForEachLine(parts[index].first, parts[index].last, [&](const char *, const char *) { ++offsets[index + 1]; });
+          });
+          offsets[0] = read;
+          for (std::size_t i = 1; i < offsets.size(); ++i)
+            offsets[i] += offsets[i - 1];
+          if (offsets.back() > entries)
+            throw MatrixParseException("Matrix Market input contains more entries than expected.");
+
+          pool.ParallelFor(parts.size(), [&](const std::size_t index)
+          {
+            auto [row, column] = GetArrayPosition(offsets[index], rows, banner.symmetry);
+            ForEachLine(parts[index].first, parts[index].last, [&](const char * first, const char * last)
+            {
+              T value;
+              if (SkipBlanks(ParseValue(first, last, value), last) != last)
+                throw MatrixParseException("Matrix Market entry contains unexpected characters.");
+
+              values[row][column] = value;
+              if (banner.symmetry == Symmetry::Symmetric)
+                values[column][row] = value;
+              else if (banner.symmetry == Symmetry::SkewSymmetric)
+                values[column][row] = static_cast<T>(-value);
+
+              if (++row == rows)
+              {
+                ++column;
+                row = banner.symmetry == Symmetry::General ? 0 : banner.symmetry == Symmetry::Symmetric ? column : column + 1;
+              }
+            });
+          });
+
+          read = offsets.back();
+        });
+      }
+
+      if (read != entries)
+        throw MatrixParseException("Matrix Market input contains " + std::to_string(read) + " entries, expected " + std::to_string(entries) + ".");
+
+      return Matrix<T>(std::move(values));
+    }
+
+    /**
+     * \brief Reads a matrix from a Matrix Market file
+     * \tparam T Type of matrix values
+     * \param path Path to the file
+     * \param threads Number of parsing threads. Zero selects the number of hardware threads
+     * \return Parsed matrix
+     */
+    template <typename T>
+    static Matrix<T> ReadMatrixMarket(const std::string & path, const unsigned threads = 0)
+    {
+      auto file = Open(path);
+      return ReadMatrixMarket<T>(file, threads);
+    }
+
+  private:
+    enum class Symmetry
+    {
+      General,
+      Symmetric,
+      SkewSymmetric
+    };
+
+    struct Banner
+    {
+      bool coordinate;
+      bool pattern;
+      Symmetry symmetry;
+    };
+
+    /**
+     * \brief Range of complete lines parsed by a single thread
+     */
+    struct Part
+    {
+      const char * first;
+      const char * last;
+    };
+
+    /**
+     * \brief Coordinate entry parsed by a single thread, stored into the matrix afterwards
+     */
+    template <typename T>
+    struct Entry
+    {
+      std::size_t row;
+      std::size_t column;
+      T value;
+    };
+
+    /**
+     * \brief Threads parsing the parts of every block of a single read. The calling thread takes parts as well,
+     * further threads are started once a block is split into more parts than there are threads
+     */
+    class WorkerPool
+    {
+      std::mutex m_mutex;
+      std::condition_variable m_changed;
+      const std::function<void(std::size_t)> * m_action = nullptr;
+      std::vector<std::exception_ptr> m_errors;
+      std::size_t m_count = 0;
+      std::size_t m_next = 0;
+      std::size_t m_pending = 0;
+      bool m_stopped = false;
+      std::vector<std::thread> m_threads;
+
+      /**
+       * \brief Runs parts of the current batch until there are none left
+       * \param lock Lock of the pool mutex, held on entry and on return
+       */
+      void RunParts(std::unique_lock<std::mutex> & lock)
+      {
+        while (m_next < m_count)
+        {
+          const auto index = m_next++;
+          const auto & action = *m_action;
+          lock.unlock();
+          try { action(index); }
+          catch (...) { m_errors[index] = std::current_exception(); }
+          lock.lock();
+
+          if (--m_pending == 0)
+            m_changed.notify_all();
+        }
+      }
+
+      void Work()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+          m_changed.wait(lock, [this] { return m_next < m_count || m_stopped; });
+          if (m_stopped)
+            return;
+
+          RunParts(lock);
+        }
+      }
+
+    public:
+      WorkerPool() = default;
+      WorkerPool(const WorkerPool &) = delete;
+      WorkerPool & operator =(const WorkerPool &) = delete;
+
+      ~WorkerPool()
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_stopped = true;
+        }
+        m_changed.notify_all();
+        for (auto & thread : m_threads)
+          thread.join();
+      }
+
+      /**
+       * \brief Calls given action for every index on the pool threads and waits for all of them to finish
+       * \param count Number of indices
+       * \param action Called with every index from zero to given count
+       */
+      template <typename TAction>
+      void ParallelFor(const std::size_t count, TAction && action)
+      {
+        if (count == 1)
+        {
+          action(0);
+          return;
+        }
+
+        const std::function<void(std::size_t)> run(std::ref(action));
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_threads.size() + 1 < count)
+          m_threads.emplace_back(&WorkerPool::Work, this);
+
+        m_action = &run;
+        m_errors.assign(count, nullptr);
+        m_count = count;
+        m_next = 0;
+        m_pending = count;
+        m_changed.notify_all();
+
+        RunParts(lock);
+        m_changed.wait(lock, [this] { return m_pending == 0; });
+        m_action = nullptr;
+        m_count = 0;
+        m_next = 0;
+
+        for (const auto & error : m_errors)
+          if (error) std::rethrow_exception(error);
+      }
+    };
+
+    static std::ifstream Open(const std::string & path)
+    {
+      std::ifstream file(path, std::ios::binary);
+      if (!file)
+        throw MatrixParseException("Cannot open file '" + path + "'.");
+
+      return file;
+    }
+
+    static const char * SkipBlanks(const char * first, const char * last) noexcept
+    {
+      while (first != last && (*first == ' ' || *first == '\t' || *first == '\r'))
+        ++first;
+
+      return first;
+    }
+
+    template <typename T>
+    static const char * ParseValue(const char * first, const char * last, T & value)
+    {
+      first = SkipBlanks(first, last);
+      if (first != last && *first == '+')
+        ++first;
+
+      const auto [end, error] = std::from_chars(first, last, value);
+      if (error != std::errc())
+        throw MatrixParseException("Invalid value '" + std::string(first, std::find_if(first, last, [](const char c) { return c == ' ' || c == '\t' || c == ','; })) + "'.");
+
+      return end;
+    }
+
+    template <typename T>
+    static void ParseRow(const char * first, const char * last, const char delimiter, std::vector<T> & row)
+    {
+      const auto blankDelimiter = delimiter == ' ' || delimiter == '\t';
+      for (;;)
+      {
+        T value;
+        first = SkipBlanks(ParseValue(first, last, value), last);
+        row.push_back(value);
+        if (first == last) break;
+        if (*first == delimiter)
+          ++first;
+        else if (!blankDelimiter)
+          throw MatrixParseException("Unexpected character '" + std::string(1, *first) + "' in CSV input.");
+      }
+    }
+
+    template <typename TAction>
+    static void ForEachLine(const char * first, const char * last, TAction && action)
+    {
+      while (first != last)
+      {
+        auto end = static_cast<const char *>(std::memchr(first, '\n', last - first));
+        if (end == nullptr) end = last;
+        if (SkipBlanks(first, end) != end)
+          action(first, end);
+        first = end == last ? last : end + 1;
+      }
+    }
+
+    /**
+     * \brief Finds the first line containing more than blanks
+     * \return The line, empty when there is none
+     */
+    static Part FindLine(const char * first, const char * last) noexcept
+    {
+      while (first != last)
+      {
+        auto end = static_cast<const char *>(std::memchr(first, '\n', last - first));
+        if (end == nullptr) end = last;
+        if (SkipBlanks(first, end) != end)
+          return { first, end };
+        first = end == last ? last : end + 1;
+      }
+
+      return { last, last };
+    }
+
+    /**
+     * \brief Reads the input block by block and hands complete lines of every block, split into parts, to given callback
+     * together with the worker pool parsing them
+     */
+    template <typename TConsumer>
+    static void ReadBlocks(std::istream & input, const unsigned threads, TConsumer && consume)
+    {
+      const auto workers = std::max(1u, threads != 0 ? threads : std::thread::hardware_concurrency());
+      std::vector<char> buffer;
+      std::size_t carry = 0;
+      WorkerPool pool;
+
+      for (;;)
+      {
+        buffer.resize(carry + BlockSize);
+        input.read(buffer.data() + carry, BlockSize);
+        const auto size = carry + static_cast<std::size_t>(input.gcount());
+        const auto finished = !input;
+        if (size == 0) break;
+
+        const auto begin = buffer.data();
+        auto end = begin + size;
+        if (!finished)
+        {
+          // Keep the incomplete trailing line for the next block
+          while (end != begin && end[-1] != '\n') --end;
+          if (end == begin)
+          {
+            carry = size;
+            continue;
+          }
+        }
+
+        const auto count = std::max<std::size_t>(1, std::min<std::size_t>(workers, (end - begin) / MinPartSize));
+        std::vector<Part> parts;
+        parts.reserve(count);
+        auto first = begin;
+        for (std::size_t i = 1; i < count && first != end; ++i)
+        {
+          auto last = std::min(end, first + (end - begin) / count);
+          last = std::find(last, end, '\n');
+          if (last != end) ++last;
+          parts.push_back({ first, last });
+          first = last;
+        }
+        if (first != end || parts.empty())
+          parts.push_back({ first, end });
+
+        consume(parts, pool);
+
+        if (finished) break;
+        carry = static_cast<std::size_t>(begin + size - end);
+        std::memmove(begin, end, carry);
+      }
+    }
+
+    static Banner ReadBanner(std::istream & input)
+    {
+      std::string line;
+      if (!std::getline(input, line))
+        throw MatrixParseException("Matrix Market input is empty.");
+
+      std::transform(line.begin(), line.end(), line.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+      std::istringstream words(line);
+      std::string marker, object, format, field, symmetry;
+      words >> marker >> object >> format >> field >> symmetry;
+
+      if (marker != "%%matrixmarket" || object != "matrix")
+        throw MatrixParseException("Input is not a Matrix Market matrix.");
+      if (format != "coordinate" && format != "array")
+        throw MatrixParseException("Unsupported Matrix Market format '" + format + "'.");
+      if (field != "real" && field != "double" && field != "integer" && field != "pattern")
+        throw MatrixParseException("Unsupported Matrix Market field '" + field + "'.");
+      if (field == "pattern" && format == "array")
+        throw MatrixParseException("Matrix Market pattern field requires the coordinate format.");
+
+      Banner banner{ format == "coordinate", field == "pattern", Symmetry::General };
+      if (symmetry == "symmetric")
+        banner.symmetry = Symmetry::Symmetric;
+      else if (symmetry == "skew-symmetric")
+        banner.symmetry = Symmetry::SkewSymmetric;
+      else if (symmetry != "general")
+        throw MatrixParseException("Unsupported Matrix Market symmetry '" + symmetry + "'.");
+
+      return banner;
+    }
+
+    /**
+     * \brief Converts the index of an entry of an array matrix to its position
+     * \return Row and column of the entry
+     */
+    static std::pair<std::size_t, std::size_t> GetArrayPosition(std::size_t index, const std::size_t rows, const Symmetry symmetry) noexcept
+    {
+      if (symmetry == Symmetry::General)
+        return { index % rows, index / rows };
+
+      // Only the lower triangle is stored, column by column
+      std::size_t column = 0;
+      for (auto length = symmetry == Symmetry::Symmetric ? rows : rows - 1; length != 0 && index >= length; --length, ++column)
+        index -= length;
+
+      return { index + column + (symmetry == Symmetry::Symmetric ? 0 : 1), column };
+    }
+  };
+}
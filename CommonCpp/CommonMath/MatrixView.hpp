@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "Matrix.hpp"
+#include "MatrixFormat.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Read-only, non-owning view over row-major matrix values stored in a contiguous block of memory
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class MatrixView
+  {
+    /**
+     * \brief First value of the first row
+     */
+    const T * m_data;
+    /**
+     * \brief Number of rows
+     */
+    unsigned m_rows;
+    /**
+     * \brief Number of columns
+     */
+    unsigned m_columns;
+    /**
+     * \brief Distance, in elements, between the beginnings of two consecutive rows
+     */
+    std::size_t m_stride;
+
+  public:
+    /**
+     * \brief Default constructor
+     * \param data Pointer to the first value of the first row
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param stride Distance, in elements, between two consecutive rows
+     */
+    MatrixView(const T * data, const unsigned rows, const unsigned columns, const std::size_t stride)
+      : m_data(data), m_rows(rows), m_columns(columns), m_stride(stride)
+    {
+      if (data == nullptr) throw std::invalid_argument("Argument " + NAMEOF(data) + " cannot be null.");
+      if (rows == 0 || columns == 0) throw std::invalid_argument("Size must be greater than 0.");
+      if (stride < columns) throw std::invalid_argument("Argument " + NAMEOF(stride) + " cannot be less than argument " + NAMEOF(columns) + ".");
+    }
+    /**
+     * \brief Constructs a view over densely packed rows
+     * \param data Pointer to the first value of the first row
+     * \param rows Number of rows
+     * \param columns Number of columns
+     */
+    MatrixView(const T * data, const unsigned rows, const unsigned columns)
+      : MatrixView(data, rows, columns, columns) { }
+
+    /**
+     * \brief Getter method for the Rows property
+     * \return Rows count
+     */
+    unsigned GetRows() const noexcept { return m_rows; }
+    /**
+     * \brief Getter method for the Columns property
+     * \return Columns count
+     */
+    unsigned GetColumns() const noexcept { return m_columns; }
+    /**
+     * \brief Getter method for the Stride property
+     * \return Distance, in elements, between two consecutive rows
+     */
+    std::size_t GetStride() const noexcept { return m_stride; }
+    /**
+     * \brief Getter method for the Data property
+     * \return Pointer to the first value of the first row
+     */
+    const T * GetData() const noexcept { return m_data; }
+    /**
+     * \brief Retrieves a row of the view
+     * \param row Index of the row
+     * \return Pointer to the first value of the row
+     */
+    const T * GetRow(const unsigned row) const noexcept { return m_data + row * m_stride; }
+
+    /**
+     * \brief Retrieves a single value of the view
+     * \param row Index of the row
+     * \param column Index of the column
+     * \return Value at given position
+     */
+    const T & operator ()(const unsigned row, const unsigned column) const noexcept { return m_data[row * m_stride + column]; }
+
+    /**
+     * \brief Formats the viewed values into a string
+     * \param format Layout of the output
+     * \return Formatted values
+     */
+    std::string ToString(const MatrixFormat & format = MatrixFormat()) const
+    {
+      return MatrixFormatter::ToString(m_rows, m_columns, [this](const unsigned row) { return GetRow(row); }, format);
+    }
+    /**
+     * \brief Writes the formatted values to a stream
+     * \param output Stream to write to
+     * \param format Layout of the output
+     */
+    void Write(std::ostream & output, const MatrixFormat & format = MatrixFormat()) const
+    {
+      MatrixFormatter::Write(output, m_rows, m_columns, [this](const unsigned row) { return GetRow(row); }, format);
+    }
+
+    /**
+     * \brief Copies the viewed values into a new matrix
+     * \return Matrix owning a copy of the values
+     */
+    Matrix<T> ToMatrix() const
+    {
+      std::vector<std::vector<T>> values(m_rows);
+      for (unsigned row = 0; row < m_rows; ++row)
+        values[row].assign(GetRow(row), GetRow(row) + m_columns);
+
+      return Matrix<T>(std::move(values));
+    }
+  };
+}
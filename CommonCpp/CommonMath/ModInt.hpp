@@ -0,0 +1,310 @@
+#pragma once
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "FastDivisor.hpp"
+#include "WideArithmetic.hpp"
+
+#define NAMEOF(x) std::string(#x)
+
+namespace Common::Math
+{
+  /**
+   * \brief Odd modulus with the constants of Montgomery multiplication. A value a is represented by a * R mod n
+   * with R = 2^bits, products are reduced by multiplications and a shift instead of a division
+   * \tparam T Type of values, 32-bit or 64-bit unsigned integer
+   */
+  template <typename T, typename = std::enable_if_t<std::is_unsigned<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>>
+  class MontgomeryModulus
+  {
+    /**
+     * \brief Modulus n
+     */
+    T m_modulus;
+    /**
+     * \brief Inverse of the modulus modulo R
+     */
+    T m_inverse;
+    /**
+     * \brief R mod n, the Montgomery form of one
+     */
+    T m_one;
+    /**
+     * \brief R^2 mod n, converts values into the Montgomery form
+     */
+    T m_square;
+
+    static T ValidateModulus(const T modulus)
+    {
+      if (modulus < 3 || modulus % 2 == 0)
+        throw std::invalid_argument("Argument " + NAMEOF(modulus) + " must be odd and greater than 1.");
+
+      return modulus;
+    }
+
+    static T CalcInverse(const T modulus) noexcept
+    {
+      // Odd values are their own inverses modulo 8, every Newton step doubles the number of correct bits
+      auto inverse = modulus;
+      for (std::size_t bits = 3; bits < sizeof(T) * 8; bits *= 2)
+        inverse = static_cast<T>(inverse * static_cast<T>(2 - modulus * inverse));
+
+      return inverse;
+    }
+
+    /**
+     * \brief Reduces a double width value high * R + low less than n * R to (high * R + low) / R mod n
+     */
+    T Reduce(const T high, const T low) const noexcept
+    {
+      // m * n equals the low half modulo R, the low halves cancel and the difference of the high halves remains
+      const auto correction = WideArithmetic::MultiplyHigh(static_cast<T>(low * m_inverse), m_modulus);
+      return high >= correction ? static_cast<T>(high - correction) : static_cast<T>(high - correction + m_modulus);
+    }
+
+  public:
+    /**
+     * \brief Precomputes the constants of a modulus
+     * \param modulus Odd modulus greater than 1
+     */
+    explicit MontgomeryModulus(const T modulus)
+      : m_modulus(ValidateModulus(modulus)),
+      m_inverse(CalcInverse(modulus)),
+      m_one(static_cast<T>(static_cast<T>(0 - modulus) % modulus)),
+      m_square(FastDivisor<T>(modulus).MultiplyModulo(m_one, m_one)) { }
+
+    /**
+     * \brief Getter for the Modulus property
+     * \return Modulus
+     */
+    T GetModulus() const noexcept { return m_modulus; }
+    /**
+     * \brief Getter for the One property
+     * \return Montgomery form of one
+     */
+    T GetOne() const noexcept { return m_one; }
+
+    /**
+     * \brief Converts a value into the Montgomery form
+     * \param value Any value, it is reduced modulo n
+     * \return Value in the Montgomery form
+     */
+    T ToMontgomery(const T value) const noexcept { return Multiply(value, m_square); }
+    /**
+     * \brief Converts a value from the Montgomery form
+     * \param value Value in the Montgomery form
+     * \return Value less than n
+     */
+    T FromMontgomery(const T value) const noexcept { return Reduce(0, value); }
+
+    /**
+     * \brief Multiplies values in the Montgomery form, the result stays in the Montgomery form
+     * \param left Value less than n
+     * \param right Value less than n, any value if left is R^2 mod n
+     * \return Product less than n
+     */
+    T Multiply(const T left, const T right) const noexcept
+    {
+      return Reduce(WideArithmetic::MultiplyHigh(left, right), static_cast<T>(left * right));
+    }
+    /**
+     * \brief Adds values less than n without overflowing
+     */
+    T Add(const T left, const T right) const noexcept
+    {
+      const auto space = static_cast<T>(m_modulus - left);
+      return right >= space ? static_cast<T>(right - space) : static_cast<T>(left + right);
+    }
+    /**
+     * \brief Subtracts values less than n without overflowing
+     */
+    T Subtract(const T left, const T right) const noexcept
+    {
+      return left >= right ? static_cast<T>(left - right) : static_cast<T>(left + static_cast<T>(m_modulus - right));
+    }
+
+    /**
+     * \brief Converts an array of values into the Montgomery form
+     * \param values Values to convert
+     * \param output Converted values, may be equal to values
+     * \param count Number of values
+     */
+    void ToMontgomeryRange(const T * values, T * output, const std::size_t count) const noexcept
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        output[i] = ToMontgomery(values[i]);
+    }
+    /**
+     * \brief Converts an array of values from the Montgomery form
+     * \param values Values to convert
+     * \param output Converted values, may be equal to values
+     * \param count Number of values
+     */
+    void FromMontgomeryRange(const T * values, T * output, const std::size_t count) const noexcept
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        output[i] = FromMontgomery(values[i]);
+    }
+
+    bool operator ==(const MontgomeryModulus & other) const noexcept { return m_modulus == other.m_modulus; }
+    bool operator !=(const MontgomeryModulus & other) const noexcept { return m_modulus != other.m_modulus; }
+  };
+
+  /**
+   * \brief Integer modulo an odd number kept in the range [0, n - 1] like NumberInRange. The value is stored
+   * in the Montgomery form, chains of multiplications never divide
+   * \tparam T Type of value, 32-bit or 64-bit unsigned integer
+   */
+  template <typename T, typename = std::enable_if_t<std::is_unsigned<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>>
+  class ModInt
+  {
+    /**
+     * \brief Modulus with its precomputed constants
+     */
+    MontgomeryModulus<T> m_modulus;
+    /**
+     * \brief Value in the Montgomery form
+     */
+    T m_value;
+
+    ModInt(const MontgomeryModulus<T> & modulus, const T montgomery, std::nullptr_t) noexcept
+      : m_modulus(modulus), m_value(montgomery) { }
+
+    void ValidateModulus(const ModInt & other) const
+    {
+      if (m_modulus != other.m_modulus)
+        throw std::invalid_argument("Argument " + NAMEOF(other) + " must have the same modulus.");
+    }
+
+  public:
+    /**
+     * \brief Constructs the value reduced modulo a modulus
+     * \param value Value to hold
+     * \param modulus Odd modulus greater than 1
+     */
+    ModInt(const T value, const T modulus)
+      : ModInt(value, MontgomeryModulus<T>(modulus)) { }
+    /**
+     * \brief Constructs the value reduced modulo a modulus with precomputed constants, no division is performed
+     * \param value Value to hold
+     * \param modulus Modulus
+     */
+    ModInt(const T value, const MontgomeryModulus<T> & modulus) noexcept
+      : m_modulus(modulus), m_value(modulus.ToMontgomery(value)) { }
+
+    /**
+     * \brief Getter for the Min property
+     * \return Range Minimum
+     */
+    static constexpr T GetMin() noexcept { return 0; }
+    /**
+     * \brief Getter for the Max property
+     * \return Range Maximum
+     */
+    T GetMax() const noexcept { return m_modulus.GetModulus() - 1; }
+    /**
+     * \brief Getter for the Modulus property
+     * \return Modulus with its precomputed constants
+     */
+    const MontgomeryModulus<T> & GetModulus() const noexcept { return m_modulus; }
+
+    /**
+     * \brief Getter for the Value property
+     * \return Value less than the modulus
+     */
+    T GetValue() const noexcept { return m_modulus.FromMontgomery(m_value); }
+    /**
+     * \brief Setter for the Value property
+     * \param value New value to set, it is reduced modulo the modulus
+     */
+    void SetValue(const T value) noexcept { m_value = m_modulus.ToMontgomery(value); }
+
+    /**
+     * \brief Raises the value to a power by repeated squaring
+     * \param exponent Exponent
+     * \return Value to the power of the exponent
+     */
+    ModInt Pow(T exponent) const noexcept
+    {
+      auto result = m_modulus.GetOne();
+      for (auto base = m_value; exponent != 0; exponent >>= 1)
+      {
+        if (exponent & 1u)
+          result = m_modulus.Multiply(result, base);
+        base = m_modulus.Multiply(base, base);
+      }
+
+      return ModInt(m_modulus, result, nullptr);
+    }
+
+    /**
+     * \brief Calculates the multiplicative inverse by the extended Euclidean algorithm
+     * \return Value whose product with this value is one
+     */
+    ModInt GetInverse() const
+    {
+      // Bezout coefficients alternate in sign, only their magnitudes are kept and never exceed the modulus
+      const auto modulus = m_modulus.GetModulus();
+      T a = GetValue(), b = modulus, coefficient = 1, next = 0;
+      bool negative = false;
+      while (b != 0)
+      {
+        const auto quotient = static_cast<T>(a / b);
+        a = static_cast<T>(a - quotient * b);
+        std::swap(a, b);
+        coefficient = static_cast<T>(coefficient + quotient * next);
+        std::swap(coefficient, next);
+        negative = !negative;
+      }
+
+      if (a != 1)
+        throw std::domain_error("Value has no inverse modulo " + std::to_string(modulus) + ".");
+
+      return ModInt(negative ? static_cast<T>(modulus - coefficient) : coefficient, m_modulus);
+    }
+
+    ModInt operator +(const T other) const noexcept { return ModInt(m_modulus, m_modulus.Add(m_value, m_modulus.ToMontgomery(other)), nullptr); }
+    ModInt operator +(const ModInt & other) const
+    {
+      ValidateModulus(other);
+      return ModInt(m_modulus, m_modulus.Add(m_value, other.m_value), nullptr);
+    }
+
+    ModInt operator -(const T other) const noexcept { return ModInt(m_modulus, m_modulus.Subtract(m_value, m_modulus.ToMontgomery(other)), nullptr); }
+    ModInt operator -(const ModInt & other) const
+    {
+      ValidateModulus(other);
+      return ModInt(m_modulus, m_modulus.Subtract(m_value, other.m_value), nullptr);
+    }
+
+    ModInt operator *(const T other) const noexcept { return ModInt(m_modulus, m_modulus.Multiply(m_value, m_modulus.ToMontgomery(other)), nullptr); }
+    ModInt operator *(const ModInt & other) const
+    {
+      ValidateModulus(other);
+      return ModInt(m_modulus, m_modulus.Multiply(m_value, other.m_value), nullptr);
+    }
+
+    ModInt operator /(const ModInt & other) const { return *this * other.GetInverse(); }
+
+    ModInt & operator +=(const ModInt & other) { return *this = *this + other; }
+    ModInt & operator -=(const ModInt & other) { return *this = *this - other; }
+    ModInt & operator *=(const ModInt & other) { return *this = *this * other; }
+    ModInt & operator /=(const ModInt & other) { return *this = *this / other; }
+
+    /**
+     * \brief Values are equal if they are congruent modulo the same modulus
+     */
+    bool operator ==(const ModInt & other) const noexcept { return m_modulus == other.m_modulus && m_value == other.m_value; }
+    bool operator !=(const ModInt & other) const noexcept { return !(*this == other); }
+
+    std::string ToString() const
+    {
+      std::ostringstream oss;
+      oss << GetValue();
+      return oss.str();
+    }
+  };
+}
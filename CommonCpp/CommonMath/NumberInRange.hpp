@@ -1,19 +1,37 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <type_traits>
 #include <stdexcept>
 #include <sstream>
+#include "FastDivisor.hpp"
+#include "RangeKernels.hpp"
+#include "RangePolicies.hpp"
+#include "WideArithmetic.hpp"
 
 #define NAMEOF(x) std::string(#x)
 
 namespace Common::Math
 {
   /**
-   * \brief Keeps an integer value in a given range
+   * \brief Keeps an integer value in a given range. The reciprocal of the range length is precomputed on construction,
+   * values are wrapped by a multiplication instead of a division
    * \tparam T Type of value. Anything but integer types are prohibited.
+   * \tparam TPolicy Policy bringing values outside of the range back, one of RangePolicy
    */
-  template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value && std::numeric_limits<T>::is_integer>>
-  class NumberInRange
+  template <typename T, typename TPolicy = RangePolicy::Wrap, typename = std::enable_if_t<std::is_arithmetic<T>::value && std::numeric_limits<T>::is_integer>>
+  class NumberInRange : public TPolicy
   {
+    /**
+     * \brief Type of offsets from the minimum, unsigned arithmetic wraps instead of overflowing
+     */
+    using Offset = std::make_unsigned_t<T>;
+    /**
+     * \brief Unsigned type of at least int size, products of narrower offsets would be promoted to signed int
+     */
+    using Product = std::common_type_t<Offset, unsigned>;
+
     /**
      * \brief Range minimum
     */
@@ -23,28 +41,171 @@ namespace Common::Math
     */
     const  T m_max;
     /**
-    * \brief Distance between the Minimum and Maximum
+    * \brief Number of values in the range, zero if the range covers every value of T
     */
-    const T m_rangeLen;
+    const Offset m_rangeLen;
+    /**
+     * \brief Period of the offsets of modular policies, equals the range length unless values are reflected
+     */
+    const Offset m_period;
+    /**
+     * \brief Period with its precomputed reciprocal
+     */
+    const FastDivisor<Offset> m_divisor;
+    /**
+     * \brief Residue of the minimum modulo the period, the offset of a sum is shifted by it
+     */
+    const Offset m_minResidue;
+    /**
+     * \brief True if the product of any two values in range fits into T
+     */
+    const bool m_productFits;
+    /**
+     * \brief Last value of the period, the maximum of T if the period reaches past it
+     */
+    const T m_periodMax;
 
     /**
      * \brief Value in range
     */
     T m_value;
 
-    static T Abs(const T & value)
+    static const T & ValidateRange(const T & min, const T & max)
     {
-      if (value >= 0)
-        return value;
-      return value * -1;
+      if (min == max) throw std::invalid_argument("Argument " + NAMEOF(min) + " cannot be equal to argument " + NAMEOF(max) + ".");
+      if (min > max) throw std::invalid_argument("Argument " + NAMEOF(min) + " cannot be greater than argument " + NAMEOF(max) + ".");
+
+      return min;
+    }
+
+    static constexpr Offset CalcRangeLen(const T & min, const T & max) noexcept
+    {
+      return static_cast<Offset>(static_cast<Offset>(static_cast<Offset>(max) - static_cast<Offset>(min)) + 1u);
+    }
+
+    static Offset CalcPeriod(const T & min, const T & max)
+    {
+      const auto length = CalcRangeLen(min, max);
+      if (!TPolicy::IsValidLength(length))
+        throw std::invalid_argument("Argument " + NAMEOF(max) + " is too far from argument " + NAMEOF(min) + " for the range policy.");
+
+      return TPolicy::CalcPeriod(length);
     }
 
-    static T CalcRangeLen(const T & min, const T & max)
+    T CalcPeriodMax() const noexcept
     {
-      const T a = Abs(min);
-      const T b = Abs(max);
+      const auto space = static_cast<Offset>(static_cast<Offset>(std::numeric_limits<T>::max()) - static_cast<Offset>(m_min));
+      return m_period == 0 || static_cast<Offset>(m_period - 1u) >= space ? std::numeric_limits<T>::max() : FromOffset(static_cast<Offset>(m_period - 1u));
+    }
 
-      return (a > b ? a - b : b - a) + 1;
+    Offset CalcMinResidue() const noexcept
+    {
+      // A range covering every value wraps modulo 2^N, the residue is the minimum itself
+      if (m_period == 0)
+        return static_cast<Offset>(m_min);
+      if (m_min >= 0)
+        return m_divisor.Remainder(static_cast<Offset>(m_min));
+
+      const auto remainder = m_divisor.Remainder(static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(m_min)));
+      return remainder == 0 ? Offset(0) : static_cast<Offset>(m_period - remainder);
+    }
+
+    static bool CalcProductFits(const T & min, const T & max) noexcept
+    {
+      const auto magnitude = [](const T & value) { return value < 0 ? static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(value)) : static_cast<Offset>(value); };
+      const auto bound = std::max(magnitude(min), magnitude(max));
+      return bound == 0 || bound <= static_cast<Offset>(std::numeric_limits<T>::max()) / bound;
+    }
+
+    T FromOffset(const Offset offset) const noexcept
+    {
+      return static_cast<T>(static_cast<Offset>(static_cast<Offset>(m_min) + offset));
+    }
+    Offset GetOffset(const T value) const noexcept
+    {
+      return static_cast<Offset>(static_cast<Offset>(value) - static_cast<Offset>(m_min));
+    }
+    /**
+     * \brief Adds offsets modulo the period without overflowing
+     */
+    Offset AddOffsets(const Offset left, const Offset right) const noexcept
+    {
+      const auto space = static_cast<Offset>(m_period - left);
+      return right >= space ? static_cast<Offset>(right - space) : static_cast<Offset>(left + right);
+    }
+    /**
+     * \brief Subtracts offsets modulo the period without overflowing
+     */
+    Offset SubtractOffsets(const Offset left, const Offset right) const noexcept
+    {
+      return left >= right ? static_cast<Offset>(left - right) : static_cast<Offset>(left + static_cast<Offset>(m_period - right));
+    }
+    /**
+     * \brief Maps an offset modulo the period to a value in range
+     */
+    T FromPeriodOffset(const Offset offset) const noexcept
+    {
+      return FromOffset(TPolicy::Fold(offset, m_rangeLen, m_period));
+    }
+
+    static constexpr T Clamp(const T & value, const T & min, const T & max) noexcept
+    {
+      return std::min(std::max(value, min), max);
+    }
+
+    /**
+     * \brief Adds values of T, a sum overflowing T saturates to its limit
+     */
+    static T SaturatingAdd(const T & left, const T & right, bool & overflow) noexcept
+    {
+      const auto sum = static_cast<T>(static_cast<Offset>(static_cast<Offset>(left) + static_cast<Offset>(right)));
+      if constexpr (std::is_signed<T>::value)
+      {
+        // Only operands of equal signs overflow, the sum then has the other sign
+        overflow = (left < 0) == (right < 0) && (sum < 0) != (left < 0);
+        return overflow ? (right < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max()) : sum;
+      }
+      else
+      {
+        overflow = sum < left;
+        return overflow ? std::numeric_limits<T>::max() : sum;
+      }
+    }
+    /**
+     * \brief Subtracts values of T, a difference overflowing T saturates to its limit
+     */
+    static T SaturatingSubtract(const T & left, const T & right, bool & overflow) noexcept
+    {
+      const auto difference = static_cast<T>(static_cast<Offset>(static_cast<Offset>(left) - static_cast<Offset>(right)));
+      if constexpr (std::is_signed<T>::value)
+      {
+        overflow = (left < 0) != (right < 0) && (difference < 0) != (left < 0);
+        return overflow ? (right < 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min()) : difference;
+      }
+      else
+      {
+        overflow = right > left;
+        return overflow ? T(0) : difference;
+      }
+    }
+    /**
+     * \brief Multiplies values of T, a product overflowing T saturates to its limit
+     */
+    static T SaturatingMultiply(const T & left, const T & right, bool & overflow) noexcept
+    {
+      // Magnitudes are multiplied in double width, the sign of the product selects the limit
+      using Word = std::conditional_t<(sizeof(T) <= sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+      const auto magnitude = [](const T & value) { return static_cast<Word>(value < 0 ? static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(value)) : static_cast<Offset>(value)); };
+      const bool negative = std::is_signed<T>::value && (left < 0) != (right < 0);
+      const auto limit = static_cast<Word>(static_cast<Offset>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u));
+      const auto high = WideArithmetic::MultiplyHigh(magnitude(left), magnitude(right));
+      const auto low = static_cast<Word>(magnitude(left) * magnitude(right));
+
+      overflow = high != 0 || low > limit;
+      if (overflow)
+        return negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+
+      return static_cast<T>(negative ? static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(low)) : static_cast<Offset>(low));
     }
 
   public:
@@ -55,11 +216,18 @@ namespace Common::Math
      * \param max Range maximum
      */
     NumberInRange(const T & value, const T & min, const T & max)
-      : m_min(min), m_max(max), m_rangeLen(CalcRangeLen(min, max)), m_value(AdjustValue(value))
+      : m_min(ValidateRange(min, max)),
+      m_max(max),
+      m_rangeLen(CalcRangeLen(min, max)),
+      m_period(CalcPeriod(min, max)),
+      m_divisor(m_period == 0 ? Offset(1) : m_period),
+      m_minResidue(CalcMinResidue()),
+      m_productFits(m_period == m_rangeLen && CalcProductFits(min, max)),
+      m_periodMax(CalcPeriodMax()),
+      m_value(AdjustValue(value))
     {
       static_assert(!std::is_same<T, double>::value && !std::is_same<T, float>::value, "NumberInRange: T cannot be of a floating point type.");
-      if (min == max) throw std::invalid_argument("Argument " + NAMEOF(min) + " cannot be equal to argument " + NAMEOF(max) + ".");
-      if (min > max) throw std::invalid_argument("Argument " + NAMEOF(min) + " cannot be greater than argument " + NAMEOF(max) + ".");
+      TPolicy::Report(value < m_min || value > m_max);
     }
 
     /**
@@ -74,6 +242,16 @@ namespace Common::Math
      */
     const T & GetMax() const { return m_max; }
 
+    /**
+     * \brief Getter for the Parameters property
+     * \return Precomputed constants of the range accepted by the range kernels, modular policies wrap values
+     * into the period before they are folded into the range
+     */
+    RangeParameters<T> GetParameters() const noexcept
+    {
+      return { m_min, m_periodMax, m_period, m_divisor, m_minResidue, m_productFits };
+    }
+
     /**
      * \brief Getter for the Value property
      * \return Value
@@ -83,58 +261,176 @@ namespace Common::Math
      * \brief Setter for the Value property
      * \param value New value to set
      */
-    void SetValue(const T & value) { m_value = AdjustValue(value); }
-
-    static T AdjustValue(const T & value, const T & min, const T & max)
+    void SetValue(const T & value)
     {
-      return NumberInRange<T>(value, min, max).GetValue();
+      m_value = AdjustValue(value);
+      TPolicy::Report(value < m_min || value > m_max);
     }
 
-    T operator +(const T & other) const noexcept
-    {
-      return AdjustValue(m_value + AdjustValue(other, m_min, m_max), m_min, m_max);
-    }
-    T operator +(const NumberInRange<T> & other) const noexcept
+    /**
+     * \brief Brings a value into a range by the policy, wrapped values equal min + (value - min) mod (max - min + 1).
+     * The range is not validated and no object is constructed, min must be less than max. Unlike the constructor,
+     * reflected ranges whose period 2 * (max - min) does not fit into the unsigned type are accepted
+     * \param value Value to adjust
+     * \param min Range minimum
+     * \param max Range maximum
+     * \return Value in range
+     */
+    static constexpr T AdjustValue(const T & value, const T & min, const T & max) noexcept
     {
-      return AdjustValue(m_value + AdjustValue(other.m_value, m_min, m_max), m_min, m_max);
+      if (value >= min && value <= max)
+        return value;
+      if constexpr (!TPolicy::IsModular)
+        return Clamp(value, min, max);
+      else
+      {
+        // Distances from the minimum are exact in the unsigned type whichever side the value lies on
+        const auto length = CalcRangeLen(min, max);
+        if (!TPolicy::IsValidLength(length))
+        {
+          // The period does not fit into the offset type, no distance from a bound reaches it
+          return value > max
+            ? static_cast<T>(static_cast<Offset>(static_cast<Offset>(min) + TPolicy::FoldDistance(static_cast<Offset>(static_cast<Offset>(value) - static_cast<Offset>(min)), length)))
+            : static_cast<T>(static_cast<Offset>(static_cast<Offset>(min) + TPolicy::FoldDistance(static_cast<Offset>(static_cast<Offset>(min) - static_cast<Offset>(value)), length)));
+        }
+
+        const auto period = TPolicy::CalcPeriod(length);
+        const auto fromOffset = [&](const Offset offset) { return static_cast<T>(static_cast<Offset>(static_cast<Offset>(min) + TPolicy::Fold(offset, length, period))); };
+        if (value > max)
+          return fromOffset(static_cast<Offset>(static_cast<Offset>(static_cast<Offset>(value) - static_cast<Offset>(min)) % period));
+
+        const auto remainder = static_cast<Offset>(static_cast<Offset>(static_cast<Offset>(min) - static_cast<Offset>(value)) % period);
+        return fromOffset(remainder == 0 ? Offset(0) : static_cast<Offset>(period - remainder));
+      }
     }
 
-    T operator -(const T & other) const noexcept
+    /**
+     * \brief Adjusts an array of values into a range by the policy, 32-bit values are wrapped by vector kernels
+     * \param values Values to adjust
+     * \param output Adjusted values, may be equal to values
+     * \param count Number of values
+     * \param min Range minimum
+     * \param max Range maximum
+     */
+    static void AdjustRange(const T * values, T * output, const std::size_t count, const T & min, const T & max)
     {
-      return AdjustValue(m_value - AdjustValue(other, m_min, m_max), m_min, m_max);
+      const NumberInRange range(min, min, max);
+      if constexpr (TPolicy::IsModular)
+      {
+        GetRangeKernels<T>().adjust(values, output, count, range.GetParameters());
+        range.FoldRange(output, count);
+      }
+      else
+        for (std::size_t i = 0; i < count; ++i)
+          output[i] = Clamp(values[i], min, max);
     }
-    T operator -(const NumberInRange<T> & other) const noexcept
+    /**
+     * \brief Adds arrays of values in a range, output[i] equals NumberInRange(a[i], min, max) + b[i]
+     * \param a Left operands
+     * \param b Right operands
+     * \param output Adjusted sums, may be equal to either operand
+     * \param count Number of values
+     * \param min Range minimum
+     * \param max Range maximum
+     */
+    static void AddRange(const T * a, const T * b, T * output, const std::size_t count, const T & min, const T & max)
     {
-      return AdjustValue(m_value - AdjustValue(other.m_value, m_min, m_max), m_min, m_max);
+      const NumberInRange range(min, min, max);
+      if constexpr (TPolicy::IsModular)
+        range.ApplyRange(GetRangeKernels<T>().add, a, b, output, count);
+      else
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          bool overflow;
+          output[i] = Clamp(SaturatingAdd(Clamp(a[i], min, max), b[i], overflow), min, max);
+        }
     }
-
-    T operator *(const T & other) const noexcept
+    /**
+     * \brief Subtracts arrays of values in a range, output[i] equals NumberInRange(a[i], min, max) - b[i]
+     * \param a Left operands
+     * \param b Right operands
+     * \param output Adjusted differences, may be equal to either operand
+     * \param count Number of values
+     * \param min Range minimum
+     * \param max Range maximum
+     */
+    static void SubtractRange(const T * a, const T * b, T * output, const std::size_t count, const T & min, const T & max)
     {
-      return AdjustValue(m_value * AdjustValue(other, m_min, m_max), m_min, m_max);
+      const NumberInRange range(min, min, max);
+      if constexpr (TPolicy::IsModular)
+        range.ApplyRange(GetRangeKernels<T>().subtract, a, b, output, count);
+      else
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          bool overflow;
+          output[i] = Clamp(SaturatingSubtract(Clamp(a[i], min, max), b[i], overflow), min, max);
+        }
     }
-    T operator *(const NumberInRange<T> & other) const noexcept
+    /**
+     * \brief Multiplies arrays of values in a range, output[i] equals NumberInRange(a[i], min, max) * b[i]
+     * \param a Left operands
+     * \param b Right operands
+     * \param output Adjusted products, may be equal to either operand
+     * \param count Number of values
+     * \param min Range minimum
+     * \param max Range maximum
+     */
+    static void MultiplyRange(const T * a, const T * b, T * output, const std::size_t count, const T & min, const T & max)
     {
-      return AdjustValue(m_value * AdjustValue(other.m_value, m_min, m_max), m_min, m_max);
+      const NumberInRange range(min, min, max);
+      if constexpr (TPolicy::IsModular)
+        range.ApplyRange(GetRangeKernels<T>().multiply, a, b, output, count);
+      else
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          bool overflow;
+          output[i] = Clamp(SaturatingMultiply(Clamp(a[i], min, max), b[i], overflow), min, max);
+        }
     }
 
+    T operator +(const T & other) const noexcept { bool outOfRange = false; return Add(other, outOfRange); }
+    T operator +(const NumberInRange & other) const noexcept { bool outOfRange = false; return Add(other.m_value, outOfRange); }
+
+    T operator -(const T & other) const noexcept { bool outOfRange = false; return Subtract(other, outOfRange); }
+    T operator -(const NumberInRange & other) const noexcept { bool outOfRange = false; return Subtract(other.m_value, outOfRange); }
+
+    T operator *(const T & other) const noexcept { bool outOfRange = false; return Multiply(other, outOfRange); }
+    T operator *(const NumberInRange & other) const noexcept { bool outOfRange = false; return Multiply(other.m_value, outOfRange); }
+
     T operator /(const T & other) const
     {
-      return AdjustValue(m_value / AdjustValue(other, m_min, m_max), m_min, m_max);
+      return AdjustValue(static_cast<T>(m_value / AdjustValue(other)));
     }
-    T operator /(const NumberInRange<T> & other) const
+    T operator /(const NumberInRange & other) const
     {
-      return AdjustValue(m_value / AdjustValue(other.m_value, m_min, m_max), m_min, m_max);
+      return AdjustValue(static_cast<T>(m_value / AdjustValue(other.m_value)));
     }
 
     T operator %(const T & other) const
     {
-      return AdjustValue(m_value % AdjustValue(other, m_min, m_max), m_min, m_max);
+      return AdjustValue(static_cast<T>(m_value % AdjustValue(other)));
     }
-    T operator %(const NumberInRange<T> & other) const
+    T operator %(const NumberInRange & other) const
     {
-      return AdjustValue(m_value % AdjustValue(other.m_value, m_min, m_max), m_min, m_max);
+      return AdjustValue(static_cast<T>(m_value % AdjustValue(other.m_value)));
     }
 
+    /**
+     * \brief Assigns the sum, the Checked policy records a sum out of range
+     */
+    NumberInRange & operator +=(const T & other) noexcept { return Assign(&NumberInRange::Add, other); }
+    NumberInRange & operator +=(const NumberInRange & other) noexcept { return Assign(&NumberInRange::Add, other.m_value); }
+    /**
+     * \brief Assigns the difference, the Checked policy records a difference out of range
+     */
+    NumberInRange & operator -=(const T & other) noexcept { return Assign(&NumberInRange::Subtract, other); }
+    NumberInRange & operator -=(const NumberInRange & other) noexcept { return Assign(&NumberInRange::Subtract, other.m_value); }
+    /**
+     * \brief Assigns the product, the Checked policy records a product out of range
+     */
+    NumberInRange & operator *=(const T & other) noexcept { return Assign(&NumberInRange::Multiply, other); }
+    NumberInRange & operator *=(const NumberInRange & other) noexcept { return Assign(&NumberInRange::Multiply, other.m_value); }
+
     std::string ToString() const
     {
       std::ostringstream oss;
@@ -147,17 +443,123 @@ namespace Common::Math
     {
       if (value >= m_min && value <= m_max)
         return value;
+      if constexpr (!TPolicy::IsModular)
+        return Clamp(value, m_min, m_max);
+      else
+        return FromPeriodOffset(ReduceOutside(value));
+    }
 
-      if (value > m_min)
+    /**
+     * \brief Calculates the offset of a value from the minimum modulo the period
+     */
+    Offset Reduce(const T & value) const noexcept
+    {
+      return value >= m_min && value <= m_max ? GetOffset(value) : ReduceOutside(value);
+    }
+    Offset ReduceOutside(const T & value) const noexcept
+    {
+      // Distances from the minimum are exact in the unsigned type whichever side the value lies on
+      if (value > m_max)
+        return m_divisor.Remainder(GetOffset(value));
+
+      const auto remainder = m_divisor.Remainder(static_cast<Offset>(static_cast<Offset>(m_min) - static_cast<Offset>(value)));
+      return remainder == 0 ? Offset(0) : static_cast<Offset>(m_period - remainder);
+    }
+
+    /**
+     * \brief Folds values wrapped into the period by the range kernels into the range
+     */
+    void FoldRange(T * output, const std::size_t count) const noexcept
+    {
+      if (m_period == m_rangeLen)
+        return;
+
+      for (std::size_t i = 0; i < count; ++i)
+        output[i] = FromPeriodOffset(GetOffset(output[i]));
+    }
+
+    /**
+     * \brief Applies a range kernel to operands, reflected left operands are folded into the range first
+     * as their residues modulo the period differ from the unfolded ones
+     */
+    void ApplyRange(void (*kernel)(const T *, const T *, T *, std::size_t, const RangeParameters<T> &) noexcept, const T * a, const T * b, T * output, const std::size_t count) const noexcept
+    {
+      const auto parameters = GetParameters();
+      if (m_period == m_rangeLen)
+        return kernel(a, b, output, count, parameters);
+
+      constexpr std::size_t chunk = 256;
+      T folded[chunk];
+      for (std::size_t i = 0; i < count; i += chunk)
       {
-        if (m_min < 0)
-          return (Abs(value - m_min) % m_rangeLen) + m_min; // TODO Abs
-        auto remainder = value % m_rangeLen;
-        return remainder + m_min;
+        const auto length = std::min(chunk, count - i);
+        GetRangeKernels<T>().adjust(a + i, folded, length, parameters);
+        FoldRange(folded, length);
+        kernel(folded, b + i, output + i, length, parameters);
+        FoldRange(output + i, length);
       }
+    }
+
+    NumberInRange & Assign(T (NumberInRange::*operation)(const T &, bool &) const noexcept, const T & other) noexcept
+    {
+      bool outOfRange = false;
+      m_value = (this->*operation)(other, outOfRange);
+      TPolicy::Report(outOfRange);
+      return *this;
+    }
 
-      auto remainder = Abs(value - m_min) % m_rangeLen;
-      return remainder == 0 ? m_min : m_rangeLen - remainder + m_min;
+    /**
+     * \brief Adds a value, (a + b - min) mod period equals the sum of both offsets and of the residue of min
+     */
+    T Add(const T & other, bool & outOfRange) const noexcept
+    {
+      if constexpr (!TPolicy::IsModular)
+      {
+        const auto sum = SaturatingAdd(m_value, other, outOfRange);
+        outOfRange = outOfRange || sum < m_min || sum > m_max;
+        return Clamp(sum, m_min, m_max);
+      }
+      else
+        return FromPeriodOffset(AddOffsets(AddOffsets(GetOffset(m_value), Reduce(other)), m_minResidue));
+    }
+    /**
+     * \brief Subtracts a value without any division
+     */
+    T Subtract(const T & other, bool & outOfRange) const noexcept
+    {
+      if constexpr (!TPolicy::IsModular)
+      {
+        const auto difference = SaturatingSubtract(m_value, other, outOfRange);
+        outOfRange = outOfRange || difference < m_min || difference > m_max;
+        return Clamp(difference, m_min, m_max);
+      }
+      else
+        return FromPeriodOffset(SubtractOffsets(SubtractOffsets(GetOffset(m_value), Reduce(other)), m_minResidue));
+    }
+    /**
+     * \brief Multiplies by a value. Products of large ranges are calculated from the residues
+     * of both factors as (a * b - min) mod period and never overflow
+     */
+    T Multiply(const T & other, bool & outOfRange) const noexcept
+    {
+      if constexpr (!TPolicy::IsModular)
+      {
+        const auto product = SaturatingMultiply(m_value, other, outOfRange);
+        outOfRange = outOfRange || product < m_min || product > m_max;
+        return Clamp(product, m_min, m_max);
+      }
+      else
+      {
+        if (m_productFits)
+          return AdjustValue(static_cast<T>(m_value * AdjustValue(other)));
+        // A range covering every value of T wraps like the unsigned type
+        if (m_period == 0)
+          return static_cast<T>(static_cast<Offset>(static_cast<Product>(static_cast<Offset>(m_value)) * static_cast<Offset>(other)));
+
+        const auto left = AddOffsets(GetOffset(m_value), m_minResidue);
+        const auto right = AddOffsets(Reduce(other), m_minResidue);
+        return FromPeriodOffset(SubtractOffsets(m_divisor.MultiplyModulo(left, right), m_minResidue));
+      }
     }
   };
 }
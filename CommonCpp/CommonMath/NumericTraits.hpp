@@ -0,0 +1,34 @@
+#pragma once
+#include <type_traits>
+
+namespace Common::Math
+{
+  /**
+   * \brief Properties of types usable as matrix values. Built-in arithmetic types are numeric,
+   * other types opt in by specializing the traits
+   * \tparam T Type of values
+   */
+  template <typename T>
+  struct NumericTraits
+  {
+    /**
+     * \brief True if the type can be stored in a matrix
+     */
+    static constexpr bool IsNumeric = std::is_arithmetic<T>::value;
+    /**
+     * \brief True if the type represents real numbers
+     */
+    static constexpr bool IsFloatingPoint = std::is_floating_point<T>::value;
+    /**
+     * \brief Type in which sums and products of the values are accumulated
+     */
+    using Accumulator = T;
+  };
+
+  /**
+   * \brief Decides whether values are converted to a wider type for arithmetic
+   * \tparam T Type of values
+   */
+  template <typename T>
+  constexpr bool IsStorageOnly = !std::is_same<typename NumericTraits<T>::Accumulator, T>::value;
+}
@@ -0,0 +1,358 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Gemm.hpp"
+#include "MatrixFile.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Handle to a matrix stored in a matrix file, accessed tile by tile instead of being loaded as a whole
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class FileMatrix
+  {
+    /**
+     * \brief Path to the matrix file
+     */
+    std::string m_path;
+    /**
+     * \brief Header of the matrix file
+     */
+    MatrixFileHeader m_header;
+
+    std::uint64_t GetOffset(const unsigned row, const unsigned column) const noexcept
+    {
+      return m_header.payloadOffset + (static_cast<std::uint64_t>(row) * m_header.columns + column) * sizeof(T);
+    }
+
+  public:
+    /**
+     * \brief Opens an existing matrix file
+     * \param path Path to the matrix file
+     */
+    explicit FileMatrix(const std::string & path)
+      : m_path(path), m_header(MatrixFile::ReadHeader(path))
+    {
+      MatrixFile::ValidateHeader<T>(m_header, std::filesystem::file_size(path));
+    }
+
+    /**
+     * \brief Creates a matrix file of given size filled with zeros
+     * \param path Path to the matrix file
+     * \param rows Number of rows
+     * \param columns Number of columns
+     * \param alignment Alignment of the payload in bytes
+     * \return Handle to the created file
+     */
+    static FileMatrix<T> Create(const std::string & path, const unsigned rows, const unsigned columns, const unsigned alignment = 64)
+    {
+      const auto header = MatrixFile::CreateHeader<T>(rows, columns, alignment);
+      MatrixFile::Write(header, path, [](std::ofstream &) { });
+      std::filesystem::resize_file(path, header.payloadOffset + header.payloadSize);
+
+      return FileMatrix<T>(path);
+    }
+
+    /**
+     * \brief Getter method for the Path property
+     * \return Path to the matrix file
+     */
+    const std::string & GetPath() const noexcept { return m_path; }
+    /**
+     * \brief Getter method for the Rows property
+     * \return Rows count
+     */
+    unsigned GetRows() const noexcept { return static_cast<unsigned>(m_header.rows); }
+    /**
+     * \brief Getter method for the Columns property
+     * \return Columns count
+     */
+    unsigned GetColumns() const noexcept { return static_cast<unsigned>(m_header.columns); }
+
+    /**
+     * \brief Reads a rectangular tile of the matrix
+     * \param file Stream opened on the matrix file
+     * \param row First row of the tile
+     * \param column First column of the tile
+     * \param rows Number of rows of the tile
+     * \param columns Number of columns of the tile
+     * \param output Destination with a stride of given number of columns
+     */
+    void ReadTile(std::istream & file, const unsigned row, const unsigned column, const unsigned rows, const unsigned columns, T * output) const
+    {
+      for (unsigned i = 0; i < rows; ++i)
+      {
+        file.seekg(static_cast<std::streamoff>(GetOffset(row + i, column)));
+        file.read(reinterpret_cast<char *>(output + static_cast<std::size_t>(i) * columns), static_cast<std::streamsize>(columns * sizeof(T)));
+      }
+
+      if (!file)
+        throw MatrixFileException("Failed to read a tile of file '" + m_path + "'.");
+    }
+
+    /**
+     * \brief Writes a rectangular tile of the matrix
+     * \param file Stream opened on the matrix file
+     * \param row First row of the tile
+     * \param column First column of the tile
+     * \param rows Number of rows of the tile
+     * \param columns Number of columns of the tile
+     * \param input Source with a stride of given number of columns
+     */
+    void WriteTile(std::ostream & file, const unsigned row, const unsigned column, const unsigned rows, const unsigned columns, const T * input) const
+    {
+      for (unsigned i = 0; i < rows; ++i)
+      {
+        file.seekp(static_cast<std::streamoff>(GetOffset(row + i, column)));
+        file.write(reinterpret_cast<const char *>(input + static_cast<std::size_t>(i) * columns), static_cast<std::streamsize>(columns * sizeof(T)));
+      }
+
+      if (!file)
+        throw MatrixFileException("Failed to write a tile of file '" + m_path + "'.");
+    }
+
+    /**
+     * \brief Recomputes the payload checksum and stores it in the header
+     */
+    void UpdateChecksum()
+    {
+      std::fstream file(m_path, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekg(static_cast<std::streamoff>(m_header.payloadOffset));
+
+      MatrixFileChecksum checksum;
+      std::vector<char> buffer(1u << 20);
+      for (auto remaining = m_header.payloadSize; remaining != 0;)
+      {
+        const auto size = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, buffer.size()));
+        file.read(buffer.data(), static_cast<std::streamsize>(size));
+        checksum.Update(buffer.data(), size);
+        remaining -= size;
+      }
+
+      m_header.checksum = checksum.GetValue();
+      file.seekp(0);
+      file.write(reinterpret_cast<const char *>(&m_header), sizeof(m_header));
+      if (!file.flush())
+        throw MatrixFileException("Failed to update checksum of file '" + m_path + "'.");
+    }
+  };
+
+  /**
+   * \brief Operations on file-backed matrices larger than the available memory
+   */
+  class OutOfCore
+  {
+    /**
+     * \brief Tile buffers needed at once: two of A and two of B (one in use, one being prefetched) and one of C
+     */
+    static constexpr std::size_t TileBuffers = 5;
+
+    template <typename T>
+    struct TilePair
+    {
+      std::vector<T> a;
+      std::vector<T> b;
+    };
+
+    /**
+     * \brief Single background thread loading the tiles of consecutive steps one step ahead of the computation.
+     * Two pairs of buffers circulate between the threads, one being computed with while the other is being filled
+     */
+    template <typename T>
+    class TilePrefetcher
+    {
+      std::mutex m_mutex;
+      std::condition_variable m_changed;
+      TilePair<T> m_loaded;
+      TilePair<T> m_spare;
+      bool m_hasLoaded = false;
+      bool m_hasSpare = true;
+      bool m_stopped = false;
+      std::exception_ptr m_error;
+      std::thread m_thread;
+
+      template <typename TLoad>
+      void Run(const std::uint64_t steps, const TLoad & load)
+      {
+        for (std::uint64_t step = 0; step < steps; ++step)
+        {
+          TilePair<T> pair;
+          {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this] { return m_hasSpare || m_stopped; });
+            if (m_stopped)
+              return;
+
+            pair = std::move(m_spare);
+            m_hasSpare = false;
+          }
+
+          try
+          {
+            load(step, pair);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = std::current_exception();
+            m_changed.notify_all();
+            return;
+          }
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_loaded = std::move(pair);
+          m_hasLoaded = true;
+          m_changed.notify_all();
+        }
+      }
+
+    public:
+      /**
+       * \brief Starts loading the tiles of the first step
+       * \param steps Number of steps
+       * \param load Fills the pair of buffers with the tiles of given step, called on the background thread only
+       */
+      template <typename TLoad>
+      TilePrefetcher(const std::uint64_t steps, const TLoad & load)
+        : m_thread([this, steps, load = &load] { Run(steps, *load); }) { }
+
+      TilePrefetcher(const TilePrefetcher &) = delete;
+      TilePrefetcher & operator =(const TilePrefetcher &) = delete;
+
+      ~TilePrefetcher()
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_stopped = true;
+        }
+        m_changed.notify_all();
+        m_thread.join();
+      }
+
+      /**
+       * \brief Waits for the tiles of the next step, rethrows the failure of loading them
+       * \param used Buffers of the previous step, reused for loading the step after the returned one
+       * \return Tiles of the next step
+       */
+      TilePair<T> Take(TilePair<T> && used)
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return m_hasLoaded || m_error; });
+        if (m_error)
+          std::rethrow_exception(m_error);
+
+        auto result = std::move(m_loaded);
+        m_hasLoaded = false;
+        m_spare = std::move(used);
+        m_hasSpare = true;
+        m_changed.notify_all();
+
+        return result;
+      }
+    };
+
+  public:
+    /**
+     * \brief Calculates the edge of a square tile fitting into given memory budget
+     * \tparam T Type of matrix values
+     * \param memoryBudget Memory available for tile buffers in bytes
+     * \return Tile edge
+     */
+    template <typename T>
+    static unsigned GetTileSize(const std::size_t memoryBudget)
+    {
+      const auto tile = static_cast<unsigned>(std::sqrt(static_cast<double>(memoryBudget / (TileBuffers * sizeof(T)))));
+      if (tile == 0)
+        throw std::invalid_argument("Argument " + NAMEOF(memoryBudget) + " is too small to hold a single tile.");
+
+      return tile;
+    }
+
+    /**
+     * \brief Multiplies two file-backed matrices, streaming tiles through a bounded amount of memory.
+     * Tiles of the next step are read by a background thread while the current step is being computed
+     * \tparam T Type of matrix values
+     * \param a Left operand
+     * \param b Right operand
+     * \param path Path of the file to store the product in
+     * \param memoryBudget Memory available for tile buffers in bytes
+     * \return Handle to the product
+     */
+    template <typename T>
+    static FileMatrix<T> Multiply(const FileMatrix<T> & a, const FileMatrix<T> & b, const std::string & path, const std::size_t memoryBudget)
+    {
+      if (a.GetColumns() != b.GetRows())
+        throw MatrixDimensionException("Number of columns of the left operand must match number of rows of the right operand.");
+
+      const auto tile = std::min(GetTileSize<T>(memoryBudget), std::max({ a.GetRows(), a.GetColumns(), b.GetColumns() }));
+      auto c = FileMatrix<T>::Create(path, a.GetRows(), b.GetColumns());
+
+      std::ifstream fileA(a.GetPath(), std::ios::binary);
+      std::ifstream fileB(b.GetPath(), std::ios::binary);
+      std::fstream fileC(c.GetPath(), std::ios::binary | std::ios::in | std::ios::out);
+      if (!fileA || !fileB || !fileC)
+        throw MatrixFileException("Cannot open operands of the multiplication.");
+
+      // Steps enumerate (row tile, column tile, depth tile) with the depth changing fastest
+      const auto rowTiles = (a.GetRows() + tile - 1) / tile;
+      const auto columnTiles = (b.GetColumns() + tile - 1) / tile;
+      const auto depthTiles = (a.GetColumns() + tile - 1) / tile;
+      const auto steps = static_cast<std::uint64_t>(rowTiles) * columnTiles * depthTiles;
+
+      // Only the prefetching thread reads the operands
+      const auto load = [&, tile](const std::uint64_t step, TilePair<T> & pair)
+      {
+        const auto i = static_cast<unsigned>(step / depthTiles / columnTiles) * tile;
+        const auto j = static_cast<unsigned>(step / depthTiles % columnTiles) * tile;
+        const auto k = static_cast<unsigned>(step % depthTiles) * tile;
+        const auto rows = std::min(tile, a.GetRows() - i);
+        const auto columns = std::min(tile, b.GetColumns() - j);
+        const auto depth = std::min(tile, a.GetColumns() - k);
+
+        pair.a.resize(static_cast<std::size_t>(rows) * depth);
+        pair.b.resize(static_cast<std::size_t>(depth) * columns);
+        a.ReadTile(fileA, i, k, rows, depth, pair.a.data());
+        b.ReadTile(fileB, k, j, depth, columns, pair.b.data());
+      };
+
+      std::vector<T> tileC;
+      tileC.reserve(static_cast<std::size_t>(tile) * tile);
+      const auto & parameters = GemmProfile::GetActive<T>();
+      TilePrefetcher<T> prefetcher(steps, load);
+      TilePair<T> current;
+
+      for (std::uint64_t step = 0; step < steps; ++step)
+      {
+        current = prefetcher.Take(std::move(current));
+
+        const auto i = static_cast<unsigned>(step / depthTiles / columnTiles) * tile;
+        const auto j = static_cast<unsigned>(step / depthTiles % columnTiles) * tile;
+        const auto k = step % depthTiles;
+        const auto rows = std::min(tile, a.GetRows() - i);
+        const auto columns = std::min(tile, b.GetColumns() - j);
+        const auto depth = std::min(tile, a.GetColumns() - static_cast<unsigned>(k) * tile);
+
+        if (k == 0)
+          tileC.assign(static_cast<std::size_t>(rows) * columns, T());
+        Gemm::Multiply(current.a.data(), current.b.data(), tileC.data(), rows, depth, columns, parameters);
+        if (k == depthTiles - 1)
+          c.WriteTile(fileC, i, j, rows, columns, tileC.data());
+      }
+
+      fileC.close();
+      c.UpdateChecksum();
+
+      return c;
+    }
+  };
+}
@@ -0,0 +1,458 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Dispatch.hpp"
+#include "FastDivisor.hpp"
+#include "WideArithmetic.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Precomputed constants wrapping values into a range as min + (value - min) mod (max - min + 1)
+   * \tparam T Type of values
+   */
+  template <typename T>
+  struct RangeParameters
+  {
+    using Offset = std::make_unsigned_t<T>;
+
+    T min;
+    T max;
+    /**
+     * \brief Number of values in the range, zero if the range covers every value of T
+     */
+    Offset length;
+    /**
+     * \brief Range length with its precomputed reciprocal, one if the range covers every value of T
+     */
+    FastDivisor<Offset> divisor;
+    /**
+     * \brief Residue of the minimum modulo the range length
+     */
+    Offset minResidue;
+    /**
+     * \brief True if the product of any two values in range fits into T
+     */
+    bool productFits;
+  };
+
+  /**
+   * \brief Random word mapped into a range of T by the multiply-shift method
+   */
+  template <typename T>
+  using RandomWord = std::conditional_t<sizeof(T) <= sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+
+  /**
+   * \brief Kernels wrapping arrays of values into a range, operands of the arithmetic kernels are wrapped first
+   * \tparam T Type of values
+   */
+  template <typename T>
+  struct RangeKernels
+  {
+    /**
+     * \brief output[i] = adjust(values[i])
+     */
+    void (*adjust)(const T * values, T * output, std::size_t count, const RangeParameters<T> & range) noexcept;
+    /**
+     * \brief output[i] = adjust(adjust(a[i]) + adjust(b[i]))
+     */
+    void (*add)(const T * a, const T * b, T * output, std::size_t count, const RangeParameters<T> & range) noexcept;
+    /**
+     * \brief output[i] = adjust(adjust(a[i]) - adjust(b[i]))
+     */
+    void (*subtract)(const T * a, const T * b, T * output, std::size_t count, const RangeParameters<T> & range) noexcept;
+    /**
+     * \brief output[i] = adjust(adjust(a[i]) * adjust(b[i])), calculated exactly without overflow
+     */
+    void (*multiply)(const T * a, const T * b, T * output, std::size_t count, const RangeParameters<T> & range) noexcept;
+    /**
+     * \brief output[i] = min + high half of words[i] * length, the range must not cover every value of T.
+     * Returns true if the low half of some product is less than the length, the word may have to be rejected
+     */
+    bool (*bound)(const RandomWord<T> * words, T * output, std::size_t count, const RangeParameters<T> & range) noexcept;
+    /**
+     * \brief Instruction set the kernels were compiled for
+     */
+    InstructionSet instructionSet;
+  };
+
+  namespace Kernels::Scalar
+  {
+    template <typename T>
+    inline T AdjustValue(const T value, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      if (value >= range.min && value <= range.max)
+        return value;
+
+      const auto min = static_cast<Offset>(range.min);
+      if (value > range.max)
+        return static_cast<T>(static_cast<Offset>(min + range.divisor.Remainder(static_cast<Offset>(static_cast<Offset>(value) - min))));
+
+      const auto remainder = range.divisor.Remainder(static_cast<Offset>(min - static_cast<Offset>(value)));
+      return static_cast<T>(static_cast<Offset>(min + (remainder == 0 ? Offset(0) : static_cast<Offset>(range.length - remainder))));
+    }
+
+    /**
+     * \brief Retrieves the offset of a wrapped value from the minimum
+     */
+    template <typename T>
+    inline std::make_unsigned_t<T> GetOffset(const T value, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      return static_cast<Offset>(static_cast<Offset>(AdjustValue(value, range)) - static_cast<Offset>(range.min));
+    }
+
+    template <typename T>
+    inline std::make_unsigned_t<T> AddOffsets(const std::make_unsigned_t<T> left, const std::make_unsigned_t<T> right, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      const auto space = static_cast<Offset>(range.length - left);
+      return right >= space ? static_cast<Offset>(right - space) : static_cast<Offset>(left + right);
+    }
+
+    template <typename T>
+    inline std::make_unsigned_t<T> SubtractOffsets(const std::make_unsigned_t<T> left, const std::make_unsigned_t<T> right, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      return left >= right ? static_cast<Offset>(left - right) : static_cast<Offset>(left + static_cast<Offset>(range.length - right));
+    }
+
+    template <typename T>
+    void AdjustRange(const T * values, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        output[i] = AdjustValue(values[i], range);
+    }
+
+    template <typename T>
+    void AddRange(const T * a, const T * b, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const auto offset = AddOffsets(AddOffsets(GetOffset(a[i], range), GetOffset(b[i], range), range), range.minResidue, range);
+        output[i] = static_cast<T>(static_cast<Offset>(static_cast<Offset>(range.min) + offset));
+      }
+    }
+
+    template <typename T>
+    void SubtractRange(const T * a, const T * b, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const auto offset = SubtractOffsets(SubtractOffsets(GetOffset(a[i], range), GetOffset(b[i], range), range), range.minResidue, range);
+        output[i] = static_cast<T>(static_cast<Offset>(static_cast<Offset>(range.min) + offset));
+      }
+    }
+
+    template <typename T>
+    void MultiplyRange(const T * a, const T * b, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      using Product = std::common_type_t<Offset, unsigned>;
+      if (range.productFits)
+      {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          const auto product = static_cast<Product>(static_cast<Offset>(AdjustValue(a[i], range))) * static_cast<Offset>(AdjustValue(b[i], range));
+          output[i] = AdjustValue(static_cast<T>(static_cast<Offset>(product)), range);
+        }
+        return;
+      }
+      // A range covering every value of T wraps like the unsigned type
+      if (range.length == 0)
+      {
+        for (std::size_t i = 0; i < count; ++i)
+          output[i] = static_cast<T>(static_cast<Offset>(static_cast<Product>(static_cast<Offset>(a[i])) * static_cast<Offset>(b[i])));
+        return;
+      }
+
+      // Residues of both factors modulo the length
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const auto left = AddOffsets(GetOffset(a[i], range), range.minResidue, range);
+        const auto right = AddOffsets(GetOffset(b[i], range), range.minResidue, range);
+        const auto offset = SubtractOffsets(range.divisor.MultiplyModulo(left, right), range.minResidue, range);
+        output[i] = static_cast<T>(static_cast<Offset>(static_cast<Offset>(range.min) + offset));
+      }
+    }
+
+    /**
+     * \brief Calculates the full width product of a random word and the range length
+     * \param low Low half of the product
+     * \return High half of the product, the offset of the mapped value from the minimum
+     */
+    template <typename T>
+    inline RandomWord<T> MultiplyWord(const RandomWord<T> word, const RangeParameters<T> & range, RandomWord<T> & low) noexcept
+    {
+      const auto length = static_cast<RandomWord<T>>(range.length);
+      if constexpr (sizeof(RandomWord<T>) == sizeof(std::uint32_t))
+      {
+        const auto product = std::uint64_t(word) * length;
+        low = static_cast<RandomWord<T>>(product);
+        return static_cast<RandomWord<T>>(product >> 32);
+      }
+      else
+      {
+#if defined(__SIZEOF_INT128__)
+        const auto product = static_cast<WideArithmetic::Wide>(word) * length;
+        low = static_cast<RandomWord<T>>(product);
+        return static_cast<RandomWord<T>>(product >> 64);
+#else
+        low = static_cast<RandomWord<T>>(word * length);
+        return WideArithmetic::MultiplyHigh(word, length);
+#endif
+      }
+    }
+
+    template <typename T>
+    bool BoundRange(const RandomWord<T> * words, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept
+    {
+      using Offset = std::make_unsigned_t<T>;
+      bool suspect = false;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        RandomWord<T> low;
+        const auto offset = MultiplyWord(words[i], range, low);
+        output[i] = static_cast<T>(static_cast<Offset>(static_cast<Offset>(range.min) + static_cast<Offset>(offset)));
+        suspect |= low < range.length;
+      }
+
+      return suspect;
+    }
+  }
+
+#ifdef COMMON_MATH_X86
+  /**
+   * \brief Defines the kernels of 32-bit lanes in terms of the vector primitives of the enclosing namespace.
+   * Values are wrapped branch-free, the remainder is calculated for every lane and discarded for values in range
+   */
+#define COMMON_MATH_DEFINE_RANGE_KERNELS \
+  struct RangeVectors \
+  { \
+    Vector min, max, lastOffset, length, divisor, multiplier, minResidue, zero; \
+    __m128i shift; \
+    bool isSigned, add, powerOfTwo; \
+    template <typename T> \
+    explicit RangeVectors(const RangeParameters<T> & range) noexcept \
+      : min(Broadcast32(static_cast<std::uint32_t>(range.min))), \
+      max(Broadcast32(static_cast<std::uint32_t>(range.max))), \
+      lastOffset(Broadcast32(static_cast<std::uint32_t>(range.length - 1u))), \
+      length(Broadcast32(range.length)), \
+      divisor(Broadcast32(range.divisor.GetDivisor())), \
+      multiplier(Broadcast32(static_cast<std::uint32_t>(range.divisor.GetMultiplier()))), \
+      minResidue(Broadcast32(range.minResidue)), \
+      zero(Broadcast32(0)), \
+      shift(_mm_cvtsi32_si128(static_cast<int>(range.divisor.GetShift()))), \
+      isSigned(std::is_signed<T>::value), \
+      add(range.divisor.IsAdding()), \
+      powerOfTwo(range.divisor.GetMultiplier() == 0) { } \
+  }; \
+  inline Vector Remainder(const Vector value, const RangeVectors & range) noexcept \
+  { \
+    auto quotient = range.powerOfTwo ? value : MultiplyHigh32(value, range.multiplier); \
+    if (range.add) \
+      quotient = Add32(ShiftRightOne32(Subtract32(value, quotient)), quotient); \
+    quotient = ShiftRight32(quotient, range.shift); \
+    return Subtract32(value, MultiplyLow32(quotient, range.divisor)); \
+  } \
+  /* Returns the offset of the wrapped value from the minimum */ \
+  inline Vector AdjustOffset(const Vector value, const RangeVectors & range) noexcept \
+  { \
+    const auto offset = Subtract32(value, range.min); \
+    const auto above = range.isSigned ? GreaterSigned32(value, range.max) : GreaterUnsigned32(value, range.max); \
+    const auto remainder = Remainder(Select(above, offset, Subtract32(range.min, value)), range); \
+    const auto below = Select(Equal32(remainder, range.zero), range.zero, Subtract32(range.length, remainder)); \
+    return Select(GreaterUnsigned32(offset, range.lastOffset), Select(above, remainder, below), offset); \
+  } \
+  inline Vector AddOffsets(const Vector left, const Vector right, const RangeVectors & range) noexcept \
+  { \
+    const auto space = Subtract32(range.length, left); \
+    return Select(GreaterUnsigned32(space, right), Add32(left, right), Subtract32(right, space)); \
+  } \
+  inline Vector SubtractOffsets(const Vector left, const Vector right, const RangeVectors & range) noexcept \
+  { \
+    return Select(GreaterUnsigned32(right, left), Add32(left, Subtract32(range.length, right)), Subtract32(left, right)); \
+  } \
+  template <typename T> \
+  void AdjustRange(const T * values, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const RangeVectors vectors(range); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) \
+      Store32(output + i, Add32(vectors.min, AdjustOffset(Load32(values + i), vectors))); \
+    Scalar::AdjustRange(values + i, output + i, count - i, range); \
+  } \
+  template <typename T> \
+  void AddRange(const T * a, const T * b, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const RangeVectors vectors(range); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) \
+    { \
+      const auto sum = AddOffsets(AdjustOffset(Load32(a + i), vectors), AdjustOffset(Load32(b + i), vectors), vectors); \
+      Store32(output + i, Add32(vectors.min, AddOffsets(sum, vectors.minResidue, vectors))); \
+    } \
+    Scalar::AddRange(a + i, b + i, output + i, count - i, range); \
+  } \
+  template <typename T> \
+  void SubtractRange(const T * a, const T * b, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const RangeVectors vectors(range); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) \
+    { \
+      const auto difference = SubtractOffsets(AdjustOffset(Load32(a + i), vectors), AdjustOffset(Load32(b + i), vectors), vectors); \
+      Store32(output + i, Add32(vectors.min, SubtractOffsets(difference, vectors.minResidue, vectors))); \
+    } \
+    Scalar::SubtractRange(a + i, b + i, output + i, count - i, range); \
+  } \
+  template <typename T> \
+  void MultiplyRange(const T * a, const T * b, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept \
+  { \
+    /* Products of residues are reduced in 32-bit lanes if they cannot exceed them */ \
+    if (range.length == 0 || range.length > 0x10000u) \
+      return Scalar::MultiplyRange(a, b, output, count, range); \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const RangeVectors vectors(range); \
+    std::size_t i = 0; \
+    for (; i + width <= count; i += width) \
+    { \
+      const auto left = AddOffsets(AdjustOffset(Load32(a + i), vectors), vectors.minResidue, vectors); \
+      const auto right = AddOffsets(AdjustOffset(Load32(b + i), vectors), vectors.minResidue, vectors); \
+      const auto product = Remainder(MultiplyLow32(left, right), vectors); \
+      Store32(output + i, Add32(vectors.min, SubtractOffsets(product, vectors.minResidue, vectors))); \
+    } \
+    Scalar::MultiplyRange(a + i, b + i, output + i, count - i, range); \
+  } \
+  template <typename T> \
+  bool BoundRange(const RandomWord<T> * words, T * output, const std::size_t count, const RangeParameters<T> & range) noexcept \
+  { \
+    constexpr std::size_t width = VectorBytes / sizeof(T); \
+    const RangeVectors vectors(range); \
+    std::size_t i = 0; \
+    bool suspect = false; \
+    for (; i + width <= count; i += width) \
+    { \
+      const auto word = Load32(words + i); \
+      Store32(output + i, Add32(vectors.min, MultiplyHigh32(word, vectors.length))); \
+      suspect |= Any(GreaterUnsigned32(vectors.length, MultiplyLow32(word, vectors.length))); \
+    } \
+    return Scalar::BoundRange(words + i, output + i, count - i, range) || suspect; \
+  }
+
+  COMMON_MATH_TARGET_BEGIN("avx2,fma")
+  namespace Kernels::Avx2
+  {
+    using Vector = __m256i;
+
+    inline Vector Load32(const void * p) noexcept { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+    inline void Store32(void * p, const Vector v) noexcept { _mm256_storeu_si256(static_cast<__m256i *>(p), v); }
+    inline Vector Broadcast32(const std::uint32_t v) noexcept { return _mm256_set1_epi32(static_cast<int>(v)); }
+    inline Vector Add32(const Vector a, const Vector b) noexcept { return _mm256_add_epi32(a, b); }
+    inline Vector Subtract32(const Vector a, const Vector b) noexcept { return _mm256_sub_epi32(a, b); }
+    inline Vector MultiplyLow32(const Vector a, const Vector b) noexcept { return _mm256_mullo_epi32(a, b); }
+    inline Vector MultiplyHigh32(const Vector a, const Vector b) noexcept
+    {
+      // Even and odd lanes are multiplied separately into 64-bit products
+      const auto even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+      const auto odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+      return _mm256_blend_epi32(even, odd, 0xAA);
+    }
+    inline Vector ShiftRight32(const Vector a, const __m128i count) noexcept { return _mm256_srl_epi32(a, count); }
+    inline Vector ShiftRightOne32(const Vector a) noexcept { return _mm256_srli_epi32(a, 1); }
+    inline Vector GreaterSigned32(const Vector a, const Vector b) noexcept { return _mm256_cmpgt_epi32(a, b); }
+    inline Vector GreaterUnsigned32(const Vector a, const Vector b) noexcept
+    {
+      const auto sign = _mm256_set1_epi32(INT32_MIN);
+      return _mm256_cmpgt_epi32(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+    }
+    inline Vector Equal32(const Vector a, const Vector b) noexcept { return _mm256_cmpeq_epi32(a, b); }
+    inline Vector Select(const Vector mask, const Vector ifTrue, const Vector ifFalse) noexcept { return _mm256_blendv_epi8(ifFalse, ifTrue, mask); }
+    inline bool Any(const Vector mask) noexcept { return !_mm256_testz_si256(mask, mask); }
+
+    constexpr std::size_t VectorBytes = 32;
+
+    COMMON_MATH_DEFINE_RANGE_KERNELS
+  }
+  COMMON_MATH_TARGET_END
+
+  COMMON_MATH_TARGET_BEGIN("avx512f")
+  namespace Kernels::Avx512
+  {
+    using Vector = __m512i;
+
+    inline Vector Load32(const void * p) noexcept { return _mm512_loadu_si512(p); }
+    inline void Store32(void * p, const Vector v) noexcept { _mm512_storeu_si512(p, v); }
+    inline Vector Broadcast32(const std::uint32_t v) noexcept { return _mm512_set1_epi32(static_cast<int>(v)); }
+    inline Vector Add32(const Vector a, const Vector b) noexcept { return _mm512_add_epi32(a, b); }
+    inline Vector Subtract32(const Vector a, const Vector b) noexcept { return _mm512_sub_epi32(a, b); }
+    inline Vector MultiplyLow32(const Vector a, const Vector b) noexcept { return _mm512_mullo_epi32(a, b); }
+    // Zero-masking variants with all lanes selected, GCC warns about the undefined source of the plain ones
+    inline Vector MultiplyHigh32(const Vector a, const Vector b) noexcept
+    {
+      const auto even = _mm512_maskz_srli_epi64(0xFF, _mm512_maskz_mul_epu32(0xFF, a, b), 32);
+      const auto odd = _mm512_maskz_mul_epu32(0xFF, _mm512_maskz_srli_epi64(0xFF, a, 32), _mm512_maskz_srli_epi64(0xFF, b, 32));
+      return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+    }
+    inline Vector ShiftRight32(const Vector a, const __m128i count) noexcept { return _mm512_maskz_srl_epi32(0xFFFF, a, count); }
+    inline Vector ShiftRightOne32(const Vector a) noexcept { return _mm512_maskz_srli_epi32(0xFFFF, a, 1); }
+    inline __mmask16 GreaterSigned32(const Vector a, const Vector b) noexcept { return _mm512_cmpgt_epi32_mask(a, b); }
+    inline __mmask16 GreaterUnsigned32(const Vector a, const Vector b) noexcept { return _mm512_cmpgt_epu32_mask(a, b); }
+    inline __mmask16 Equal32(const Vector a, const Vector b) noexcept { return _mm512_cmpeq_epi32_mask(a, b); }
+    inline Vector Select(const __mmask16 mask, const Vector ifTrue, const Vector ifFalse) noexcept { return _mm512_mask_blend_epi32(mask, ifFalse, ifTrue); }
+    inline bool Any(const __mmask16 mask) noexcept { return mask != 0; }
+
+    constexpr std::size_t VectorBytes = 64;
+
+    COMMON_MATH_DEFINE_RANGE_KERNELS
+  }
+  COMMON_MATH_TARGET_END
+
+#undef COMMON_MATH_DEFINE_RANGE_KERNELS
+#endif
+
+  /**
+   * \brief Selects the kernels matching the instruction set chosen by the dispatcher. Only 32-bit values
+   * are vectorized, other types and instruction sets use the scalar kernels
+   * \tparam T Type of values
+   * \param instructionSet Instruction set to select the kernels for
+   * \return Kernels of the most capable variant not exceeding given instruction set
+   */
+  template <typename T>
+  RangeKernels<T> SelectRangeKernels(const InstructionSet instructionSet) noexcept
+  {
+#ifdef COMMON_MATH_X86
+    if constexpr (sizeof(T) == sizeof(std::uint32_t))
+      switch (instructionSet)
+      {
+      case InstructionSet::Avx512:
+        return { Kernels::Avx512::AdjustRange<T>, Kernels::Avx512::AddRange<T>, Kernels::Avx512::SubtractRange<T>, Kernels::Avx512::MultiplyRange<T>, Kernels::Avx512::BoundRange<T>, InstructionSet::Avx512 };
+      case InstructionSet::Avx2:
+        return { Kernels::Avx2::AdjustRange<T>, Kernels::Avx2::AddRange<T>, Kernels::Avx2::SubtractRange<T>, Kernels::Avx2::MultiplyRange<T>, Kernels::Avx2::BoundRange<T>, InstructionSet::Avx2 };
+      default:
+        break;
+      }
+#endif
+    (void)instructionSet;
+    return { Kernels::Scalar::AdjustRange<T>, Kernels::Scalar::AddRange<T>, Kernels::Scalar::SubtractRange<T>, Kernels::Scalar::MultiplyRange<T>, Kernels::Scalar::BoundRange<T>, InstructionSet::Scalar };
+  }
+
+  /**
+   * \brief Retrieves the kernels selected for the executing processor
+   * \tparam T Type of values
+   * \return Selected kernels
+   */
+  template <typename T>
+  const RangeKernels<T> & GetRangeKernels() noexcept
+  {
+    static const auto kernels = SelectRangeKernels<T>(Dispatch::GetInstructionSet());
+    return kernels;
+  }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <limits>
+#include <type_traits>
+
+/**
+ * \brief Policies deciding how NumberInRange brings values outside of its range back. Modular policies wrap
+ * offsets from the minimum modulo a period and fold them into the range, the others clamp exact results
+ */
+namespace Common::Math::RangePolicy
+{
+  /**
+   * \brief Wraps values around as min + (value - min) mod (max - min + 1)
+   */
+  class Wrap
+  {
+  protected:
+    static constexpr bool IsModular = true;
+
+    /**
+     * \brief Calculates the period of the wrapped offsets
+     * \param length Number of values in the range, zero if the range covers every value of the type
+     */
+    template <typename Offset>
+    static constexpr Offset CalcPeriod(const Offset length) noexcept { return length; }
+    template <typename Offset>
+    static constexpr bool IsValidLength(const Offset) noexcept { return true; }
+    /**
+     * \brief Maps an offset less than the period to an offset less than the length
+     */
+    template <typename Offset>
+    static constexpr Offset Fold(const Offset offset, const Offset, const Offset) noexcept { return offset; }
+    /**
+     * \brief Maps a distance from a bound to an offset when the period does not fit into the offset type, never
+     * the case for wrapped ranges
+     */
+    template <typename Offset>
+    static constexpr Offset FoldDistance(const Offset distance, const Offset) noexcept { return distance; }
+
+    constexpr void Report(const bool) noexcept { }
+  };
+
+  /**
+   * \brief Reflects values at the bounds back and forth, the values repeat with the period 2 * (max - min)
+   */
+  class Reflect
+  {
+  protected:
+    static constexpr bool IsModular = true;
+
+    template <typename Offset>
+    static constexpr Offset CalcPeriod(const Offset length) noexcept { return static_cast<Offset>(2u * static_cast<Offset>(length - 1u)); }
+    /**
+     * \brief The period must fit into the offset type
+     */
+    template <typename Offset>
+    static constexpr bool IsValidLength(const Offset length) noexcept
+    {
+      return length != 0 && static_cast<Offset>(length - 1u) <= std::numeric_limits<Offset>::max() / 2;
+    }
+    /**
+     * \brief Offsets past the last one run back from the maximum
+     */
+    template <typename Offset>
+    static constexpr Offset Fold(const Offset offset, const Offset length, const Offset period) noexcept
+    {
+      return offset >= length ? static_cast<Offset>(period - offset) : offset;
+    }
+    /**
+     * \brief Maps a distance from a bound to an offset from that bound when the period does not fit into the offset
+     * type. Every distance is then shorter than the period and is reflected at most once
+     */
+    template <typename Offset>
+    static constexpr Offset FoldDistance(const Offset distance, const Offset length) noexcept
+    {
+      const auto last = static_cast<Offset>(length - 1u);
+      return distance > last ? static_cast<Offset>(last - static_cast<Offset>(distance - last)) : distance;
+    }
+
+    constexpr void Report(const bool) noexcept { }
+  };
+
+  /**
+   * \brief Clamps results to the nearest bound, results overflowing the type saturate to its limits first
+   */
+  class Saturate
+  {
+  protected:
+    static constexpr bool IsModular = false;
+
+    template <typename Offset>
+    static constexpr Offset CalcPeriod(const Offset length) noexcept { return length; }
+    template <typename Offset>
+    static constexpr bool IsValidLength(const Offset) noexcept { return true; }
+    template <typename Offset>
+    static constexpr Offset Fold(const Offset offset, const Offset, const Offset) noexcept { return offset; }
+
+    constexpr void Report(const bool) noexcept { }
+  };
+
+  /**
+   * \brief Clamps results like Saturate and records every value assigned out of range in a sticky flag,
+   * nothing is thrown
+   */
+  class Checked : public Saturate
+  {
+    /**
+     * \brief True if a value out of range has been assigned since the flag was cleared
+     */
+    bool m_outOfRange = false;
+
+  public:
+    /**
+     * \brief Getter for the OutOfRange property
+     * \return True if a value out of range has been assigned since the flag was cleared
+     */
+    constexpr bool IsOutOfRange() const noexcept { return m_outOfRange; }
+    /**
+     * \brief Clears the OutOfRange flag
+     */
+    constexpr void ClearOutOfRange() noexcept { m_outOfRange = false; }
+
+  protected:
+    constexpr void Report(const bool outOfRange) noexcept { m_outOfRange |= outOfRange; }
+  };
+}
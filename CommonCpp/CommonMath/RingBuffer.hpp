@@ -0,0 +1,460 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "FastDivisor.hpp"
+
+#define NAMEOF(x) std::string(#x)
+
+namespace Common::Math
+{
+  /**
+   * \brief Bounded lock-free queue of a single producer and a single consumer. The head and the tail wrap around
+   * like NumberInRange<std::size_t>(0, 2 * capacity - 1), so a full buffer differs from an empty one without
+   * wasting a slot. Each side keeps its index on its own cache line with the last seen index of the other side,
+   * which it reloads only when the buffer seems full or empty. Power of two capacities wrap by masking.
+   * The assignment operators of T should not throw
+   * \tparam T Type of values
+   */
+  template <typename T>
+  class alignas(64) SpscRingBuffer
+  {
+    const std::size_t m_capacity;
+    /**
+     * \brief Capacity - 1 if the capacity is a power of two greater than one, zero otherwise
+     */
+    const std::size_t m_mask;
+    const std::unique_ptr<T[]> m_values;
+
+    /**
+     * \brief Index of the next value to pop, written by the consumer
+     */
+    alignas(64) std::atomic<std::size_t> m_head;
+    /**
+     * \brief Tail as last seen by the consumer
+     */
+    std::size_t m_cachedTail;
+    /**
+     * \brief Index of the next value to push, written by the producer
+     */
+    alignas(64) std::atomic<std::size_t> m_tail;
+    /**
+     * \brief Head as last seen by the producer
+     */
+    std::size_t m_cachedHead;
+
+    static std::size_t ValidateCapacity(const std::size_t capacity)
+    {
+      if (capacity == 0) throw std::invalid_argument("Argument " + NAMEOF(capacity) + " must be greater than zero.");
+      if (capacity > std::numeric_limits<std::size_t>::max() / 2) throw std::invalid_argument("Argument " + NAMEOF(capacity) + " is too large.");
+
+      return capacity;
+    }
+
+    static std::size_t CalcMask(const std::size_t capacity) noexcept
+    {
+      return capacity > 1 && (capacity & (capacity - 1)) == 0 ? capacity - 1 : 0;
+    }
+
+    std::size_t Advance(const std::size_t index, const std::size_t count) const noexcept
+    {
+      const auto next = index + count;
+      if (m_mask != 0)
+        return next & (2 * m_mask + 1);
+
+      return next >= 2 * m_capacity ? next - 2 * m_capacity : next;
+    }
+
+    std::size_t GetPosition(const std::size_t index) const noexcept
+    {
+      if (m_mask != 0)
+        return index & m_mask;
+
+      return index >= m_capacity ? index - m_capacity : index;
+    }
+
+    /**
+     * \brief Counts values between two indices
+     */
+    std::size_t GetDistance(const std::size_t from, const std::size_t to) const noexcept
+    {
+      if (m_mask != 0)
+        return (to - from) & (2 * m_mask + 1);
+
+      return to >= from ? to - from : to + 2 * m_capacity - from;
+    }
+
+    /**
+     * \brief Counts free slots at the tail, the head is reloaded only if fewer slots than wanted are known to be free
+     */
+    std::size_t GetFree(const std::size_t tail, const std::size_t count) noexcept
+    {
+      auto free = m_capacity - GetDistance(m_cachedHead, tail);
+      if (free < count)
+      {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        free = m_capacity - GetDistance(m_cachedHead, tail);
+      }
+
+      return std::min(free, count);
+    }
+
+    /**
+     * \brief Counts values at the head, the tail is reloaded only if fewer values than wanted are known to be available
+     */
+    std::size_t GetAvailable(const std::size_t head, const std::size_t count) noexcept
+    {
+      auto available = GetDistance(head, m_cachedTail);
+      if (available < count)
+      {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        available = GetDistance(head, m_cachedTail);
+      }
+
+      return std::min(available, count);
+    }
+
+    template <typename TValue>
+    bool Push(TValue && value)
+    {
+      const auto tail = m_tail.load(std::memory_order_relaxed);
+      if (GetFree(tail, 1) == 0)
+        return false;
+
+      m_values[GetPosition(tail)] = std::forward<TValue>(value);
+      m_tail.store(Advance(tail, 1), std::memory_order_release);
+      return true;
+    }
+
+  public:
+    /**
+     * \brief Default constructor
+     * \param capacity Maximum number of values held
+     */
+    explicit SpscRingBuffer(const std::size_t capacity)
+      : m_capacity(ValidateCapacity(capacity)),
+      m_mask(CalcMask(capacity)),
+      m_values(std::make_unique<T[]>(capacity)),
+      m_head(0),
+      m_cachedTail(0),
+      m_tail(0),
+      m_cachedHead(0) { }
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+    SpscRingBuffer & operator =(const SpscRingBuffer &) = delete;
+
+    /**
+     * \brief Getter for the Capacity property
+     * \return Maximum number of values held
+     */
+    std::size_t GetCapacity() const noexcept { return m_capacity; }
+    /**
+     * \brief Getter for the Size property, the count may be outdated while the other side runs
+     * \return Number of values held
+     */
+    std::size_t GetSize() const noexcept
+    {
+      const auto head = m_head.load(std::memory_order_acquire);
+      return GetDistance(head, m_tail.load(std::memory_order_acquire));
+    }
+    /**
+     * \brief Getter for the Empty property, the state may be outdated while the other side runs
+     * \return True if no value is held
+     */
+    bool IsEmpty() const noexcept { return GetSize() == 0; }
+
+    /**
+     * \brief Pushes a value, called by the producer only
+     * \param value Value to push
+     * \return False if the buffer is full
+     */
+    bool TryPush(const T & value) { return Push(value); }
+    /**
+     * \brief Pushes a value, called by the producer only
+     * \param value Value to move in
+     * \return False if the buffer is full, the value is not moved then
+     */
+    bool TryPush(T && value) { return Push(std::move(value)); }
+    /**
+     * \brief Pushes as many values as fit, the consumer sees them all at once. Called by the producer only
+     * \param values Values to push
+     * \param count Number of values
+     * \return Number of values pushed
+     */
+    std::size_t PushRange(const T * values, const std::size_t count)
+    {
+      const auto tail = m_tail.load(std::memory_order_relaxed);
+      const auto pushed = GetFree(tail, count);
+
+      // The free slots are contiguous up to the end of the storage and continue from its beginning
+      const auto position = GetPosition(tail);
+      const auto first = std::min(pushed, m_capacity - position);
+      std::copy(values, values + first, m_values.get() + position);
+      std::copy(values + first, values + pushed, m_values.get());
+
+      m_tail.store(Advance(tail, pushed), std::memory_order_release);
+      return pushed;
+    }
+
+    /**
+     * \brief Pops a value, called by the consumer only
+     * \param value Popped value
+     * \return False if the buffer is empty
+     */
+    bool TryPop(T & value)
+    {
+      const auto head = m_head.load(std::memory_order_relaxed);
+      if (GetAvailable(head, 1) == 0)
+        return false;
+
+      value = std::move(m_values[GetPosition(head)]);
+      m_head.store(Advance(head, 1), std::memory_order_release);
+      return true;
+    }
+    /**
+     * \brief Pops as many values as available up to the count, called by the consumer only
+     * \param output Popped values
+     * \param count Maximum number of values
+     * \return Number of values popped
+     */
+    std::size_t PopRange(T * output, const std::size_t count)
+    {
+      const auto head = m_head.load(std::memory_order_relaxed);
+      const auto popped = GetAvailable(head, count);
+
+      const auto position = GetPosition(head);
+      const auto first = std::min(popped, m_capacity - position);
+      std::move(m_values.get() + position, m_values.get() + position + first, output);
+      std::move(m_values.get(), m_values.get() + (popped - first), output + first);
+
+      m_head.store(Advance(head, popped), std::memory_order_release);
+      return popped;
+    }
+  };
+
+  /**
+   * \brief Bounded lock-free queue of any number of producers and consumers. Every slot carries a sequence number
+   * telling the lap in which it may be written or read, producers and consumers claim positions by compare and swap
+   * of the tail or the head. The counters run freely and map to slots by the remainder of the capacity,
+   * by masking for power of two capacities. The assignment operators of T should not throw
+   * \tparam T Type of values
+   */
+  template <typename T>
+  class alignas(64) MpmcRingBuffer
+  {
+    struct Cell
+    {
+      /**
+       * \brief Equals the counter of the producer allowed to write the cell, or that counter + 1 after it was written
+       */
+      std::atomic<std::size_t> sequence;
+      T value;
+    };
+
+    const std::size_t m_capacity;
+    /**
+     * \brief Capacity - 1 if the capacity is a power of two, zero otherwise
+     */
+    const std::size_t m_mask;
+    const FastDivisor<std::size_t> m_divisor;
+    const std::unique_ptr<Cell[]> m_cells;
+
+    /**
+     * \brief Counter of the next value to pop
+     */
+    alignas(64) std::atomic<std::size_t> m_head;
+    /**
+     * \brief Counter of the next value to push
+     */
+    alignas(64) std::atomic<std::size_t> m_tail;
+
+    static std::size_t ValidateCapacity(const std::size_t capacity)
+    {
+      // A single cell would carry the same sequence number after it was written and after it was read
+      if (capacity < 2) throw std::invalid_argument("Argument " + NAMEOF(capacity) + " must be greater than one.");
+      if (capacity > std::numeric_limits<std::size_t>::max() / 2) throw std::invalid_argument("Argument " + NAMEOF(capacity) + " is too large.");
+
+      return capacity;
+    }
+
+    static std::size_t CalcMask(const std::size_t capacity) noexcept
+    {
+      return (capacity & (capacity - 1)) == 0 ? capacity - 1 : 0;
+    }
+
+    Cell & GetCell(const std::size_t counter) const noexcept
+    {
+      return m_cells[m_mask != 0 ? counter & m_mask : m_divisor.Remainder(counter)];
+    }
+
+    /**
+     * \brief Difference of a sequence number and the expected one, negative if the cell is a lap behind
+     */
+    static std::ptrdiff_t GetLag(const std::size_t sequence, const std::size_t expected) noexcept
+    {
+      return static_cast<std::ptrdiff_t>(sequence - expected);
+    }
+
+    /**
+     * \brief Claims up to count consecutive cells whose sequence numbers are ready
+     * \param index Head or tail to advance
+     * \param counter Counter to claim from, updated to the current one if another thread claimed it first
+     * \param count Maximum number of cells, at most the capacity
+     * \param offset Difference of the ready sequence number and the counter of the cell
+     * \return Number of cells claimed starting at the counter, zero if the buffer is full or empty
+     */
+    std::size_t Claim(std::atomic<std::size_t> & index, std::size_t & counter, const std::size_t count, const std::size_t offset) noexcept
+    {
+      for (;;)
+      {
+        const auto lag = GetLag(GetCell(counter).sequence.load(std::memory_order_acquire), counter + offset);
+        if (lag == 0)
+        {
+          std::size_t claimed = 1;
+          while (claimed < count && GetCell(counter + claimed).sequence.load(std::memory_order_acquire) == counter + claimed + offset)
+            ++claimed;
+          if (index.compare_exchange_weak(counter, counter + claimed, std::memory_order_relaxed))
+            return claimed;
+        }
+        // The cell is a lap behind if the buffer is full or empty
+        else if (lag < 0)
+        {
+          const auto current = index.load(std::memory_order_relaxed);
+          if (current == counter)
+            return 0;
+          counter = current;
+        }
+        else
+          counter = index.load(std::memory_order_relaxed);
+      }
+    }
+
+    template <typename TValue>
+    bool Push(TValue && value)
+    {
+      auto tail = m_tail.load(std::memory_order_relaxed);
+      if (Claim(m_tail, tail, 1, 0) == 0)
+        return false;
+
+      auto & cell = GetCell(tail);
+      cell.value = std::forward<TValue>(value);
+      cell.sequence.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+  public:
+    /**
+     * \brief Default constructor
+     * \param capacity Maximum number of values held
+     */
+    explicit MpmcRingBuffer(const std::size_t capacity)
+      : m_capacity(ValidateCapacity(capacity)),
+      m_mask(CalcMask(capacity)),
+      m_divisor(capacity),
+      m_cells(std::make_unique<Cell[]>(capacity)),
+      m_head(0),
+      m_tail(0)
+    {
+      for (std::size_t i = 0; i < capacity; ++i)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+    MpmcRingBuffer & operator =(const MpmcRingBuffer &) = delete;
+
+    /**
+     * \brief Getter for the Capacity property
+     * \return Maximum number of values held
+     */
+    std::size_t GetCapacity() const noexcept { return m_capacity; }
+    /**
+     * \brief Getter for the Size property, the count may be outdated while other threads run
+     * \return Number of values claimed by producers and not yet by consumers
+     */
+    std::size_t GetSize() const noexcept
+    {
+      const auto head = m_head.load(std::memory_order_acquire);
+      const auto lag = GetLag(m_tail.load(std::memory_order_acquire), head);
+      return lag < 0 ? 0 : std::min(static_cast<std::size_t>(lag), m_capacity);
+    }
+    /**
+     * \brief Getter for the Empty property, the state may be outdated while other threads run
+     * \return True if no value is held
+     */
+    bool IsEmpty() const noexcept { return GetSize() == 0; }
+
+    /**
+     * \brief Pushes a value
+     * \param value Value to push
+     * \return False if the buffer is full
+     */
+    bool TryPush(const T & value) { return Push(value); }
+    /**
+     * \brief Pushes a value
+     * \param value Value to move in
+     * \return False if the buffer is full, the value is not moved then
+     */
+    bool TryPush(T && value) { return Push(std::move(value)); }
+    /**
+     * \brief Pushes as many values as fit by a single claim, the values stay consecutive
+     * \param values Values to push
+     * \param count Number of values
+     * \return Number of values pushed
+     */
+    std::size_t PushRange(const T * values, const std::size_t count)
+    {
+      auto tail = m_tail.load(std::memory_order_relaxed);
+      const auto pushed = count == 0 ? 0 : Claim(m_tail, tail, std::min(count, m_capacity), 0);
+      for (std::size_t i = 0; i < pushed; ++i)
+      {
+        auto & cell = GetCell(tail + i);
+        cell.value = values[i];
+        cell.sequence.store(tail + i + 1, std::memory_order_release);
+      }
+
+      return pushed;
+    }
+
+    /**
+     * \brief Pops a value
+     * \param value Popped value
+     * \return False if the buffer is empty
+     */
+    bool TryPop(T & value)
+    {
+      auto head = m_head.load(std::memory_order_relaxed);
+      if (Claim(m_head, head, 1, 1) == 0)
+        return false;
+
+      auto & cell = GetCell(head);
+      value = std::move(cell.value);
+      cell.sequence.store(head + m_capacity, std::memory_order_release);
+      return true;
+    }
+    /**
+     * \brief Pops as many consecutive values as available up to the count by a single claim
+     * \param output Popped values
+     * \param count Maximum number of values
+     * \return Number of values popped
+     */
+    std::size_t PopRange(T * output, const std::size_t count)
+    {
+      auto head = m_head.load(std::memory_order_relaxed);
+      const auto popped = count == 0 ? 0 : Claim(m_head, head, std::min(count, m_capacity), 1);
+      for (std::size_t i = 0; i < popped; ++i)
+      {
+        auto & cell = GetCell(head + i);
+        output[i] = std::move(cell.value);
+        cell.sequence.store(head + i + m_capacity, std::memory_order_release);
+      }
+
+      return popped;
+    }
+  };
+}
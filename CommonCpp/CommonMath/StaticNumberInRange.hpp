@@ -0,0 +1,297 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include "WideArithmetic.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Keeps an integer value in a range given at compile time. Only the value is stored and all arithmetic
+   * is constexpr, a range with a power of two length wraps by masking
+   * \tparam T Type of value. Anything but integer types are prohibited.
+   * \tparam Min Range minimum
+   * \tparam Max Range maximum
+   */
+  template <typename T, T Min, T Max, typename = std::enable_if_t<std::is_arithmetic<T>::value && std::numeric_limits<T>::is_integer>>
+  class StaticNumberInRange
+  {
+    static_assert(Min < Max, "StaticNumberInRange: Min must be less than Max.");
+
+    /**
+     * \brief Type of offsets from the minimum, unsigned arithmetic wraps instead of overflowing
+     */
+    using Offset = std::make_unsigned_t<T>;
+    /**
+     * \brief Unsigned type of at least int size, products of narrower offsets would be promoted to signed int
+     */
+    using Product = std::common_type_t<Offset, unsigned>;
+
+    /**
+     * \brief Number of values in the range, zero if the range covers every value of T
+     */
+    static constexpr Offset Length = static_cast<Offset>(static_cast<Offset>(static_cast<Offset>(Max) - static_cast<Offset>(Min)) + 1u);
+    /**
+     * \brief True if the offsets can be reduced by masking, the length then divides the modulus of the unsigned arithmetic
+     */
+    static constexpr bool IsPowerOfTwo = (Length & static_cast<Offset>(Length - 1u)) == 0;
+    /**
+     * \brief Residue of the minimum modulo the length, the offset of a sum is shifted by it
+     */
+    static constexpr Offset MinimumResidue = IsPowerOfTwo ? 0 : static_cast<Offset>(Min >= 0
+      ? static_cast<Offset>(Min) % Length
+      : static_cast<Offset>(Length - static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(Min)) % Length) % Length);
+
+    /**
+     * \brief Largest magnitude of a value in range
+     */
+    static constexpr Offset Bound = std::max(Min < 0 ? static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(Min)) : static_cast<Offset>(Min),
+      Max < 0 ? static_cast<Offset>(static_cast<Offset>(0) - static_cast<Offset>(Max)) : static_cast<Offset>(Max));
+    /**
+     * \brief True if the product of any two values in range fits into T
+     */
+    static constexpr bool ProductFits = Bound == 0 || Bound <= static_cast<Offset>(std::numeric_limits<T>::max()) / Bound;
+
+    /**
+     * \brief Value in range
+     */
+    T m_value;
+
+    static constexpr T FromOffset(const Offset offset) noexcept
+    {
+      return static_cast<T>(static_cast<Offset>(static_cast<Offset>(Min) + offset));
+    }
+    static constexpr Offset GetOffset(const T value) noexcept
+    {
+      return static_cast<Offset>(static_cast<Offset>(value) - static_cast<Offset>(Min));
+    }
+    /**
+     * \brief Adds offsets modulo the length without overflowing
+     */
+    static constexpr Offset AddOffsets(const Offset left, const Offset right) noexcept
+    {
+      const auto space = static_cast<Offset>(Length - left);
+      return right >= space ? static_cast<Offset>(right - space) : static_cast<Offset>(left + right);
+    }
+    /**
+     * \brief Subtracts offsets modulo the length without overflowing
+     */
+    static constexpr Offset SubtractOffsets(const Offset left, const Offset right) noexcept
+    {
+      return left >= right ? static_cast<Offset>(left - right) : static_cast<Offset>(left + static_cast<Offset>(Length - right));
+    }
+
+    /**
+     * \brief Multiplies residues modulo the length, the product is calculated in a wider type or by doubling
+     * so it never overflows
+     */
+    static constexpr Offset MultiplyResidues(const Offset left, const Offset right) noexcept
+    {
+      if constexpr (sizeof(Offset) < sizeof(std::uint64_t) || Length <= 0x100000000u)
+        return static_cast<Offset>(static_cast<std::uint64_t>(left) * right % Length);
+      else
+      {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<Offset>(static_cast<WideArithmetic::Wide>(left) * right % Length);
+#else
+        Offset result = 0, addend = left;
+        for (auto factor = right; factor != 0; factor >>= 1)
+        {
+          if (factor & 1u)
+            result = AddOffsets(result, addend);
+          addend = AddOffsets(addend, addend);
+        }
+        return result;
+#endif
+      }
+    }
+
+    /**
+     * \brief Reduces two's complement bits of a value, exact for any value if the length is a power of two
+     * \param bits Value converted to the unsigned type
+     * \return Value in range
+     */
+    static constexpr T AdjustBits(const Offset bits) noexcept
+    {
+      if constexpr (IsPowerOfTwo)
+        return FromOffset(static_cast<Offset>(static_cast<Offset>(bits - static_cast<Offset>(Min)) & static_cast<Offset>(Length - 1u)));
+      else
+        return AdjustValue(static_cast<T>(bits));
+    }
+
+  public:
+    /**
+     * \brief Constructs the value equal to the range minimum
+     */
+    constexpr StaticNumberInRange() noexcept
+      : m_value(Min) { }
+    /**
+     * \brief Constructs the value wrapped into the range
+     * \param value Value to hold
+     */
+    constexpr explicit StaticNumberInRange(const T value) noexcept
+      : m_value(AdjustValue(value)) { }
+
+    /**
+     * \brief Getter for the Min property
+     * \return Range Minimum
+     */
+    static constexpr T GetMin() noexcept { return Min; }
+    /**
+     * \brief Getter for the Max property
+     * \return Range Maximum
+     */
+    static constexpr T GetMax() noexcept { return Max; }
+
+    /**
+     * \brief Getter for the Value property
+     * \return Value
+     */
+    constexpr T GetValue() const noexcept { return m_value; }
+    /**
+     * \brief Setter for the Value property
+     * \param value New value to set
+     */
+    constexpr void SetValue(const T value) noexcept { m_value = AdjustValue(value); }
+
+    /**
+     * \brief Wraps a value into the range as Min + (value - Min) mod (Max - Min + 1)
+     * \param value Value to wrap
+     * \return Value in range
+     */
+    static constexpr T AdjustValue(const T value) noexcept
+    {
+      if constexpr (IsPowerOfTwo)
+        return AdjustBits(static_cast<Offset>(value));
+      else
+      {
+        if (value >= Min && value <= Max)
+          return value;
+
+        // Distances from the minimum are exact in the unsigned type whichever side the value lies on
+        if (value > Max)
+          return FromOffset(static_cast<Offset>(GetOffset(value) % Length));
+
+        const auto remainder = static_cast<Offset>(static_cast<Offset>(static_cast<Offset>(Min) - static_cast<Offset>(value)) % Length);
+        return FromOffset(remainder == 0 ? Offset(0) : static_cast<Offset>(Length - remainder));
+      }
+    }
+
+    constexpr StaticNumberInRange operator +(const T other) const noexcept { return *this + StaticNumberInRange(other); }
+    constexpr StaticNumberInRange operator +(const StaticNumberInRange other) const noexcept
+    {
+      // (a + b - Min) mod Length equals the sum of both offsets and of the residue of Min
+      if constexpr (IsPowerOfTwo)
+        return FromAdjusted(AdjustBits(static_cast<Offset>(static_cast<Offset>(m_value) + static_cast<Offset>(other.m_value))));
+      else
+        return FromAdjusted(FromOffset(AddOffsets(AddOffsets(GetOffset(m_value), GetOffset(other.m_value)), MinimumResidue)));
+    }
+
+    constexpr StaticNumberInRange operator -(const T other) const noexcept { return *this - StaticNumberInRange(other); }
+    constexpr StaticNumberInRange operator -(const StaticNumberInRange other) const noexcept
+    {
+      if constexpr (IsPowerOfTwo)
+        return FromAdjusted(AdjustBits(static_cast<Offset>(static_cast<Offset>(m_value) - static_cast<Offset>(other.m_value))));
+      else
+        return FromAdjusted(FromOffset(SubtractOffsets(SubtractOffsets(GetOffset(m_value), GetOffset(other.m_value)), MinimumResidue)));
+    }
+
+    constexpr StaticNumberInRange operator *(const T other) const noexcept { return *this * StaticNumberInRange(other); }
+    /**
+     * \brief Multiplies the values without overflowing, a power of two length keeps the low bits of the product.
+     * Other lengths wrap the product directly if it fits into T and multiply the residues of both values otherwise
+     */
+    constexpr StaticNumberInRange operator *(const StaticNumberInRange other) const noexcept
+    {
+      if constexpr (IsPowerOfTwo)
+        return FromAdjusted(AdjustBits(static_cast<Offset>(static_cast<Product>(static_cast<Offset>(m_value)) * static_cast<Offset>(other.m_value))));
+      else if constexpr (ProductFits)
+        return FromAdjusted(AdjustValue(static_cast<T>(m_value * other.m_value)));
+      else
+      {
+        const auto left = AddOffsets(GetOffset(m_value), MinimumResidue);
+        const auto right = AddOffsets(GetOffset(other.m_value), MinimumResidue);
+        return FromAdjusted(FromOffset(SubtractOffsets(MultiplyResidues(left, right), MinimumResidue)));
+      }
+    }
+
+    constexpr StaticNumberInRange operator /(const T other) const { return *this / StaticNumberInRange(other); }
+    constexpr StaticNumberInRange operator /(const StaticNumberInRange other) const
+    {
+      return StaticNumberInRange(static_cast<T>(m_value / other.m_value));
+    }
+
+    constexpr StaticNumberInRange operator %(const T other) const { return *this % StaticNumberInRange(other); }
+    constexpr StaticNumberInRange operator %(const StaticNumberInRange other) const
+    {
+      return StaticNumberInRange(static_cast<T>(m_value % other.m_value));
+    }
+
+    constexpr StaticNumberInRange & operator +=(const T other) noexcept { return *this = *this + other; }
+    constexpr StaticNumberInRange & operator -=(const T other) noexcept { return *this = *this - other; }
+    constexpr StaticNumberInRange & operator *=(const T other) noexcept { return *this = *this * other; }
+
+    /**
+     * \brief Advances the value, the maximum wraps to the minimum
+     * \return Advanced value
+     */
+    constexpr StaticNumberInRange & operator ++() noexcept
+    {
+      if constexpr (IsPowerOfTwo)
+        m_value = AdjustBits(static_cast<Offset>(static_cast<Offset>(m_value) + 1u));
+      else
+        m_value = m_value == Max ? Min : static_cast<T>(m_value + 1);
+      return *this;
+    }
+    constexpr StaticNumberInRange operator ++(int) noexcept
+    {
+      const auto result = *this;
+      ++*this;
+      return result;
+    }
+    /**
+     * \brief Moves the value back, the minimum wraps to the maximum
+     * \return Moved value
+     */
+    constexpr StaticNumberInRange & operator --() noexcept
+    {
+      if constexpr (IsPowerOfTwo)
+        m_value = AdjustBits(static_cast<Offset>(static_cast<Offset>(m_value) - 1u));
+      else
+        m_value = m_value == Min ? Max : static_cast<T>(m_value - 1);
+      return *this;
+    }
+    constexpr StaticNumberInRange operator --(int) noexcept
+    {
+      const auto result = *this;
+      --*this;
+      return result;
+    }
+
+    constexpr bool operator ==(const StaticNumberInRange other) const noexcept { return m_value == other.m_value; }
+    constexpr bool operator !=(const StaticNumberInRange other) const noexcept { return m_value != other.m_value; }
+
+    std::string ToString() const
+    {
+      std::ostringstream oss;
+      oss << m_value;
+      return oss.str();
+    }
+
+  private:
+    /**
+     * \brief Wraps an adjusted value without reducing it again
+     * \param value Value in range
+     * \return Instance holding the value
+     */
+    static constexpr StaticNumberInRange FromAdjusted(const T value) noexcept
+    {
+      StaticNumberInRange result;
+      result.m_value = value;
+      return result;
+    }
+  };
+}
@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Accumulation.hpp"
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Square symmetric matrix storing only its upper triangle, packed row after row. Every stored value
+   * off the main diagonal stands for both of its mirrored positions
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class SymmetricMatrix
+  {
+    static_assert(std::is_arithmetic<T>::value, "Packed matrices can only store arithmetic types.");
+
+    /**
+     * \brief Number of rows and columns
+     */
+    unsigned m_size;
+    /**
+     * \brief Upper triangle, n * (n + 1) / 2 values
+     */
+    std::vector<T> m_values;
+
+    static unsigned ValidateSize(const unsigned size)
+    {
+      if (size == 0)
+        throw std::invalid_argument("Size must be greater than 0.");
+
+      return size;
+    }
+
+    std::size_t GetRowOffset(const unsigned row) const noexcept
+    {
+      return std::size_t(row) * (2 * std::size_t(m_size) - row + 1) / 2;
+    }
+
+  public:
+    /**
+     * \brief Constructs a zero matrix
+     * \param size Number of rows and columns
+     */
+    explicit SymmetricMatrix(const unsigned size)
+      : m_size(ValidateSize(size)),
+      m_values(std::size_t(size) * (size + 1) / 2) { }
+    /**
+     * \brief Copies the upper triangle of a square matrix, values below the main diagonal are ignored
+     * \param matrix Matrix to copy from
+     */
+    explicit SymmetricMatrix(const Matrix<T> & matrix)
+      : SymmetricMatrix(matrix.GetRows())
+    {
+      if (matrix.GetRows() != matrix.GetColumns())
+        throw std::invalid_argument("Argument " + NAMEOF(matrix) + " must be a NxN matrix.");
+
+      const auto & values = matrix.GetMatrixValues();
+      for (unsigned i = 0; i < m_size; ++i)
+        std::copy(values[i].begin() + i, values[i].end(), m_values.begin() + GetRowOffset(i));
+    }
+
+    /**
+     * \brief Getter method for the Size property
+     * \return Number of rows and columns
+     */
+    unsigned GetSize() const noexcept { return m_size; }
+    /**
+     * \brief Getter method for the MatrixType property
+     * \return Type of the matrix
+     */
+    Type GetMatrixType() const noexcept { return Type::Invertable | Type::Symmetric; }
+    /**
+     * \brief Getter method for the PackedValues property
+     * \return Stored upper triangle, row after row
+     */
+    const std::vector<T> & GetPackedValues() const noexcept { return m_values; }
+    /**
+     * \brief Retrieves the stored values of a row
+     * \param row Index of the row
+     * \return Pointer to the value on the main diagonal, followed by the values to its right
+     */
+    const T * GetRow(const unsigned row) const noexcept { return m_values.data() + GetRowOffset(row); }
+
+    /**
+     * \brief Retrieves a single value
+     * \param row Index of the row
+     * \param column Index of the column
+     * \return Value at given position
+     */
+    T Get(const unsigned row, const unsigned column) const noexcept
+    {
+      const auto first = std::min(row, column);
+      return m_values[GetRowOffset(first) + std::max(row, column) - first];
+    }
+    /**
+     * \brief Changes a value together with its mirrored counterpart
+     * \param row Index of the row
+     * \param column Index of the column
+     * \param value Value to set
+     */
+    void Set(const unsigned row, const unsigned column, const T value)
+    {
+      if (row >= m_size || column >= m_size)
+        throw std::invalid_argument("Position is outside of the matrix.");
+
+      const auto first = std::min(row, column);
+      m_values[GetRowOffset(first) + std::max(row, column) - first] = value;
+    }
+
+    /**
+     * \brief Calculates the determinant by Gaussian elimination with partial pivoting in O(n^3)
+     * \return Determinant of the matrix
+     */
+    double GetDeterminant() const
+    {
+      // Pivoting breaks the symmetry, the elimination runs on a full copy
+      std::vector<std::vector<double>> values(m_size, std::vector<double>(m_size));
+      for (unsigned i = 0; i < m_size; ++i)
+        for (unsigned j = 0; j < m_size; ++j)
+          values[i][j] = static_cast<double>(Get(i, j));
+
+      const auto & kernels = GetMatrixKernels<double>();
+      double determinant = 1;
+      for (unsigned k = 0; k < m_size; ++k)
+      {
+        auto pivot = k;
+        for (auto i = k + 1; i < m_size; ++i)
+          if (std::abs(values[i][k]) > std::abs(values[pivot][k]))
+            pivot = i;
+        if (values[pivot][k] == 0)
+          return 0;
+        if (pivot != k)
+        {
+          std::swap(values[pivot], values[k]);
+          determinant = -determinant;
+        }
+
+        determinant *= values[k][k];
+        for (auto i = k + 1; i < m_size; ++i)
+          kernels.multiplyAdd(-values[i][k] / values[k][k], values[k].data() + k, values[i].data() + k, m_size - k);
+      }
+
+      return determinant;
+    }
+
+    /**
+     * \brief Decides whether the matrix is singular from its determinant in O(n^3)
+     * \return True if the matrix has no inverse
+     */
+    bool IsSingular() const { return GetDeterminant() == 0; }
+
+    /**
+     * \brief Expands the matrix into full storage
+     * \return Matrix with both triangles
+     */
+    Matrix<T> ToMatrix() const
+    {
+      std::vector<std::vector<T>> values(m_size, std::vector<T>(m_size));
+      for (unsigned i = 0; i < m_size; ++i)
+      {
+        const auto * row = GetRow(i);
+        for (auto j = i; j < m_size; ++j)
+          values[i][j] = values[j][i] = row[j - i];
+      }
+
+      return Matrix<T>(std::move(values));
+    }
+
+    /**
+     * \brief Multiplies the matrix by a column vector. Each stored row contributes to its own output value
+     * and, mirrored, to the output values below it
+     * \param vector Values of the vector, one per column
+     * \return Values of the product, one per row
+     */
+    std::vector<T> operator * (const std::vector<T> & vector) const
+    {
+      if (vector.size() != m_size)
+        throw MatrixDimensionException("Number of columns of the matrix must match size of the vector.");
+
+      const auto & kernels = GetMatrixKernels<T>();
+      std::vector<T> output(m_size);
+      for (unsigned i = 0; i < m_size; ++i)
+      {
+        const auto * row = GetRow(i);
+        output[i] = static_cast<T>(output[i] + Reduction::Dot(row, vector.data() + i, m_size - i));
+        kernels.multiplyAdd(vector[i], row + 1, output.data() + i + 1, m_size - i - 1);
+      }
+
+      return output;
+    }
+    /**
+     * \brief Multiplies the matrix by a full matrix
+     * \param other Right operand
+     * \return Product of the matrices
+     */
+    Matrix<T> operator * (const Matrix<T> & other) const
+    {
+      if (other.GetRows() != m_size)
+        throw MatrixDimensionException("Number of columns of the left operand must match number of rows of the right operand.");
+
+      const auto & kernels = GetMatrixKernels<T>();
+      const auto & values = other.GetMatrixValues();
+      const auto columns = other.GetColumns();
+      std::vector<std::vector<T>> outputValues(m_size, std::vector<T>(columns));
+      for (unsigned i = 0; i < m_size; ++i)
+      {
+        const auto * row = GetRow(i);
+        kernels.multiplyAdd(row[0], values[i].data(), outputValues[i].data(), columns);
+        for (auto j = i + 1; j < m_size; ++j)
+        {
+          kernels.multiplyAdd(row[j - i], values[j].data(), outputValues[i].data(), columns);
+          kernels.multiplyAdd(row[j - i], values[i].data(), outputValues[j].data(), columns);
+        }
+      }
+
+      return Matrix<T>(std::move(outputValues));
+    }
+  };
+}
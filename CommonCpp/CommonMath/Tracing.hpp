@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Common::Math
+{
+  /**
+   * \brief Completed trace scope
+   */
+  struct TraceEvent
+  {
+    /**
+     * \brief Name of the scope, a string literal
+     */
+    const char * name;
+    /**
+     * \brief Start of the scope in nanoseconds since the tracing epoch
+     */
+    std::uint64_t start;
+    /**
+     * \brief Duration of the scope in nanoseconds
+     */
+    std::uint64_t duration;
+    /**
+     * \brief Size of the processed problem, zero if not applicable
+     */
+    std::uint64_t size;
+  };
+
+  /**
+   * \brief Opt-in tracing of long-running Matrix operations. The scopes are compiled only when COMMON_MATH_TRACING
+   * is defined. Each thread records into its own ring buffer keeping the most recent events, the buffers are
+   * written as Chrome Trace Event JSON which can be opened in chrome://tracing or Perfetto. The events of exited
+   * threads are moved into a bounded store and their buffers are released
+   */
+  class Tracing
+  {
+  public:
+    /**
+     * \brief Number of most recent events kept per thread
+     */
+    static constexpr std::size_t Capacity = 4096;
+    /**
+     * \brief Number of most recent events kept from all exited threads together
+     */
+    static constexpr std::size_t RetiredCapacity = 4 * Capacity;
+
+  private:
+    /**
+     * \brief Ring buffer written by its owning thread only. Fields are relaxed atomics so that a concurrent
+     * flush never races, events overwritten while being copied are discarded by re-reading the reserved index
+     */
+    struct ThreadBuffer
+    {
+      struct Slot
+      {
+        std::atomic<const char *> name { nullptr };
+        std::atomic<std::uint64_t> start { 0 };
+        std::atomic<std::uint64_t> duration { 0 };
+        std::atomic<std::uint64_t> size { 0 };
+      };
+
+      unsigned threadId;
+      /**
+       * \brief Number of completed events
+       */
+      std::atomic<std::uint64_t> head { 0 };
+      /**
+       * \brief Number of started writes, one ahead of the head while an event is being written
+       */
+      std::atomic<std::uint64_t> reserved { 0 };
+      /**
+       * \brief Events before this index were discarded
+       */
+      std::atomic<std::uint64_t> cleared { 0 };
+      std::array<Slot, Capacity> slots;
+
+      explicit ThreadBuffer(const unsigned id) noexcept : threadId(id) { }
+
+      void Push(const TraceEvent & event) noexcept
+      {
+        const auto index = head.load(std::memory_order_relaxed);
+        reserved.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto & slot = slots[index % Capacity];
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.start.store(event.start, std::memory_order_relaxed);
+        slot.duration.store(event.duration, std::memory_order_relaxed);
+        slot.size.store(event.size, std::memory_order_relaxed);
+        head.store(index + 1, std::memory_order_release);
+      }
+
+      std::vector<TraceEvent> Read() const
+      {
+        const auto last = head.load(std::memory_order_acquire);
+        const auto first = std::max<std::uint64_t>(last > Capacity ? last - Capacity : 0, cleared.load(std::memory_order_relaxed));
+
+        std::vector<TraceEvent> events;
+        events.reserve(static_cast<std::size_t>(last > first ? last - first : 0));
+        for (auto i = first; i < last; ++i)
+        {
+          const auto & slot = slots[i % Capacity];
+          events.push_back({ slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+            slot.duration.load(std::memory_order_relaxed), slot.size.load(std::memory_order_relaxed) });
+        }
+
+        // Slots reused by the owning thread while copying hold mixed events
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto current = reserved.load(std::memory_order_relaxed);
+        const auto overwritten = current > Capacity + first ? current - Capacity - first : 0;
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(std::min<std::uint64_t>(overwritten, events.size())));
+
+        return events;
+      }
+    };
+
+    struct RetiredThread
+    {
+      unsigned threadId;
+      std::vector<TraceEvent> events;
+    };
+
+    struct Registry
+    {
+      std::mutex mutex;
+      /**
+       * \brief Buffers of running threads which have traced
+       */
+      std::vector<ThreadBuffer *> threads;
+      /**
+       * \brief Events of exited threads, oldest first
+       */
+      std::deque<RetiredThread> retired;
+      std::size_t retiredEvents = 0;
+      unsigned nextThreadId = 1;
+      std::atomic<bool> enabled { true };
+      const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+      /**
+       * \brief Keeps the events of an exited thread, dropping the oldest retired events over the capacity
+       * \remarks Called with the mutex locked
+       */
+      void Retire(const unsigned threadId, std::vector<TraceEvent> && events)
+      {
+        if (events.empty())
+          return;
+
+        const auto count = events.size();
+        retired.push_back({ threadId, std::move(events) });
+        retiredEvents += count;
+
+        while (retiredEvents > RetiredCapacity)
+        {
+          auto & oldest = retired.front().events;
+          const auto dropped = std::min(oldest.size(), retiredEvents - RetiredCapacity);
+          oldest.erase(oldest.begin(), oldest.begin() + static_cast<std::ptrdiff_t>(dropped));
+          retiredEvents -= dropped;
+          if (oldest.empty())
+            retired.pop_front();
+        }
+      }
+    };
+
+    static Registry & GetRegistry()
+    {
+      // Never destroyed, threads may exit after static destruction has started
+      static auto registry = new Registry();
+      return *registry;
+    }
+
+    /**
+     * \brief Owner of the buffer of a thread, retires the buffer when the thread exits
+     */
+    class ThreadHandle
+    {
+      std::unique_ptr<ThreadBuffer> m_buffer;
+
+    public:
+      ThreadHandle()
+      {
+        auto & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        m_buffer = std::make_unique<ThreadBuffer>(registry.nextThreadId);
+        registry.threads.push_back(m_buffer.get());
+        ++registry.nextThreadId;
+      }
+
+      ThreadHandle(const ThreadHandle &) = delete;
+      ThreadHandle & operator =(const ThreadHandle &) = delete;
+
+      ~ThreadHandle()
+      {
+        auto & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), m_buffer.get()));
+
+        // Events which cannot be copied are dropped along with the buffer
+        try { registry.Retire(m_buffer->threadId, m_buffer->Read()); }
+        catch (...) { }
+      }
+
+      ThreadBuffer & GetBuffer() const noexcept { return *m_buffer; }
+    };
+
+    /**
+     * \brief Retrieves the buffer of the calling thread, registering it on first use
+     * \return The buffer, null if it could not be allocated
+     */
+    static ThreadBuffer * GetThreadBuffer() noexcept
+    {
+      try
+      {
+        // A failed initialization is retried on the next call
+        thread_local const ThreadHandle handle;
+        return &handle.GetBuffer();
+      }
+      catch (...)
+      {
+        return nullptr;
+      }
+    }
+
+    static void WriteEscaped(std::ostream & output, const char * text)
+    {
+      for (; *text != '\0'; ++text)
+      {
+        if (*text == '"' || *text == '\\')
+          output << '\\';
+        output << *text;
+      }
+    }
+
+  public:
+    /**
+     * \brief Getter method for the Enabled property
+     * \return True if scopes are being recorded
+     */
+    static bool IsEnabled() noexcept { return GetRegistry().enabled.load(std::memory_order_relaxed); }
+    /**
+     * \brief Setter method for the Enabled property, recording is enabled by default
+     * \param enabled True to record scopes
+     */
+    static void SetEnabled(const bool enabled) noexcept { GetRegistry().enabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * \brief Retrieves the current time of the tracing clock
+     * \return Nanoseconds since the tracing epoch
+     */
+    static std::uint64_t Now() noexcept
+    {
+      const auto elapsed = std::chrono::steady_clock::now() - GetRegistry().epoch;
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    /**
+     * \brief Records a completed scope of the calling thread
+     * \param event Completed scope
+     */
+    static void Record(const TraceEvent & event) noexcept
+    {
+      if (const auto buffer = GetThreadBuffer())
+        buffer->Push(event);
+    }
+
+    /**
+     * \brief Writes the recorded events of all threads as Chrome Trace Event JSON
+     * \param output Stream to write to
+     */
+    static void Write(std::ostream & output)
+    {
+      std::vector<std::pair<unsigned, std::vector<TraceEvent>>> threads;
+      {
+        auto & registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto & thread : registry.retired)
+          threads.emplace_back(thread.threadId, thread.events);
+        for (const auto buffer : registry.threads)
+          threads.emplace_back(buffer->threadId, buffer->Read());
+      }
+
+      auto first = true;
+      output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+      for (const auto &[threadId, events] : threads)
+      {
+        output << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+          << ",\"name\":\"thread_name\",\"args\":{\"name\":\"Thread " << threadId << "\"}}";
+        first = false;
+
+        // Timestamps are microseconds, fractions keep the nanosecond resolution
+        for (const auto & event : events)
+        {
+          output << ",\n{\"ph\":\"X\",\"cat\":\"CommonMath\",\"pid\":1,\"tid\":" << threadId << ",\"name\":\"";
+          WriteEscaped(output, event.name);
+          output << "\",\"ts\":" << event.start / 1000 << '.' << std::to_string(1000 + event.start % 1000).substr(1)
+            << ",\"dur\":" << event.duration / 1000 << '.' << std::to_string(1000 + event.duration % 1000).substr(1);
+          if (event.size != 0)
+            output << ",\"args\":{\"size\":" << event.size << '}';
+          output << '}';
+        }
+      }
+      output << "\n]}\n";
+    }
+
+    /**
+     * \brief Writes the recorded events of all threads into a Chrome Trace Event JSON file
+     * \param path Path of the file to write
+     */
+    static void Flush(const std::string & path)
+    {
+      std::ofstream output(path);
+      if (!output)
+        throw std::runtime_error("Trace file " + path + " cannot be opened.");
+
+      Write(output);
+    }
+
+    /**
+     * \brief Discards the recorded events of all threads
+     */
+    static void Clear()
+    {
+      auto & registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.retired.clear();
+      registry.retiredEvents = 0;
+      for (const auto buffer : registry.threads)
+        buffer->cleared.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+  };
+
+  /**
+   * \brief Records the enclosing scope as a trace event on destruction
+   */
+  class TraceScope
+  {
+    const char * m_name;
+    std::uint64_t m_size;
+    std::uint64_t m_start;
+
+  public:
+    TraceScope(const char * name, const std::uint64_t size) noexcept
+      : m_name(Tracing::IsEnabled() ? name : nullptr), m_size(size), m_start(m_name != nullptr ? Tracing::Now() : 0) { }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope & operator =(const TraceScope &) = delete;
+    ~TraceScope()
+    {
+      if (m_name != nullptr)
+        Tracing::Record({ m_name, m_start, Tracing::Now() - m_start, m_size });
+    }
+  };
+}
+
+/**
+ * \brief Traces the rest of the enclosing scope under given name
+ */
+#ifdef COMMON_MATH_TRACING
+#define COMMON_MATH_TRACE_CONCAT_IMPL(a, b) a##b
+#define COMMON_MATH_TRACE_CONCAT(a, b) COMMON_MATH_TRACE_CONCAT_IMPL(a, b)
+#define COMMON_MATH_TRACE(name, size) const Common::Math::TraceScope COMMON_MATH_TRACE_CONCAT(traceScope, __LINE__)(name, size)
+#else
+#define COMMON_MATH_TRACE(name, size) ((void)0)
+#endif
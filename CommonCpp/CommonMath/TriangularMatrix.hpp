@@ -0,0 +1,325 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Accumulation.hpp"
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Half of a square matrix holding the values of a triangular matrix, including the main diagonal
+   */
+  enum class Triangle : unsigned
+  {
+    /**
+     * \brief Main diagonal and the values above it
+     */
+    Upper = 0,
+    /**
+     * \brief Main diagonal and the values below it
+     */
+    Lower = 1
+  };
+
+  /**
+   * \brief Square triangular matrix storing only its triangle, packed row after row. Products and solutions
+   * never touch the zero half of the matrix
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class TriangularMatrix
+  {
+    static_assert(std::is_arithmetic<T>::value, "Packed matrices can only store arithmetic types.");
+
+    /**
+     * \brief Stored half of the matrix
+     */
+    Triangle m_triangle;
+    /**
+     * \brief Number of rows and columns
+     */
+    unsigned m_size;
+    /**
+     * \brief Stored values, n * (n + 1) / 2 of them
+     */
+    std::vector<T> m_values;
+
+    static unsigned ValidateSize(const unsigned size)
+    {
+      if (size == 0)
+        throw std::invalid_argument("Size must be greater than 0.");
+
+      return size;
+    }
+
+    std::size_t GetRowOffset(const unsigned row) const noexcept
+    {
+      return m_triangle == Triangle::Upper
+        ? std::size_t(row) * (2 * std::size_t(m_size) - row + 1) / 2
+        : std::size_t(row) * (row + 1) / 2;
+    }
+
+    bool IsStored(const unsigned row, const unsigned column) const noexcept
+    {
+      return m_triangle == Triangle::Upper ? column >= row : column <= row;
+    }
+
+    void ValidateDiagonal() const
+    {
+      if (IsSingular())
+        throw InvertableMatrixOperationException("System cannot be solved for a singular matrix.");
+    }
+
+  public:
+    /**
+     * \brief Constructs a zero matrix
+     * \param size Number of rows and columns
+     * \param triangle Stored half of the matrix
+     */
+    TriangularMatrix(const unsigned size, const Triangle triangle)
+      : m_triangle(triangle),
+      m_size(ValidateSize(size)),
+      m_values(std::size_t(size) * (size + 1) / 2) { }
+    /**
+     * \brief Copies a triangle of a square matrix, values of the other half are ignored
+     * \param matrix Matrix to copy from
+     * \param triangle Half of the matrix to copy
+     */
+    TriangularMatrix(const Matrix<T> & matrix, const Triangle triangle)
+      : TriangularMatrix(matrix.GetRows(), triangle)
+    {
+      if (matrix.GetRows() != matrix.GetColumns())
+        throw std::invalid_argument("Argument " + NAMEOF(matrix) + " must be a NxN matrix.");
+
+      const auto & values = matrix.GetMatrixValues();
+      for (unsigned i = 0; i < m_size; ++i)
+        std::copy(values[i].begin() + GetRowBegin(i), values[i].begin() + GetRowEnd(i), m_values.begin() + GetRowOffset(i));
+    }
+
+    /**
+     * \brief Getter method for the Size property
+     * \return Number of rows and columns
+     */
+    unsigned GetSize() const noexcept { return m_size; }
+    /**
+     * \brief Getter method for the Triangle property
+     * \return Stored half of the matrix
+     */
+    Triangle GetTriangle() const noexcept { return m_triangle; }
+    /**
+     * \brief Getter method for the MatrixType property
+     * \return Type of the matrix
+     */
+    Type GetMatrixType() const noexcept { return Type::Invertable | (m_triangle == Triangle::Upper ? Type::UpperTriangular : Type::LowerTriangular); }
+    /**
+     * \brief Getter method for the PackedValues property
+     * \return Stored values, row after row
+     */
+    const std::vector<T> & GetPackedValues() const noexcept { return m_values; }
+
+    /**
+     * \brief Retrieves the column of the first stored value of a row
+     * \param row Index of the row
+     * \return Index of the column
+     */
+    unsigned GetRowBegin(const unsigned row) const noexcept { return m_triangle == Triangle::Upper ? row : 0; }
+    /**
+     * \brief Retrieves the column after the last stored value of a row
+     * \param row Index of the row
+     * \return Index of the column
+     */
+    unsigned GetRowEnd(const unsigned row) const noexcept { return m_triangle == Triangle::Upper ? m_size : row + 1; }
+    /**
+     * \brief Retrieves the stored values of a row
+     * \param row Index of the row
+     * \return Pointer to the value in the column returned by GetRowBegin
+     */
+    const T * GetRow(const unsigned row) const noexcept { return m_values.data() + GetRowOffset(row); }
+
+    /**
+     * \brief Retrieves a single value
+     * \param row Index of the row
+     * \param column Index of the column
+     * \return Value at given position, zero outside of the triangle
+     */
+    T Get(const unsigned row, const unsigned column) const noexcept
+    {
+      return IsStored(row, column) ? m_values[GetRowOffset(row) + column - GetRowBegin(row)] : T(0);
+    }
+    /**
+     * \brief Changes a single value
+     * \param row Index of the row
+     * \param column Index of the column, has to lie within the triangle
+     * \param value Value to set
+     */
+    void Set(const unsigned row, const unsigned column, const T value)
+    {
+      if (row >= m_size || column >= m_size)
+        throw std::invalid_argument("Position is outside of the matrix.");
+      if (!IsStored(row, column))
+        throw std::invalid_argument("Position is outside of the triangle.");
+
+      m_values[GetRowOffset(row) + column - GetRowBegin(row)] = value;
+    }
+
+    /**
+     * \brief Calculates the determinant as the product of the main diagonal
+     * \return Determinant of the matrix
+     */
+    double GetDeterminant() const noexcept
+    {
+      double determinant = 1;
+      for (unsigned i = 0; i < m_size; ++i)
+        determinant *= GetRow(i)[i - GetRowBegin(i)];
+
+      return determinant;
+    }
+
+    /**
+     * \brief Decides whether the matrix is singular, i.e. a value on the main diagonal is zero
+     * \return True if the matrix has no inverse
+     */
+    bool IsSingular() const noexcept
+    {
+      for (unsigned i = 0; i < m_size; ++i)
+        if (GetRow(i)[i - GetRowBegin(i)] == 0)
+          return true;
+
+      return false;
+    }
+
+    /**
+     * \brief Transposes the matrix, swapping the stored triangle
+     * \return Transposed matrix
+     */
+    TriangularMatrix<T> Transpose() const
+    {
+      TriangularMatrix<T> result(m_size, m_triangle == Triangle::Upper ? Triangle::Lower : Triangle::Upper);
+      for (unsigned i = 0; i < m_size; ++i)
+      {
+        const auto * row = GetRow(i);
+        for (auto j = GetRowBegin(i); j < GetRowEnd(i); ++j)
+          result.m_values[result.GetRowOffset(j) + i - result.GetRowBegin(j)] = row[j - GetRowBegin(i)];
+      }
+
+      return result;
+    }
+
+    /**
+     * \brief Expands the matrix into full storage
+     * \return Matrix with zeros outside of the triangle
+     */
+    Matrix<T> ToMatrix() const
+    {
+      std::vector<std::vector<T>> values(m_size, std::vector<T>(m_size));
+      for (unsigned i = 0; i < m_size; ++i)
+        std::copy(GetRow(i), GetRow(i) + GetRowEnd(i) - GetRowBegin(i), values[i].begin() + GetRowBegin(i));
+
+      return Matrix<T>(std::move(values));
+    }
+
+    /**
+     * \brief Multiplies the matrix by a column vector
+     * \param vector Values of the vector, one per column
+     * \return Values of the product, one per row
+     */
+    std::vector<T> operator * (const std::vector<T> & vector) const
+    {
+      if (vector.size() != m_size)
+        throw MatrixDimensionException("Number of columns of the matrix must match size of the vector.");
+
+      std::vector<T> output(m_size);
+      for (unsigned i = 0; i < m_size; ++i)
+        output[i] = Reduction::Dot(GetRow(i), vector.data() + GetRowBegin(i), GetRowEnd(i) - GetRowBegin(i));
+
+      return output;
+    }
+    /**
+     * \brief Multiplies the matrix by a full matrix, each output row combines only the rows selected by the triangle
+     * \param other Right operand
+     * \return Product of the matrices
+     */
+    Matrix<T> operator * (const Matrix<T> & other) const
+    {
+      if (other.GetRows() != m_size)
+        throw MatrixDimensionException("Number of columns of the left operand must match number of rows of the right operand.");
+
+      const auto & kernels = GetMatrixKernels<T>();
+      const auto & values = other.GetMatrixValues();
+      const auto columns = other.GetColumns();
+      std::vector<std::vector<T>> outputValues(m_size, std::vector<T>(columns));
+      for (unsigned i = 0; i < m_size; ++i)
+      {
+        const auto * row = GetRow(i);
+        for (auto k = GetRowBegin(i); k < GetRowEnd(i); ++k)
+          kernels.multiplyAdd(row[k - GetRowBegin(i)], values[k].data(), outputValues[i].data(), columns);
+      }
+
+      return Matrix<T>(std::move(outputValues));
+    }
+
+    /**
+     * \brief Solves the system A * x = b by substitution in O(n^2)
+     * \param vector Right-hand side b
+     * \return Solution x
+     */
+    std::vector<T> Solve(const std::vector<T> & vector) const
+    {
+      static_assert(std::is_floating_point<T>::value, "Systems can only be solved for floating point values.");
+      if (vector.size() != m_size)
+        throw MatrixDimensionException("Number of rows of the matrix must match size of the right-hand side.");
+      ValidateDiagonal();
+
+      // Rows are resolved starting at the one with a single unknown
+      std::vector<T> solution(vector);
+      for (unsigned step = 0; step < m_size; ++step)
+      {
+        const auto i = m_triangle == Triangle::Upper ? m_size - 1 - step : step;
+        const auto * row = GetRow(i);
+        const auto begin = GetRowBegin(i);
+        const auto diagonal = row[i - begin];
+        const auto known = m_triangle == Triangle::Upper
+          ? Reduction::Dot(row + 1, solution.data() + i + 1, m_size - i - 1)
+          : Reduction::Dot(row, solution.data(), i);
+        solution[i] = (solution[i] - known) / diagonal;
+      }
+
+      return solution;
+    }
+    /**
+     * \brief Solves the system A * X = B for several right-hand sides at once by substitution of whole rows
+     * \param other Right-hand sides B, one per column
+     * \return Solutions X, one per column
+     */
+    Matrix<T> Solve(const Matrix<T> & other) const
+    {
+      static_assert(std::is_floating_point<T>::value, "Systems can only be solved for floating point values.");
+      if (other.GetRows() != m_size)
+        throw MatrixDimensionException("Number of rows of the matrix must match number of rows of the right-hand side.");
+      ValidateDiagonal();
+
+      const auto & kernels = GetMatrixKernels<T>();
+      const auto columns = other.GetColumns();
+      auto solution = other.GetMatrixValues();
+      for (unsigned step = 0; step < m_size; ++step)
+      {
+        const auto i = m_triangle == Triangle::Upper ? m_size - 1 - step : step;
+        const auto * row = GetRow(i);
+        const auto begin = GetRowBegin(i);
+        for (auto k = begin; k < GetRowEnd(i); ++k)
+          if (k != i)
+            kernels.multiplyAdd(-row[k - begin], solution[k].data(), solution[i].data(), columns);
+
+        const auto diagonal = row[i - begin];
+        for (auto & value : solution[i])
+          value /= diagonal;
+      }
+
+      return Matrix<T>(std::move(solution));
+    }
+  };
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "BandMatrix.hpp"
+#include "Matrix.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Square matrix with nonzero values only on the main diagonal and the diagonals next to it,
+   * each diagonal stored as a separate vector
+   * \tparam T Type of matrix values
+   */
+  template <typename T>
+  class TridiagonalMatrix
+  {
+    static_assert(std::is_arithmetic<T>::value, "Tridiagonal matrices can only store arithmetic types.");
+
+    /**
+     * \brief Subdiagonal, n - 1 values starting at the second row
+     */
+    std::vector<T> m_lower;
+    /**
+     * \brief Main diagonal, n values
+     */
+    std::vector<T> m_diagonal;
+    /**
+     * \brief Superdiagonal, n - 1 values starting at the first row
+     */
+    std::vector<T> m_upper;
+
+  public:
+    /**
+     * \brief Constructs a zero matrix
+     * \param size Number of rows and columns
+     */
+    explicit TridiagonalMatrix(const unsigned size)
+      : TridiagonalMatrix(std::vector<T>(size > 0 ? size - 1 : 0), std::vector<T>(size), std::vector<T>(size > 0 ? size - 1 : 0)) { }
+    /**
+     * \brief Constructs the matrix from its diagonals
+     * \param lower Subdiagonal, one value less than the main diagonal
+     * \param diagonal Main diagonal
+     * \param upper Superdiagonal, one value less than the main diagonal
+     */
+    TridiagonalMatrix(std::vector<T> lower, std::vector<T> diagonal, std::vector<T> upper)
+      : m_lower(std::move(lower)),
+      m_diagonal(std::move(diagonal)),
+      m_upper(std::move(upper))
+    {
+      if (m_diagonal.empty())
+        throw std::invalid_argument("Size must be greater than 0.");
+      if (m_lower.size() + 1 != m_diagonal.size())
+        throw std::invalid_argument("Argument " + NAMEOF(lower) + " must have one value less than argument " + NAMEOF(diagonal) + ".");
+      if (m_upper.size() + 1 != m_diagonal.size())
+        throw std::invalid_argument("Argument " + NAMEOF(upper) + " must have one value less than argument " + NAMEOF(diagonal) + ".");
+    }
+
+    /**
+     * \brief Getter method for the Size property
+     * \return Number of rows and columns
+     */
+    unsigned GetSize() const noexcept { return static_cast<unsigned>(m_diagonal.size()); }
+    /**
+     * \brief Getter method for the Lower property
+     * \return Subdiagonal
+     */
+    const std::vector<T> & GetLower() const noexcept { return m_lower; }
+    /**
+     * \brief Getter method for the Diagonal property
+     * \return Main diagonal
+     */
+    const std::vector<T> & GetDiagonal() const noexcept { return m_diagonal; }
+    /**
+     * \brief Getter method for the Upper property
+     * \return Superdiagonal
+     */
+    const std::vector<T> & GetUpper() const noexcept { return m_upper; }
+
+    /**
+     * \brief Retrieves a single value
+     * \param row Index of the row
+     * \param column Index of the column
+     * \return Value at given position, zero outside of the three diagonals
+     */
+    T Get(const unsigned row, const unsigned column) const noexcept
+    {
+      if (row == column) return m_diagonal[row];
+      if (row == column + 1) return m_lower[column];
+      if (column == row + 1) return m_upper[row];
+
+      return T(0);
+    }
+
+    /**
+     * \brief Calculates the determinant by the three-term recurrence of the leading principal minors in O(n)
+     * \return Determinant of the matrix
+     */
+    double GetDeterminant() const noexcept
+    {
+      double previous = 1, current = m_diagonal[0];
+      for (std::size_t i = 1; i < m_diagonal.size(); ++i)
+      {
+        const auto next = static_cast<double>(m_diagonal[i]) * current - static_cast<double>(m_lower[i - 1]) * m_upper[i - 1] * previous;
+        previous = current;
+        current = next;
+      }
+
+      return current;
+    }
+
+    /**
+     * \brief Converts the matrix into general band storage
+     * \return Band matrix with one subdiagonal and one superdiagonal
+     */
+    BandMatrix<T> ToBandMatrix() const
+    {
+      BandMatrix<T> result(GetSize(), 1, 1);
+      for (unsigned i = 0; i < GetSize(); ++i)
+      {
+        result.Set(i, i, m_diagonal[i]);
+        if (i > 0) result.Set(i, i - 1, m_lower[i - 1]);
+        if (i + 1 < GetSize()) result.Set(i, i + 1, m_upper[i]);
+      }
+
+      return result;
+    }
+    /**
+     * \brief Expands the matrix into full storage
+     * \return Matrix with zeros outside of the three diagonals
+     */
+    Matrix<T> ToMatrix() const
+    {
+      return ToBandMatrix().ToMatrix();
+    }
+
+    /**
+     * \brief Multiplies the matrix by a column vector in O(n)
+     * \param vector Values of the vector, one per column
+     * \return Values of the product, one per row
+     */
+    std::vector<T> operator * (const std::vector<T> & vector) const
+    {
+      if (vector.size() != GetSize())
+        throw MatrixDimensionException("Number of columns of the matrix must match size of the vector.");
+
+      const auto size = m_diagonal.size();
+      std::vector<T> output(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        auto value = m_diagonal[i] * vector[i];
+        if (i > 0) value += m_lower[i - 1] * vector[i - 1];
+        if (i + 1 < size) value += m_upper[i] * vector[i + 1];
+        output[i] = static_cast<T>(value);
+      }
+
+      return output;
+    }
+
+    /**
+     * \brief Solves the system A * x = b by the Thomas algorithm in O(n). The elimination does not pivot,
+     * it is stable for diagonally dominant and symmetric positive definite matrices. Other matrices can be solved
+     * through ToBandMatrix
+     * \param vector Right-hand side b
+     * \return Solution x
+     */
+    std::vector<T> Solve(const std::vector<T> & vector) const
+    {
+      static_assert(std::is_floating_point<T>::value, "Systems can only be solved for floating point values.");
+      if (vector.size() != GetSize())
+        throw MatrixDimensionException("Number of rows of the matrix must match size of the right-hand side.");
+
+      // Forward sweep normalizes each row, the superdiagonal factors are kept for the back substitution
+      const auto size = m_diagonal.size();
+      std::vector<T> factors(size), solution(size);
+      T pivot = m_diagonal[0];
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        if (i > 0)
+          pivot = m_diagonal[i] - m_lower[i - 1] * factors[i - 1];
+        if (pivot == 0)
+          throw InvertableMatrixOperationException("System cannot be solved without pivoting.");
+
+        factors[i] = i + 1 < size ? m_upper[i] / pivot : T(0);
+        solution[i] = (i > 0 ? vector[i] - m_lower[i - 1] * solution[i - 1] : vector[i]) / pivot;
+      }
+
+      for (auto i = size - 1; i-- > 0;)
+        solution[i] -= factors[i] * solution[i + 1];
+
+      return solution;
+    }
+  };
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include "NumberInRange.hpp"
+#include "RangeKernels.hpp"
+
+namespace Common::Math
+{
+  /**
+   * \brief Uniform distribution of integers in a range, unlike wrapping random values by NumberInRange the values
+   * are not biased. Random words are mapped by Lemire's multiply-shift method, the high half of word * length is the
+   * offset from the minimum and words whose low half falls below 2^bits mod length are rejected.
+   * Works with any uniform random bit generator, batches are mapped by vector kernels of 32-bit values
+   * \tparam T Type of values. Anything but integer types are prohibited.
+   */
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value && std::numeric_limits<T>::is_integer && !std::is_same<T, bool>::value>>
+  class UniformInRange
+  {
+    using Offset = std::make_unsigned_t<T>;
+    using Word = RandomWord<T>;
+
+    /**
+     * \brief Count of words drawn at once by Fill
+     */
+    static constexpr std::size_t ChunkSize = 256;
+
+    /**
+     * \brief Precomputed constants of the range
+     */
+    const RangeParameters<T> m_range;
+    /**
+     * \brief Words whose product with the length has a lower low half are rejected, zero if nothing is rejected
+     */
+    const Word m_threshold;
+
+    static Word CalcThreshold(const Offset length) noexcept
+    {
+      const auto wordLength = static_cast<Word>(length);
+      return length == 0 ? Word(0) : static_cast<Word>(static_cast<Word>(Word(0) - wordLength) % wordLength);
+    }
+
+    /**
+     * \brief Counts bits of a generator producing every value of [0, 2^bits - 1]
+     * \return Count of bits, zero if the generator produces values of a different range
+     */
+    template <typename TGenerator>
+    static constexpr unsigned CountGeneratorBits() noexcept
+    {
+      using Result = typename TGenerator::result_type;
+      constexpr auto max = TGenerator::max();
+      if (TGenerator::min() != 0 || (max & static_cast<Result>(max + 1u)) != 0)
+        return 0;
+
+      unsigned bits = 0;
+      for (auto rest = max; rest != 0; rest >>= 1)
+        ++bits;
+      return bits;
+    }
+
+    /**
+     * \brief Draws a word of uniformly distributed bits
+     */
+    template <typename TGenerator>
+    static Word DrawWord(TGenerator & generator)
+    {
+      constexpr auto bits = CountGeneratorBits<TGenerator>();
+      constexpr unsigned wordBits = sizeof(Word) * CHAR_BIT;
+      // High bits are the stronger ones of linear generators
+      if constexpr (bits >= wordBits)
+        return static_cast<Word>(generator() >> (bits - wordBits));
+      else if constexpr (bits * 2 == wordBits)
+      {
+        const auto high = static_cast<Word>(generator());
+        return static_cast<Word>(high << bits | static_cast<Word>(generator()));
+      }
+      else
+        return std::uniform_int_distribution<Word>()(generator);
+    }
+
+    /**
+     * \brief Draws words of uniformly distributed bits, outputs of generators twice as wide as a word are split
+     */
+    template <typename TGenerator>
+    static void DrawWords(TGenerator & generator, Word * words, const std::size_t count)
+    {
+      constexpr unsigned wordBits = sizeof(Word) * CHAR_BIT;
+      std::size_t i = 0;
+      if constexpr (CountGeneratorBits<TGenerator>() == wordBits * 2)
+        for (; i + 2 <= count; i += 2)
+        {
+          const auto bits = generator();
+          words[i] = static_cast<Word>(bits >> wordBits);
+          words[i + 1] = static_cast<Word>(bits);
+        }
+      for (; i < count; ++i)
+        words[i] = DrawWord(generator);
+    }
+
+    T FromOffset(const Word offset) const noexcept
+    {
+      return static_cast<T>(static_cast<Offset>(static_cast<Offset>(m_range.min) + static_cast<Offset>(offset)));
+    }
+
+  public:
+    /**
+     * \brief Default constructor
+     * \param min Range minimum
+     * \param max Range maximum
+     */
+    UniformInRange(const T & min, const T & max)
+      : m_range(NumberInRange<T>(min, min, max).GetParameters()),
+      m_threshold(CalcThreshold(m_range.length)) { }
+    /**
+     * \brief Constructs a distribution over the range of a number
+     * \param number Number whose range to draw from
+     */
+    template <typename TPolicy>
+    explicit UniformInRange(const NumberInRange<T, TPolicy> & number)
+      : UniformInRange(number.GetMin(), number.GetMax()) { }
+
+    /**
+     * \brief Getter for the Min property
+     * \return Range Minimum
+     */
+    const T & GetMin() const noexcept { return m_range.min; }
+    /**
+     * \brief Getter for the Max property
+     * \return Range Maximum
+     */
+    const T & GetMax() const noexcept { return m_range.max; }
+
+    /**
+     * \brief Draws a value
+     * \tparam TGenerator Uniform random bit generator, e.g. std::mt19937
+     * \param generator Source of random bits
+     * \return Uniformly distributed value in range
+     */
+    template <typename TGenerator>
+    T operator ()(TGenerator & generator) const
+    {
+      // A range covering every value of T takes the bits as they are
+      if (m_range.length == 0)
+        return FromOffset(DrawWord(generator));
+
+      Word offset, low;
+      do
+        offset = Kernels::Scalar::MultiplyWord(DrawWord(generator), m_range, low);
+      while (low < m_threshold);
+
+      return FromOffset(offset);
+    }
+
+    /**
+     * \brief Draws an array of values. Where vector kernels are available words are mapped by them in chunks and
+     * the few rejected words are redrawn one by one
+     * \tparam TGenerator Uniform random bit generator, e.g. std::mt19937_64
+     * \param generator Source of random bits
+     * \param output Uniformly distributed values in range
+     * \param count Number of values
+     */
+    template <typename TGenerator>
+    void Fill(TGenerator & generator, T * output, const std::size_t count) const
+    {
+      // Scalar mapping of words drawn in advance only adds a pass over them
+      const auto & kernels = GetRangeKernels<T>();
+      if (kernels.instructionSet == InstructionSet::Scalar)
+      {
+        for (std::size_t i = 0; i < count; ++i)
+          output[i] = (*this)(generator);
+        return;
+      }
+
+      Word words[ChunkSize];
+      for (std::size_t i = 0; i < count; i += ChunkSize)
+      {
+        const auto chunk = std::min(ChunkSize, count - i);
+        DrawWords(generator, words, chunk);
+
+        if (m_range.length == 0)
+          for (std::size_t j = 0; j < chunk; ++j)
+            output[i + j] = FromOffset(words[j]);
+        else if (kernels.bound(words, output + i, chunk, m_range))
+          for (std::size_t j = 0; j < chunk; ++j)
+          {
+            Word low;
+            Kernels::Scalar::MultiplyWord(words[j], m_range, low);
+            if (low < m_threshold)
+              output[i + j] = (*this)(generator);
+          }
+      }
+    }
+  };
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <climits>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/**
+ * \brief Double width arithmetic of 32-bit and 64-bit unsigned words. 64-bit words use unsigned __int128 where
+ * the compiler provides it, MSVC intrinsics or portable code otherwise
+ */
+namespace Common::Math::WideArithmetic
+{
+#if defined(__SIZEOF_INT128__)
+  /**
+   * \brief Double width type of 64-bit words
+   */
+  __extension__ typedef unsigned __int128 Wide;
+#endif
+
+  /**
+   * \brief Calculates the high half of a full width product
+   * \tparam T Type of words, 32-bit or 64-bit unsigned integer
+   */
+  template <typename T>
+  T MultiplyHigh(const T left, const T right) noexcept
+  {
+    static_assert(std::is_unsigned<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), "Words must be 32-bit or 64-bit unsigned integers.");
+    if constexpr (sizeof(T) == 4)
+      return static_cast<T>((std::uint64_t(left) * right) >> 32);
+    else
+    {
+#if defined(__SIZEOF_INT128__)
+      return static_cast<T>((static_cast<Wide>(left) * right) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+      return __umulh(left, right);
+#else
+      const auto leftLow = left & 0xFFFFFFFFu, leftHigh = left >> 32;
+      const auto rightLow = right & 0xFFFFFFFFu, rightHigh = right >> 32;
+      const auto low = leftLow * rightLow;
+      const auto middle = leftHigh * rightLow + (low >> 32);
+      const auto cross = leftLow * rightHigh + (middle & 0xFFFFFFFFu);
+      return leftHigh * rightHigh + (middle >> 32) + (cross >> 32);
+#endif
+    }
+  }
+
+  /**
+   * \brief Divides the double width value high * 2^bits + low
+   * \tparam T Type of words, 32-bit or 64-bit unsigned integer
+   * \param high High half of the dividend, less than the divisor
+   * \param low Low half of the dividend
+   * \param divisor Divisor
+   * \param remainder Remainder of the division
+   * \return Quotient, it fits into a single word
+   */
+  template <typename T>
+  T DivideWide(const T high, const T low, const T divisor, T & remainder) noexcept
+  {
+    static_assert(std::is_unsigned<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), "Words must be 32-bit or 64-bit unsigned integers.");
+    if constexpr (sizeof(T) == 4)
+    {
+      const auto dividend = std::uint64_t(high) << 32 | low;
+      remainder = static_cast<T>(dividend % divisor);
+      return static_cast<T>(dividend / divisor);
+    }
+    else
+    {
+#if defined(__SIZEOF_INT128__)
+      const auto dividend = static_cast<Wide>(high) << 64 | low;
+      remainder = static_cast<T>(dividend % divisor);
+      return static_cast<T>(dividend / divisor);
+#else
+      // Long division one bit at a time
+      constexpr unsigned bits = sizeof(T) * CHAR_BIT;
+      T quotient = 0, rest = high;
+      for (unsigned i = bits; i-- > 0;)
+      {
+        const bool carry = (rest >> (bits - 1)) != 0;
+        rest = rest << 1 | (low >> i & 1);
+        quotient <<= 1;
+        if (carry || rest >= divisor)
+        {
+          rest -= divisor;
+          quotient |= 1;
+        }
+      }
+      remainder = rest;
+      return quotient;
+#endif
+    }
+  }
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../../CommonMath/HalfPrecision.hpp"
+
+namespace Common::Math::Bench
+{
+  /**
+   * \brief Command line options of the benchmark executable
+   */
+  struct Options
+  {
+    /**
+     * \brief Largest matrix size to measure
+     */
+    unsigned maxSize = 4096;
+    /**
+     * \brief Only benchmarks whose name contains this text are run
+     */
+    std::string filter;
+    /**
+     * \brief Minimal time spent measuring a single benchmark, in seconds
+     */
+    double minTime = 0.1;
+  };
+
+  /**
+   * \brief Measurement of a single benchmark
+   */
+  struct Result
+  {
+    std::string name;
+    std::string type;
+    unsigned size;
+    std::uint64_t iterations;
+    double nanosecondsPerOperation;
+    /**
+     * \brief Floating point (or integer) operations per run, zero if not applicable
+     */
+    double operations;
+  };
+
+  /**
+   * \brief Prevents the compiler from optimizing away computation of given value
+   */
+  template <typename T>
+  inline void DoNotOptimize(const T & value)
+  {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void * sink;
+    sink = &value;
+#endif
+  }
+
+  template <typename T> inline const char * GetTypeName();
+  template <> inline const char * GetTypeName<short>() { return "short"; }
+  template <> inline const char * GetTypeName<unsigned short>() { return "unsigned short"; }
+  template <> inline const char * GetTypeName<int>() { return "int"; }
+  template <> inline const char * GetTypeName<unsigned>() { return "unsigned"; }
+  template <> inline const char * GetTypeName<long>() { return "long"; }
+  template <> inline const char * GetTypeName<unsigned long>() { return "unsigned long"; }
+  template <> inline const char * GetTypeName<float>() { return "float"; }
+  template <> inline const char * GetTypeName<double>() { return "double"; }
+  template <> inline const char * GetTypeName<Float16>() { return "float16"; }
+  template <> inline const char * GetTypeName<BFloat16>() { return "bfloat16"; }
+
+  /**
+   * \brief Collects benchmark results and writes them as JSON
+   */
+  class Report
+  {
+    const Options & m_options;
+    std::vector<Result> m_results;
+
+  public:
+    explicit Report(const Options & options) : m_options(options) { }
+
+    const Options & GetOptions() const noexcept { return m_options; }
+    const std::vector<Result> & GetResults() const noexcept { return m_results; }
+
+    /**
+     * \brief Decides whether a benchmark is selected by the filter
+     * \param name Name of the benchmark
+     * \return True if the benchmark should run
+     */
+    bool IsSelected(const std::string & name) const
+    {
+      return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+    }
+
+    /**
+     * \brief Repeatedly runs given action until the minimal time elapses and records the mean duration
+     * \tparam T Type of values the benchmark operates on
+     * \param name Name of the benchmark
+     * \param size Size of the benchmarked problem
+     * \param operations Arithmetic operations per run, zero if not applicable
+     * \param action Action to measure
+     */
+    template <typename T, typename TAction>
+    void Measure(const std::string & name, const unsigned size, const double operations, TAction && action)
+    {
+      if (!IsSelected(name))
+        return;
+
+      using Clock = std::chrono::steady_clock;
+      std::uint64_t iterations = 0;
+      std::uint64_t batch = 1;
+      const auto start = Clock::now();
+      double elapsed;
+      do
+      {
+        for (std::uint64_t i = 0; i < batch; ++i)
+          action();
+        iterations += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+      } while (elapsed < m_options.minTime);
+
+      m_results.push_back({ name, GetTypeName<T>(), size, iterations, elapsed * 1e9 / static_cast<double>(iterations), operations });
+    }
+
+    /**
+     * \brief Writes recorded results as a JSON document
+     * \param output Stream to write to
+     * \param instructionSet Name of the instruction set selected by the dispatcher
+     */
+    void WriteJson(std::ostream & output, const std::string & instructionSet) const
+    {
+      output << "{\n  \"instructionSet\": \"" << instructionSet << "\",\n  \"benchmarks\": [";
+      for (std::size_t i = 0; i < m_results.size(); ++i)
+      {
+        const auto & result = m_results[i];
+        output << (i == 0 ? "\n" : ",\n")
+          << "    { \"name\": \"" << result.name
+          << "\", \"type\": \"" << result.type
+          << "\", \"size\": " << result.size
+          << ", \"iterations\": " << result.iterations
+          << ", \"nsPerOp\": " << result.nanosecondsPerOperation;
+        if (result.operations > 0)
+          output << ", \"gflops\": " << result.operations / result.nanosecondsPerOperation;
+        output << " }";
+      }
+      output << "\n  ]\n}\n";
+    }
+  };
+
+  void RunMatrixBenchmarks(Report & report);
+  void RunNumberInRangeBenchmarks(Report & report);
+  void RunRingBufferBenchmarks(Report & report);
+}
@@ -0,0 +1,100 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "Bench.hpp"
+#include "../../CommonMath/Dispatch.hpp"
+#include "../../CommonMath/Gemm.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Bench;
+
+static void PrintUsage(const char * program)
+{
+  std::cerr << "Usage: " << program << " [--max-size N] [--filter TEXT] [--min-time SECONDS] [--output FILE]\n"
+    << "       " << program << " --tune [--tune-size N] [--profile FILE]\n";
+}
+
+template <typename T>
+static void Tune(GemmProfile & profile, const unsigned size)
+{
+  const auto parameters = GemmTuner::Tune<T>(size);
+  profile.Set<T>(parameters);
+  std::cerr << GemmProfile::GetKey<T>() << ": rowBlock=" << parameters.rowBlock << " depthBlock=" << parameters.depthBlock
+    << " columnBlock=" << parameters.columnBlock << " microRows=" << parameters.microRows << '\n';
+}
+
+/**
+ * \brief Searches for the fastest multiplication blocking of the common value types and saves it as the profile loaded by Common::Math
+ */
+static int Tune(const unsigned size, std::string path)
+{
+  if (path.empty())
+    path = GemmProfile::GetDefaultPath();
+  if (path.empty())
+  {
+    std::cerr << "Profile path cannot be determined, use --profile.\n";
+    return 1;
+  }
+
+  auto profile = GemmProfile::Load(path);
+  Tune<float>(profile, size);
+  Tune<double>(profile, size);
+  Tune<int>(profile, size);
+  profile.Save(path);
+  std::cerr << "Profile saved to " << path << '\n';
+
+  return 0;
+}
+
+int main(const int argc, char * argv[])
+{
+  Options options;
+  std::string output;
+  std::string profile;
+  auto tune = false;
+  unsigned tuneSize = 512;
+
+  for (auto i = 1; i < argc; ++i)
+  {
+    const auto hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--max-size") == 0 && hasValue)
+      options.maxSize = static_cast<unsigned>(std::stoul(argv[++i]));
+    else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+      options.filter = argv[++i];
+    else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+      options.minTime = std::stod(argv[++i]);
+    else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+      output = argv[++i];
+    else if (std::strcmp(argv[i], "--tune") == 0)
+      tune = true;
+    else if (std::strcmp(argv[i], "--tune-size") == 0 && hasValue)
+      tuneSize = static_cast<unsigned>(std::stoul(argv[++i]));
+    else if (std::strcmp(argv[i], "--profile") == 0 && hasValue)
+      profile = argv[++i];
+    else
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (tune)
+    return Tune(tuneSize, profile);
+
+  Report report(options);
+  RunMatrixBenchmarks(report);
+  RunNumberInRangeBenchmarks(report);
+  RunRingBufferBenchmarks(report);
+
+  const auto instructionSet = Dispatch::GetInstructionSetName(Dispatch::GetInstructionSet());
+  if (output.empty())
+  {
+    report.WriteJson(std::cout, instructionSet);
+    return 0;
+  }
+
+  std::ofstream file(output);
+  report.WriteJson(file, instructionSet);
+  return file ? 0 : 1;
+}
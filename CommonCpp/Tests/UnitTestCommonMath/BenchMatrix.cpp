@@ -0,0 +1,145 @@
+#include <string>
+#include "Bench.hpp"
+#include "DataFixtures.hpp"
+#include "../../CommonMath/Matrix.hpp"
+#include "../../CommonMath/TridiagonalMatrix.hpp"
+
+using namespace Common::Math;
+
+namespace Common::Math::Bench
+{
+  /**
+   * \brief Largest size measured for the determinant and inverse, which are computed by cofactor expansion
+   */
+  constexpr unsigned MaxCofactorSize = 8;
+  /**
+   * \brief Largest size measured for the band solvers, independent of the largest matrix size
+   */
+  constexpr unsigned MaxBandSize = 1u << 20;
+
+  template <typename T>
+  static std::vector<std::vector<T>> CreateDominantValues(const unsigned size, const int seed)
+  {
+    auto values = Tests::CreateValues<T>(size, size, seed);
+
+    // Dominant diagonal keeps the matrix invertible
+    for (unsigned i = 0; i < size; ++i)
+      values[i][i] = static_cast<T>(6 * size);
+
+    return values;
+  }
+
+  template <typename T>
+  static void RunMatrixBenchmarks(Report & report, const unsigned size)
+  {
+    const auto valuesA = CreateDominantValues<T>(size, 1);
+    const auto valuesB = CreateDominantValues<T>(size, 4);
+    const Matrix<T> a(valuesA);
+    const Matrix<T> b(valuesB);
+    Matrix<T> diagonal(static_cast<int>(size), static_cast<int>(size));
+    auto diagonalValues = diagonal.GetMatrixValues();
+    for (unsigned i = 0; i < size; ++i)
+      diagonalValues[i][i] = valuesA[i][i];
+    diagonal.SetMatrixValues(diagonalValues);
+    const auto vector = valuesB[0];
+    const double elements = static_cast<double>(size) * size;
+
+    report.Measure<T>("Matrix.Construct", size, 0, [&]
+    {
+      Matrix<T> matrix(valuesA);
+      DoNotOptimize(matrix);
+    });
+    report.Measure<T>("Matrix.Add", size, elements, [&]
+    {
+      auto result = a + b;
+      DoNotOptimize(result);
+    });
+    report.Measure<T>("Matrix.Multiply", size, 2 * elements * size, [&]
+    {
+      auto result = a * b;
+      DoNotOptimize(result);
+    });
+    report.Measure<T>("Matrix.MultiplyDiagonal", size, elements, [&]
+    {
+      auto result = diagonal * b;
+      DoNotOptimize(result);
+    });
+    report.Measure<T>("Matrix.MultiplyVector", size, 2 * elements, [&]
+    {
+      auto result = a * vector;
+      DoNotOptimize(result);
+    });
+    report.Measure<T>("Matrix.Transpose", size, 0, [&]
+    {
+      auto result = a.Transpose();
+      DoNotOptimize(result);
+    });
+
+    if (size > MaxCofactorSize)
+      return;
+
+    // Both properties are cached, hence every run measures a freshly constructed matrix
+    report.Measure<T>("Matrix.Determinant", size, 0, [&]
+    {
+      const Matrix<T> matrix(valuesA);
+      DoNotOptimize(matrix.GetDeterminant());
+    });
+    report.Measure<T>("Matrix.Inverse", size, 0, [&]
+    {
+      const Matrix<T> matrix(valuesA);
+      DoNotOptimize(matrix.GetInverse());
+    });
+  }
+
+  template <typename T>
+  static void RunBandBenchmarks(Report & report, const unsigned size)
+  {
+    // Two diagonals on both sides, dominant main diagonal
+    BandMatrix<T> band(size, 2, 2);
+    std::vector<T> lower(size - 1), diagonal(size), upper(size - 1), vector(size);
+    for (unsigned i = 0; i < size; ++i)
+    {
+      for (auto j = band.GetRowBegin(i); j < band.GetRowEnd(i); ++j)
+        band.Set(i, j, static_cast<T>(i == j ? 8 : (i + j) % 3 - 1));
+      diagonal[i] = static_cast<T>(4);
+      vector[i] = static_cast<T>(i % 7) - 3;
+      if (i + 1 < size)
+        lower[i] = upper[i] = static_cast<T>(-1);
+    }
+    const TridiagonalMatrix<T> tridiagonal(lower, diagonal, upper);
+
+    report.Measure<T>("BandMatrix.MultiplyVector", size, 2.0 * size * 5, [&]
+    {
+      auto result = band * vector;
+      DoNotOptimize(result);
+    });
+    report.Measure<T>("BandMatrix.Solve", size, 0, [&]
+    {
+      auto result = band.Solve(vector);
+      DoNotOptimize(result);
+    });
+    report.Measure<T>("TridiagonalMatrix.Solve", size, 0, [&]
+    {
+      auto result = tridiagonal.Solve(vector);
+      DoNotOptimize(result);
+    });
+  }
+
+  void RunMatrixBenchmarks(Report & report)
+  {
+    for (unsigned size = 1024; size <= MaxBandSize; size *= 32)
+    {
+      RunBandBenchmarks<float>(report, size);
+      RunBandBenchmarks<double>(report, size);
+    }
+
+    for (unsigned size = 2; size <= report.GetOptions().maxSize; size *= 2)
+    {
+      RunMatrixBenchmarks<int>(report, size);
+      RunMatrixBenchmarks<float>(report, size);
+      RunMatrixBenchmarks<double>(report, size);
+      RunMatrixBenchmarks<Float16>(report, size);
+      RunMatrixBenchmarks<BFloat16>(report, size);
+    }
+  }
+}
@@ -0,0 +1,273 @@
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Bench.hpp"
+#include "../../CommonMath/AtomicNumberInRange.hpp"
+#include "../../CommonMath/ModInt.hpp"
+#include "../../CommonMath/NumberInRange.hpp"
+#include "../../CommonMath/StaticNumberInRange.hpp"
+#include "../../CommonMath/UniformInRange.hpp"
+
+using namespace Common::Math;
+
+namespace Common::Math::Bench
+{
+  /**
+   * \brief Count of operations performed by a single run
+   */
+  constexpr unsigned OperationCount = 1024;
+
+  template <typename T>
+  static void RunNumberInRangeBenchmarks(Report & report)
+  {
+    std::vector<T> operands(OperationCount);
+    for (unsigned i = 0; i < OperationCount; ++i)
+      operands[i] = static_cast<T>(i * 37 % 1000);
+
+    const NumberInRange<T> number(3, 0, 99);
+
+    report.Measure<T>("NumberInRange.Construct", OperationCount, 0, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(NumberInRange<T>(operand, 0, 99));
+    });
+    report.Measure<T>("NumberInRange.AdjustValue", OperationCount, 0, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(NumberInRange<T>::AdjustValue(operand, 0, 99));
+    });
+    report.Measure<T>("NumberInRange.Add", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(number + operand);
+    });
+    report.Measure<T>("NumberInRange.Subtract", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(number - operand);
+    });
+    report.Measure<T>("NumberInRange.Multiply", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(number * operand);
+    });
+
+    // Whole arrays wrapped by the range kernels
+    std::vector<T> output(OperationCount);
+    report.Measure<T>("NumberInRange.AdjustRange", OperationCount, 0, [&]
+    {
+      NumberInRange<T>::AdjustRange(operands.data(), output.data(), OperationCount, 0, 99);
+      DoNotOptimize(output);
+    });
+    report.Measure<T>("NumberInRange.AddRange", OperationCount, OperationCount, [&]
+    {
+      NumberInRange<T>::AddRange(operands.data(), operands.data(), output.data(), OperationCount, 0, 99);
+      DoNotOptimize(output);
+    });
+    report.Measure<T>("NumberInRange.MultiplyRange", OperationCount, OperationCount, [&]
+    {
+      NumberInRange<T>::MultiplyRange(operands.data(), operands.data(), output.data(), OperationCount, 0, 99);
+      DoNotOptimize(output);
+    });
+
+    // Other range policies over the same range
+    const NumberInRange<T, RangePolicy::Saturate> saturated(3, 0, 99);
+    const NumberInRange<T, RangePolicy::Reflect> reflected(3, 0, 99);
+    report.Measure<T>("NumberInRange.SaturateAdd", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(saturated + operand);
+    });
+    report.Measure<T>("NumberInRange.ReflectAdd", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(reflected + operand);
+    });
+    report.Measure<T>("NumberInRange.SaturateAdjustRange", OperationCount, 0, [&]
+    {
+      NumberInRange<T, RangePolicy::Saturate>::AdjustRange(operands.data(), output.data(), OperationCount, 0, 99);
+      DoNotOptimize(output);
+    });
+    report.Measure<T>("NumberInRange.ReflectAdjustRange", OperationCount, 0, [&]
+    {
+      NumberInRange<T, RangePolicy::Reflect>::AdjustRange(operands.data(), output.data(), OperationCount, 0, 99);
+      DoNotOptimize(output);
+    });
+
+    // Same range with compile-time bounds, and a power of two range wrapping by a mask
+    const StaticNumberInRange<T, 0, 99> staticNumber(3);
+    const StaticNumberInRange<T, 0, 127> maskedNumber(3);
+    report.Measure<T>("StaticNumberInRange.Add", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(staticNumber + operand);
+    });
+    report.Measure<T>("StaticNumberInRange.Multiply", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(staticNumber * operand);
+    });
+    report.Measure<T>("StaticNumberInRange.AddPowerOfTwo", OperationCount, OperationCount, [&]
+    {
+      for (const auto & operand : operands)
+        DoNotOptimize(maskedNumber + operand);
+    });
+  }
+
+  template <typename T>
+  static void RunModIntBenchmarks(Report & report, const T prime)
+  {
+    std::vector<T> operands(OperationCount);
+    for (unsigned i = 0; i < OperationCount; ++i)
+      operands[i] = static_cast<T>(prime - 1 - i * 7919u);
+
+    // Dependent chains of products modulo a prime, NumberInRange divides each product, ModInt reduces it in the Montgomery form
+    report.Measure<T>("NumberInRange.MultiplyChain", OperationCount, OperationCount, [&]
+    {
+      NumberInRange<T> number(2, 0, prime - 1);
+      for (const auto & operand : operands)
+        number.SetValue(number * operand);
+      DoNotOptimize(number.GetValue());
+    });
+    const MontgomeryModulus<T> modulus(prime);
+    report.Measure<T>("ModInt.MultiplyChain", OperationCount, OperationCount, [&]
+    {
+      ModInt<T> number(2, modulus);
+      for (const auto & operand : operands)
+        number *= ModInt<T>(operand, modulus);
+      DoNotOptimize(number.GetValue());
+    });
+
+    std::vector<T> montgomery(OperationCount);
+    modulus.ToMontgomeryRange(operands.data(), montgomery.data(), OperationCount);
+    report.Measure<T>("ModInt.MultiplyMontgomery", OperationCount, OperationCount, [&]
+    {
+      auto value = modulus.GetOne();
+      for (const auto & operand : montgomery)
+        value = modulus.Multiply(value, operand);
+      DoNotOptimize(value);
+    });
+  }
+
+  /**
+   * \brief Count of threads sharing a single counter
+   */
+  constexpr unsigned ThreadCount = 32;
+
+  /**
+   * \brief Runs given increment on every thread OperationCount times
+   */
+  template <typename TAction>
+  static void RunContended(TAction && action)
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(ThreadCount);
+    for (unsigned t = 0; t < ThreadCount; ++t)
+      threads.emplace_back([&action]
+      {
+        for (unsigned i = 0; i < OperationCount; ++i)
+          action();
+      });
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  template <typename T>
+  static void RunAtomicBenchmarks(Report & report)
+  {
+    // Round-robin cursors shared by all threads, the runs include starting and joining the threads
+    AtomicNumberInRange<T> cursor(0, 0, 99);
+    report.Measure<T>("AtomicNumberInRange.FetchAdd", ThreadCount, ThreadCount * OperationCount, [&]
+    {
+      RunContended([&cursor] { DoNotOptimize(cursor.FetchAdd(1)); });
+    });
+    AtomicNumberInRange<T> mask(0, 0, 127);
+    report.Measure<T>("AtomicNumberInRange.FetchAddPowerOfTwo", ThreadCount, ThreadCount * OperationCount, [&]
+    {
+      RunContended([&mask] { DoNotOptimize(mask.FetchAdd(1)); });
+    });
+    NumberInRange<T> number(0, 0, 99);
+    std::mutex mutex;
+    report.Measure<T>("NumberInRange.MutexFetchAdd", ThreadCount, ThreadCount * OperationCount, [&]
+    {
+      RunContended([&number, &mutex]
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto value = number.GetValue();
+        number += 1;
+        DoNotOptimize(value);
+      });
+    });
+  }
+
+  /**
+   * \brief SplitMix64 generator, cheap enough not to hide the cost of mapping the words into a range
+   */
+  class SplitMix64
+  {
+    std::uint64_t m_state = 0x9E3779B97F4A7C15ull;
+
+  public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator ()()
+    {
+      auto z = m_state += 0x9E3779B97F4A7C15ull;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+      return z ^ (z >> 31);
+    }
+  };
+
+  template <typename T>
+  static void RunRandomBenchmarks(Report & report)
+  {
+    SplitMix64 generator;
+    std::vector<T> output(OperationCount);
+    const T max = 999999;
+
+    // Wrapping random words is biased, the distributions are not
+    report.Measure<T>("NumberInRange.AdjustRandom", OperationCount, 0, [&]
+    {
+      for (auto & value : output)
+        value = NumberInRange<T>::AdjustValue(static_cast<T>(generator()), 0, max);
+      DoNotOptimize(output.data());
+    });
+    std::uniform_int_distribution<T> standard(0, max);
+    report.Measure<T>("UniformIntDistribution.Next", OperationCount, 0, [&]
+    {
+      for (auto & value : output)
+        value = standard(generator);
+      DoNotOptimize(output.data());
+    });
+    const UniformInRange<T> distribution(0, max);
+    report.Measure<T>("UniformInRange.Next", OperationCount, 0, [&]
+    {
+      for (auto & value : output)
+        value = distribution(generator);
+      DoNotOptimize(output.data());
+    });
+    report.Measure<T>("UniformInRange.Fill", OperationCount, 0, [&]
+    {
+      distribution.Fill(generator, output.data(), OperationCount);
+      DoNotOptimize(output.data());
+    });
+  }
+
+  void RunNumberInRangeBenchmarks(Report & report)
+  {
+    RunNumberInRangeBenchmarks<int>(report);
+    RunNumberInRangeBenchmarks<unsigned>(report);
+    RunNumberInRangeBenchmarks<long>(report);
+    RunModIntBenchmarks<unsigned>(report, 1000000007u);
+    RunModIntBenchmarks<unsigned long>(report, 2305843009213693951ul);
+    RunAtomicBenchmarks<int>(report);
+    RunAtomicBenchmarks<unsigned long>(report);
+    RunRandomBenchmarks<int>(report);
+    RunRandomBenchmarks<unsigned long>(report);
+  }
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bench.hpp"
+#include "../../CommonMath/NumberInRange.hpp"
+#include "../../CommonMath/RingBuffer.hpp"
+
+using namespace Common::Math;
+
+namespace Common::Math::Bench
+{
+  /**
+   * \brief Count of values passed through a buffer by a single run
+   */
+  constexpr unsigned TransferCount = 1 << 16;
+  /**
+   * \brief Count of slots of the buffers
+   */
+  constexpr std::size_t BufferCapacity = 1024;
+  /**
+   * \brief Count of values pushed and popped at once by the batch benchmarks
+   */
+  constexpr std::size_t BatchSize = 32;
+
+  /**
+   * \brief Circular queue indexed by NumberInRange and guarded by a mutex, the baseline of the lock-free buffers
+   */
+  template <typename T>
+  class MutexRingBuffer
+  {
+    std::mutex m_mutex;
+    std::vector<T> m_values;
+    NumberInRange<std::size_t> m_head;
+    NumberInRange<std::size_t> m_tail;
+    std::size_t m_size = 0;
+
+  public:
+    explicit MutexRingBuffer(const std::size_t capacity)
+      : m_values(capacity),
+      m_head(0, 0, capacity - 1),
+      m_tail(0, 0, capacity - 1) { }
+
+    bool TryPush(const T & value)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_size == m_values.size())
+        return false;
+
+      m_values[m_tail.GetValue()] = value;
+      m_tail += 1;
+      ++m_size;
+      return true;
+    }
+
+    bool TryPop(T & value)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_size == 0)
+        return false;
+
+      value = m_values[m_head.GetValue()];
+      m_head += 1;
+      --m_size;
+      return true;
+    }
+  };
+
+  /**
+   * \brief Passes TransferCount values from the producers to the consumers, threads yield while the buffer is full or empty
+   * \param push Pushes up to given count of values, returns the number pushed
+   * \param pop Pops up to given count of values, returns the number popped
+   */
+  template <typename TPush, typename TPop>
+  static void Transfer(const unsigned producerCount, const unsigned consumerCount, TPush && push, TPop && pop)
+  {
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < producerCount; ++p)
+      threads.emplace_back([&push, count = TransferCount / producerCount]
+      {
+        for (unsigned sent = 0; sent < count;)
+        {
+          const auto pushed = push(sent, count - sent);
+          sent += pushed;
+          if (pushed == 0)
+            std::this_thread::yield();
+        }
+      });
+    for (unsigned c = 0; c < consumerCount; ++c)
+      threads.emplace_back([&pop, count = TransferCount / consumerCount]
+      {
+        for (unsigned received = 0; received < count;)
+        {
+          const auto popped = pop(count - received);
+          received += popped;
+          if (popped == 0)
+            std::this_thread::yield();
+        }
+      });
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  template <typename TBuffer>
+  static void MeasureSingle(Report & report, const std::string & name, const unsigned threadCount)
+  {
+    TBuffer buffer(BufferCapacity);
+    report.Measure<int>(name, threadCount, 0, [&]
+    {
+      Transfer(threadCount, threadCount,
+        [&buffer](const unsigned value, unsigned) { return static_cast<unsigned>(buffer.TryPush(static_cast<int>(value))); },
+        [&buffer](unsigned)
+        {
+          int value = 0;
+          const auto popped = buffer.TryPop(value);
+          DoNotOptimize(value);
+          return static_cast<unsigned>(popped);
+        });
+    });
+  }
+
+  template <typename TBuffer>
+  static void MeasureBatch(Report & report, const std::string & name, const unsigned threadCount)
+  {
+    TBuffer buffer(BufferCapacity);
+    report.Measure<int>(name, threadCount, 0, [&]
+    {
+      Transfer(threadCount, threadCount,
+        [&buffer](const unsigned first, const unsigned remaining)
+        {
+          int values[BatchSize];
+          const auto count = std::min<std::size_t>(BatchSize, remaining);
+          for (std::size_t i = 0; i < count; ++i)
+            values[i] = static_cast<int>(first + i);
+          return static_cast<unsigned>(buffer.PushRange(values, count));
+        },
+        [&buffer](const unsigned remaining)
+        {
+          int values[BatchSize] = { };
+          const auto popped = buffer.PopRange(values, std::min<std::size_t>(BatchSize, remaining));
+          DoNotOptimize(values[0]);
+          return static_cast<unsigned>(popped);
+        });
+    });
+  }
+
+  void RunRingBufferBenchmarks(Report & report)
+  {
+    // Runs include starting and joining the threads, the size is the count of producers and of consumers
+    MeasureSingle<MutexRingBuffer<int>>(report, "MutexRingBuffer.Transfer", 1);
+    MeasureSingle<SpscRingBuffer<int>>(report, "SpscRingBuffer.Transfer", 1);
+    MeasureBatch<SpscRingBuffer<int>>(report, "SpscRingBuffer.TransferRange", 1);
+    MeasureSingle<MutexRingBuffer<int>>(report, "MutexRingBuffer.Transfer", 4);
+    MeasureSingle<MpmcRingBuffer<int>>(report, "MpmcRingBuffer.Transfer", 4);
+    MeasureBatch<MpmcRingBuffer<int>>(report, "MpmcRingBuffer.TransferRange", 4);
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../../CommonMath/Dispatch.hpp"
+
+namespace Common::Math::Tests
+{
+  /**
+   * \brief Builds the path of a scratch file in the temporary directory
+   * \param name Name of the file
+   * \return Path to the file
+   */
+  inline std::string GetTempFilePath(const std::string & name)
+  {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  /**
+   * \brief Fills a matrix with a repeating pattern, every value is produced from a pattern index from 0 to 10
+   * \param rows Number of rows
+   * \param columns Number of columns
+   * \param seed Shift of the pattern
+   * \param create Converts a pattern index to a value
+   * \return Matrix values
+   */
+  template <typename T, typename TCreate>
+  std::vector<std::vector<T>> CreateValues(const unsigned rows, const unsigned columns, const int seed, const TCreate & create)
+  {
+    std::vector<std::vector<T>> values(rows, std::vector<T>(columns));
+    for (unsigned i = 0; i < rows; ++i)
+      for (unsigned j = 0; j < columns; ++j)
+        values[i][j] = create((i * 7 + j * 3 + seed) % 11);
+
+    return values;
+  }
+
+  /**
+   * \brief Fills a matrix with a repeating pattern of small integers from -5 to 5, exact in every tested type
+   */
+  template <typename T>
+  std::vector<std::vector<T>> CreateValues(const unsigned rows, const unsigned columns, const int seed)
+  {
+    return CreateValues<T>(rows, columns, seed, [](const unsigned index) { return static_cast<T>(static_cast<T>(index) - 5); });
+  }
+
+  /**
+   * \brief Reference product of two matrices
+   */
+  template <typename T>
+  std::vector<std::vector<T>> MultiplyValues(const std::vector<std::vector<T>> & a, const std::vector<std::vector<T>> & b)
+  {
+    std::vector<std::vector<T>> result(a.size(), std::vector<T>(b[0].size()));
+    for (size_t i = 0; i < a.size(); ++i)
+      for (size_t j = 0; j < b[0].size(); ++j)
+        for (size_t k = 0; k < b.size(); ++k)
+          result[i][j] += a[i][k] * b[k][j];
+
+    return result;
+  }
+
+  /**
+   * \brief Lists the instruction sets the executing processor can run, kernel variants are compared on all of them
+   * \return Supported instruction sets, scalar first
+   */
+  inline std::vector<InstructionSet> GetSupportedInstructionSets()
+  {
+    const auto & features = Dispatch::GetCpuFeatures();
+    std::vector<InstructionSet> result { InstructionSet::Scalar };
+    if (features.sse42) result.push_back(InstructionSet::Sse42);
+    if (features.avx2 && features.fma) result.push_back(InstructionSet::Avx2);
+    if (features.avx2 && features.fma && features.avx512f) result.push_back(InstructionSet::Avx512);
+
+    return result;
+  }
+}
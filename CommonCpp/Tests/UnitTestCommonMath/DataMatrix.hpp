@@ -80,5 +80,45 @@ namespace Common::Math::Tests
           })
       };
     }
+
+    static std::vector<std::tuple<std::vector<std::vector<T>>, std::vector<std::vector<T>>, std::vector<std::vector<T>>>> GetMultiplicationClassClassData()
+    {
+      return
+      {
+        std::make_tuple(
+          std::vector<std::vector<T>>
+          {
+            std::vector<T> {1, 2, 3},
+            std::vector<T> {4, 5, 6}
+          },
+          std::vector<std::vector<T>>
+          {
+            std::vector<T> {7, 8},
+            std::vector<T> {9, 10},
+            std::vector<T> {11, 12}
+          },
+          std::vector<std::vector<T>>
+          {
+            std::vector<T> {58, 64},
+            std::vector<T> {139, 154}
+          }),
+        std::make_tuple(
+          std::vector<std::vector<T>>
+          {
+            std::vector<T> {2, -1},
+            std::vector<T> {0, 3}
+          },
+          std::vector<std::vector<T>>
+          {
+            std::vector<T> {1, 0},
+            std::vector<T> {0, 1}
+          },
+          std::vector<std::vector<T>>
+          {
+            std::vector<T> {2, -1},
+            std::vector<T> {0, 3}
+          })
+      };
+    }
   };
 }
\ No newline at end of file
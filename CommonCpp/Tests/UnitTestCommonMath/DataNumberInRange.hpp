@@ -24,7 +24,12 @@ namespace Common::Math::Tests
       {
         std::make_tuple(5, 0, 4, 0),
         std::make_tuple(0, 0, 4, 0),
-        std::make_tuple(-23, -8, -4, -8)
+        std::make_tuple(-23, -8, -4, -8),
+        std::make_tuple(7, -3, 4, -1),
+        std::make_tuple(-9, -3, 4, -1),
+        std::make_tuple(65, 1, 64, 1),
+        std::make_tuple(0, 1, 64, 64),
+        std::make_tuple(130, 1, 64, 2)
       };
     }
   };
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include "Bench.hpp"
+
+/**
+ * \brief Performance regression checks built on top of the Catch BENCHMARK macro.
+ * Measurements are compared with baselines stored in PerfBaseline.txt of the build directory. Durations depend on
+ * the machine, so baselines are not part of the sources and are recorded on the machine running the checks first.
+ * Benchmarks without a baseline only report a warning:
+ * - COMMON_MATH_PERF_BASELINE overrides the path of the baseline file
+ * - COMMON_MATH_PERF_THRESHOLD sets the tolerated slowdown ratio, 1.5 by default
+ * - COMMON_MATH_PERF_RECORD set to 1 records the measurements as new baselines instead of checking them
+ */
+namespace Common::Math::Perf
+{
+  /**
+   * \brief Count of times each benchmark is run, the fastest run is compared with the baseline
+   */
+  constexpr unsigned Repetitions = 5;
+
+  using Bench::DoNotOptimize;
+  using Bench::GetTypeName;
+
+  /**
+   * \brief Composes the name of a benchmark
+   * \param operation Name of the measured operation
+   * \param type Name of the value type
+   * \param size Size of the problem
+   * \return Name of the benchmark, also used as the baseline key
+   */
+  inline std::string GetName(const std::string & operation, const std::string & type, const unsigned size)
+  {
+    auto name = operation + "/" + type + "/" + std::to_string(size);
+    for (auto & c : name)
+      if (c == ' ')
+        c = '_';
+
+    return name;
+  }
+
+  /**
+   * \brief Compares the last measurement of given benchmark with its baseline,
+   * fails the running test case if the slowdown exceeds the threshold
+   * \param name Name of the benchmark
+   */
+  void CheckBaseline(const std::string & name);
+}
+
+/**
+ * \brief Runs the following block as a Catch benchmark repeatedly, keeping the fastest measurement
+ */
+#define PERF_BENCHMARK(name) \
+  for (unsigned perfRepetition = 0; perfRepetition < Common::Math::Perf::Repetitions; ++perfRepetition) \
+    BENCHMARK(name)
@@ -0,0 +1,142 @@
+#define CATCH_CONFIG_RUNNER
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "../catch.hpp"
+#include "Perf.hpp"
+
+#ifndef COMMON_MATH_PERF_BASELINE_PATH
+#define COMMON_MATH_PERF_BASELINE_PATH "PerfBaseline.txt"
+#endif
+
+namespace Common::Math::Perf
+{
+  /**
+   * \brief Default tolerated ratio between the measured and the baseline duration
+   */
+  constexpr double DefaultThreshold = 1.5;
+
+  /**
+   * \brief Benchmark durations in nanoseconds per iteration, keyed by the benchmark name
+   */
+  using Timings = std::map<std::string, double>;
+
+  static Timings s_measured;
+  static Timings s_baseline;
+
+  static std::string GetBaselinePath()
+  {
+    const auto path = std::getenv("COMMON_MATH_PERF_BASELINE");
+    return path != nullptr ? path : COMMON_MATH_PERF_BASELINE_PATH;
+  }
+
+  static double GetThreshold()
+  {
+    const auto value = std::getenv("COMMON_MATH_PERF_THRESHOLD");
+    return value != nullptr ? std::stod(value) : DefaultThreshold;
+  }
+
+  static bool IsRecording()
+  {
+    const auto value = std::getenv("COMMON_MATH_PERF_RECORD");
+    return value != nullptr && std::string(value) == "1";
+  }
+
+  static Timings LoadTimings(const std::string & path)
+  {
+    Timings timings;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+      if (line.empty() || line[0] == '#')
+        continue;
+
+      std::istringstream fields(line);
+      std::string name;
+      double nanoseconds;
+      if (fields >> name >> nanoseconds)
+        timings[name] = nanoseconds;
+    }
+
+    return timings;
+  }
+
+  static void SaveTimings(const std::string & path, const Timings & timings)
+  {
+    std::ofstream file(path);
+    file << "# Benchmark nanoseconds per iteration, recorded with COMMON_MATH_PERF_RECORD=1\n";
+    for (const auto &[name, nanoseconds] : timings)
+      file << name << ' ' << nanoseconds << '\n';
+  }
+
+  void CheckBaseline(const std::string & name)
+  {
+    const auto measured = s_measured.find(name);
+    REQUIRE(measured != s_measured.end());
+    if (IsRecording())
+      return;
+
+    const auto baseline = s_baseline.find(name);
+    if (baseline == s_baseline.end())
+    {
+      WARN("No baseline recorded for " << name);
+      return;
+    }
+
+    const auto threshold = GetThreshold();
+    INFO(name << " took " << measured->second << " ns, baseline is " << baseline->second << " ns");
+    CHECK(measured->second <= baseline->second * threshold);
+  }
+
+  /**
+   * \brief Collects the fastest result of each Catch benchmark
+   */
+  struct BaselineListener : Catch::TestEventListenerBase
+  {
+    using TestEventListenerBase::TestEventListenerBase;
+
+    void benchmarkEnded(const Catch::BenchmarkStats & stats) override
+    {
+      const auto nanoseconds = static_cast<double>(stats.elapsedTimeInNanoseconds) / static_cast<double>(stats.iterations);
+      const auto measured = s_measured.find(stats.info.name);
+      if (measured == s_measured.end())
+        s_measured.emplace(stats.info.name, nanoseconds);
+      else if (nanoseconds < measured->second)
+        measured->second = nanoseconds;
+    }
+  };
+}
+
+using Common::Math::Perf::BaselineListener;
+CATCH_REGISTER_LISTENER(BaselineListener)
+
+int main(const int argc, char * argv[])
+{
+  using namespace Common::Math::Perf;
+
+  Catch::Session session;
+  // Measure each benchmark for milliseconds rather than microseconds to reduce noise
+  session.configData().benchmarkResolutionMultiple = 100000;
+  const auto error = session.applyCommandLine(argc, argv);
+  if (error != 0)
+    return error;
+
+  const auto path = GetBaselinePath();
+  s_baseline = LoadTimings(path);
+  if (s_baseline.empty() && !IsRecording())
+    std::cerr << "No baselines found in " << path << ", run with COMMON_MATH_PERF_RECORD=1 to record them on this machine.\n";
+  const auto result = session.run();
+
+  if (IsRecording())
+  {
+    // Baselines of benchmarks excluded from this run are kept
+    for (const auto &[name, nanoseconds] : s_measured)
+      s_baseline[name] = nanoseconds;
+    SaveTimings(path, s_baseline);
+  }
+
+  return result;
+}
@@ -0,0 +1,109 @@
+#include "../catch.hpp"
+#include "../../CommonMath/Matrix.hpp"
+#include "DataFixtures.hpp"
+#include "Perf.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Perf;
+
+template <typename T>
+static std::vector<std::vector<T>> CreateDominantValues(const unsigned size, const int seed)
+{
+  auto values = Tests::CreateValues<T>(size, size, seed);
+
+  // Dominant diagonal keeps the matrix invertible
+  for (unsigned i = 0; i < size; ++i)
+    values[i][i] = static_cast<T>(6 * size);
+
+  return values;
+}
+
+// ARITHMETIC
+
+TEMPLATE_TEST_CASE("Matrix addition performance", "[Perf][Matrix][Template]", int, float, double)
+{
+  for (const auto size : { 16u, 64u, 256u })
+  {
+    // Arrange
+    const Matrix<TestType> a(CreateDominantValues<TestType>(size, 1));
+    const Matrix<TestType> b(CreateDominantValues<TestType>(size, 4));
+    const auto name = GetName("Matrix.Add", GetTypeName<TestType>(), size);
+
+    // Act
+    PERF_BENCHMARK(name)
+    {
+      auto result = a + b;
+      DoNotOptimize(result);
+    }
+
+    // Assert
+    CheckBaseline(name);
+  }
+}
+
+TEMPLATE_TEST_CASE("Matrix multiplication performance", "[Perf][Matrix][Template]", int, float, double)
+{
+  for (const auto size : { 16u, 64u, 256u })
+  {
+    // Arrange
+    const Matrix<TestType> a(CreateDominantValues<TestType>(size, 1));
+    const Matrix<TestType> b(CreateDominantValues<TestType>(size, 4));
+    const auto name = GetName("Matrix.Multiply", GetTypeName<TestType>(), size);
+
+    // Act
+    PERF_BENCHMARK(name)
+    {
+      auto result = a * b;
+      DoNotOptimize(result);
+    }
+
+    // Assert
+    CheckBaseline(name);
+  }
+}
+
+TEMPLATE_TEST_CASE("Matrix transposition performance", "[Perf][Matrix][Template]", int, float, double)
+{
+  for (const auto size : { 16u, 64u, 256u })
+  {
+    // Arrange
+    const Matrix<TestType> a(CreateDominantValues<TestType>(size, 1));
+    const auto name = GetName("Matrix.Transpose", GetTypeName<TestType>(), size);
+
+    // Act
+    PERF_BENCHMARK(name)
+    {
+      auto result = a.Transpose();
+      DoNotOptimize(result);
+    }
+
+    // Assert
+    CheckBaseline(name);
+  }
+}
+
+// DETERMINANT AND INVERSE
+
+TEMPLATE_TEST_CASE("Matrix determinant and inverse performance", "[Perf][Matrix][Template]", float, double)
+{
+  // Cofactor expansion limits the measured size
+  const unsigned size = 6;
+  const auto values = CreateDominantValues<TestType>(size, 1);
+  const auto determinantName = GetName("Matrix.Determinant", GetTypeName<TestType>(), size);
+  const auto inverseName = GetName("Matrix.Inverse", GetTypeName<TestType>(), size);
+
+  // Both properties are cached, hence every iteration measures a freshly constructed matrix
+  PERF_BENCHMARK(determinantName)
+  {
+    const Matrix<TestType> matrix(values);
+    DoNotOptimize(matrix.GetDeterminant());
+  }
+  PERF_BENCHMARK(inverseName)
+  {
+    const Matrix<TestType> matrix(values);
+    DoNotOptimize(matrix.GetInverse());
+  }
+
+  CheckBaseline(determinantName);
+  CheckBaseline(inverseName);
+}
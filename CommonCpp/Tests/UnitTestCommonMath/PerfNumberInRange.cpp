@@ -0,0 +1,44 @@
+#include "../catch.hpp"
+#include "../../CommonMath/NumberInRange.hpp"
+#include "Perf.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Perf;
+
+// ARITHMETIC
+
+TEMPLATE_TEST_CASE("NumberInRange arithmetic performance", "[Perf][NumberInRange][Template]", int, unsigned, long)
+{
+  // Arrange
+  const unsigned count = 1024;
+  std::vector<TestType> operands(count);
+  for (unsigned i = 0; i < count; ++i)
+    operands[i] = static_cast<TestType>(i * 37 % 1000);
+
+  const NumberInRange<TestType> number(3, 0, 99);
+  const auto addName = GetName("NumberInRange.Add", GetTypeName<TestType>(), count);
+  const auto subtractName = GetName("NumberInRange.Subtract", GetTypeName<TestType>(), count);
+  const auto multiplyName = GetName("NumberInRange.Multiply", GetTypeName<TestType>(), count);
+
+  // Act
+  PERF_BENCHMARK(addName)
+  {
+    for (const auto & operand : operands)
+      DoNotOptimize(number + operand);
+  }
+  PERF_BENCHMARK(subtractName)
+  {
+    for (const auto & operand : operands)
+      DoNotOptimize(number - operand);
+  }
+  PERF_BENCHMARK(multiplyName)
+  {
+    for (const auto & operand : operands)
+      DoNotOptimize(number * operand);
+  }
+
+  // Assert
+  CheckBaseline(addName);
+  CheckBaseline(subtractName);
+  CheckBaseline(multiplyName);
+}
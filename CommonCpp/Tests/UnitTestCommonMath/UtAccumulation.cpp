@@ -0,0 +1,154 @@
+#include <cmath>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/Matrix.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+static const char * GetAccumulationName(const Accumulation accumulation)
+{
+  switch (accumulation)
+  {
+  case Accumulation::Pairwise: return "Pairwise";
+  case Accumulation::KahanNeumaier: return "KahanNeumaier";
+  case Accumulation::Wide: return "Wide";
+  default: return "Naive";
+  }
+}
+
+// REDUCTIONS
+
+TEST_CASE("Compensated policies sum absorbed values", "[Accumulation]")
+{
+  // Arrange
+  // Every small value is below half a unit in the last place of the leading one
+  std::vector<float> values(1000001, 1e-8f);
+  values[0] = 1;
+  const auto expected = 1.01;
+
+  for (const auto instructionSet : GetSupportedInstructionSets())
+  {
+    SECTION(std::string("Instruction set: ") + Dispatch::GetInstructionSetName(instructionSet))
+    {
+      // Act
+      const auto kernels = SelectReductionKernels<float>(instructionSet);
+      const auto pairwise = kernels.sum[static_cast<unsigned>(Accumulation::Pairwise)](values.data(), values.size());
+      const auto kahan = kernels.sum[static_cast<unsigned>(Accumulation::KahanNeumaier)](values.data(), values.size());
+      const auto wide = kernels.sum[static_cast<unsigned>(Accumulation::Wide)](values.data(), values.size());
+
+      // Assert
+      REQUIRE(kernels.instructionSet == instructionSet);
+      REQUIRE(std::abs(pairwise - expected) < 1e-5);
+      REQUIRE(std::abs(kahan - expected) < 1e-7);
+      REQUIRE(std::abs(wide - expected) < 1e-7);
+    }
+  }
+}
+
+TEST_CASE("Compensated summation handles addends larger than the sum", "[Accumulation]")
+{
+  // Arrange
+  const std::vector<double> values { 1, 1e100, 1, -1e100 };
+
+  // Act & Assert
+  REQUIRE(Reduction::Sum(values.data(), values.size(), Accumulation::KahanNeumaier) == 2);
+}
+
+TEMPLATE_TEST_CASE("Dot products agree across policies and instruction sets", "[Accumulation][Template]", double, float)
+{
+  // Arrange
+  const std::size_t count = 1037;
+  std::vector<TestType> a(count), b(count);
+  long double reference = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    a[i] = static_cast<TestType>(std::sin(static_cast<double>(i)));
+    b[i] = static_cast<TestType>(std::cos(static_cast<double>(i) * 0.5));
+    reference += static_cast<long double>(a[i]) * b[i];
+  }
+
+  for (const auto instructionSet : GetSupportedInstructionSets())
+    for (const auto accumulation : { Accumulation::Naive, Accumulation::Pairwise, Accumulation::KahanNeumaier, Accumulation::Wide })
+    {
+      SECTION(std::string("Instruction set: ") + Dispatch::GetInstructionSetName(instructionSet) + ", policy: " + GetAccumulationName(accumulation))
+      {
+        // Act
+        const auto kernels = SelectReductionKernels<TestType>(instructionSet);
+        const auto result = kernels.dot[static_cast<unsigned>(accumulation)](a.data(), b.data(), count);
+
+        // Assert
+        REQUIRE(std::abs(static_cast<long double>(result) - reference) < (std::is_same<TestType, float>::value ? 1e-3 : 1e-11));
+      }
+    }
+}
+
+TEST_CASE("Wide accumulation avoids integer overflow", "[Accumulation]")
+{
+  // Arrange
+  const std::vector<int> values { 2000000000, 2000000000, -2000000000, -1999999999 };
+
+  // Act & Assert
+  REQUIRE(Reduction::Sum(values.data(), values.size(), Accumulation::Wide) == 1);
+}
+
+// MATRIX
+
+TEMPLATE_TEST_CASE("Matrix multiplication policies equal the multiplication operator", "[Accumulation][Template]", int, long, double)
+{
+  // Arrange
+  std::vector<std::vector<TestType>> valuesA(5, std::vector<TestType>(7)), valuesB(7, std::vector<TestType>(3));
+  for (unsigned i = 0; i < 7; ++i)
+    for (unsigned j = 0; j < 5; ++j)
+    {
+      valuesA[j][i] = static_cast<TestType>((i * 7 + j * 3) % 11) - 5;
+      if (j < 3)
+        valuesB[i][j] = static_cast<TestType>((i * 5 + j) % 13) - 6;
+    }
+  const Matrix<TestType> a(valuesA), b(valuesB);
+  const auto expected = (a * b).GetMatrixValues();
+
+  for (const auto accumulation : { Accumulation::Naive, Accumulation::Pairwise, Accumulation::KahanNeumaier, Accumulation::Wide })
+  {
+    SECTION(std::string("Policy: ") + GetAccumulationName(accumulation))
+    {
+      // Act & Assert
+      REQUIRE(a.Multiply(b, accumulation).GetMatrixValues() == expected);
+      REQUIRE_THROWS_AS(a.Multiply(a, accumulation), MatrixDimensionException);
+    }
+  }
+}
+
+TEST_CASE("Matrix determinant and sum policies", "[Accumulation]")
+{
+  // Arrange
+  const Matrix<double> matrix(std::vector<std::vector<double>> { { 2, 0, 1, 3 }, { 1, 1, 0, 2 }, { 0, 4, 1, 1 }, { 3, 1, 2, 0 } });
+
+  for (const auto accumulation : { Accumulation::Naive, Accumulation::Pairwise, Accumulation::KahanNeumaier, Accumulation::Wide })
+  {
+    SECTION(std::string("Policy: ") + GetAccumulationName(accumulation))
+    {
+      // Act & Assert
+      REQUIRE(matrix.GetDeterminant(accumulation) == Approx(-28));
+      REQUIRE(matrix.Sum(accumulation) == 22);
+    }
+  }
+}
+
+TEST_CASE("Matrix sum keeps a single accumulator across rows", "[Accumulation]")
+{
+  // Arrange, the first row alone sums to 2^24 + 1 which float cannot represent, the whole matrix sums to 2^24 + 2
+  const Matrix<float> matrix(std::vector<std::vector<float>> { { 16777216.0f, 1 }, { 1, 0 } });
+
+  for (const auto accumulation : { Accumulation::KahanNeumaier, Accumulation::Wide })
+  {
+    SECTION(std::string("Policy: ") + GetAccumulationName(accumulation))
+    {
+      // Act & Assert
+      REQUIRE(matrix.Sum(accumulation) == 16777218.0f);
+    }
+  }
+
+  REQUIRE(matrix.Sum() == 16777216.0f);
+}
@@ -0,0 +1,117 @@
+#include <climits>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/AtomicNumberInRange.hpp"
+
+using namespace Common::Math;
+
+template <typename T>
+static std::vector<std::pair<T, T>> GetRanges()
+{
+  std::vector<std::pair<T, T>> ranges { { 0, 4 }, { 0, 99 }, { 0, 127 }, { 1, 64 }, { 3, 9 }, { 0, 1 } };
+  ranges.emplace_back(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+  ranges.emplace_back(0, std::numeric_limits<T>::max());
+  if constexpr (std::is_signed<T>::value)
+  {
+    ranges.emplace_back(-3, 4);
+    ranges.emplace_back(-8, 7);
+    ranges.emplace_back(-100, 99);
+  }
+
+  return ranges;
+}
+
+static_assert(alignof(AtomicNumberInRange<int>) == 64, "Counters do not share cache lines.");
+static_assert(sizeof(AtomicNumberInRange<char>) % 64 == 0, "Counters do not share cache lines.");
+
+TEMPLATE_TEST_CASE("Atomic fetch operations match NumberInRange", "[AtomicNumberInRange][Template]", char, short, int, long long, unsigned, unsigned long long)
+{
+  const std::vector<TestType> deltas { 0, 1, 2, 5, 13, 100, std::numeric_limits<TestType>::max(), std::numeric_limits<TestType>::min(),
+    static_cast<TestType>(std::numeric_limits<TestType>::max() - 1), static_cast<TestType>(-1) };
+
+  for (const auto &[min, max] : GetRanges<TestType>())
+  {
+    // Arrange
+    AtomicNumberInRange<TestType> atomic(min, min, max);
+    TestType expected = min;
+    REQUIRE(atomic.GetMin() == min);
+    REQUIRE(atomic.GetMax() == max);
+
+    for (const auto delta : deltas)
+    {
+      // Act
+      const auto added = atomic.FetchAdd(delta);
+      const auto addedValue = atomic.GetValue();
+      const auto subtracted = atomic.FetchSubtract(static_cast<TestType>(delta / 3));
+
+      // Assert
+      REQUIRE(added == expected);
+      expected = NumberInRange<TestType>(expected, min, max) + delta;
+      REQUIRE(addedValue == expected);
+      REQUIRE(subtracted == expected);
+      expected = NumberInRange<TestType>(expected, min, max) - static_cast<TestType>(delta / 3);
+      REQUIRE(atomic.GetValue() == expected);
+    }
+  }
+}
+
+TEST_CASE("Atomic value is wrapped when set", "[AtomicNumberInRange]")
+{
+  // Arrange
+  AtomicNumberInRange<int> number(-12, -3, 4);
+  AtomicNumberInRange<unsigned> mask(300, 0, 255);
+
+  // Act
+  const auto initial = number.GetValue();
+  number.SetValue(INT_MAX);
+
+  // Assert
+  REQUIRE(initial == 4);
+  REQUIRE(number.GetValue() == NumberInRange<int>::AdjustValue(INT_MAX, -3, 4));
+  REQUIRE(mask.GetValue() == 44);
+  REQUIRE(mask.FetchSubtract(45) == 44);
+  REQUIRE(mask.GetValue() == 255);
+  REQUIRE_THROWS_AS(AtomicNumberInRange<int>(0, 5, 4), std::invalid_argument);
+}
+
+TEST_CASE("Atomic counters hand out every value equally often", "[AtomicNumberInRange]")
+{
+  const auto check = [](const int min, const int max, const int delta)
+  {
+    // Arrange
+    const int threadCount = 8, increments = 5000, length = max - min + 1;
+    AtomicNumberInRange<int> counter(min, min, max);
+    std::vector<std::vector<int>> counts(threadCount, std::vector<int>(length));
+    std::vector<std::thread> threads;
+
+    // Act
+    for (auto t = 0; t < threadCount; ++t)
+      threads.emplace_back([&counter, &counts, t, min, delta]
+      {
+        for (auto i = 0; i < increments; ++i)
+          ++counts[t][counter.FetchAdd(delta, std::memory_order_relaxed) - min];
+      });
+    for (auto & thread : threads)
+      thread.join();
+
+    // Assert, the deltas are coprime to the lengths
+    const auto total = static_cast<long long>(threadCount) * increments;
+    REQUIRE(counter.GetValue() == NumberInRange<int>::AdjustValue(static_cast<int>(min + total * delta % length), min, max));
+    for (auto i = 0; i < length; ++i)
+    {
+      auto count = 0;
+      for (const auto & threadCounts : counts)
+        count += threadCounts[i];
+      REQUIRE(count == total / length);
+    }
+  };
+
+  check(0, 99, 1);
+  check(-8, 7, 1);
+  check(0, 99, -7);
+  check(3, 66, 3);
+}
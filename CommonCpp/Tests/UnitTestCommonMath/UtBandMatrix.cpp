@@ -0,0 +1,145 @@
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/BandMatrix.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+template <typename T>
+static BandMatrix<T> CreateBand(const unsigned size, const unsigned lower, const unsigned upper, const int seed)
+{
+  const auto values = CreateValues<T>(size, size, seed);
+  BandMatrix<T> matrix(size, lower, upper);
+  for (unsigned i = 0; i < size; ++i)
+    for (auto j = matrix.GetRowBegin(i); j < matrix.GetRowEnd(i); ++j)
+      matrix.Set(i, j, values[i][j]);
+
+  return matrix;
+}
+
+template <typename T>
+static std::vector<T> CreateVector(const unsigned size, const int seed)
+{
+  std::vector<T> values(size);
+  for (unsigned i = 0; i < size; ++i)
+    values[i] = static_cast<T>((i * 5 + seed) % 9) - 4;
+
+  return values;
+}
+
+// STORAGE
+
+TEMPLATE_TEST_CASE("Band matrix stores only its band", "[BandMatrix][Template]", int, long, double, float)
+{
+  // Arrange
+  std::vector<std::vector<TestType>> values(6, std::vector<TestType>(6));
+  for (unsigned i = 0; i < 6; ++i)
+    for (unsigned j = 0; j < 6; ++j)
+      values[i][j] = static_cast<TestType>(i * 6 + j + 1);
+
+  // Act
+  const BandMatrix<TestType> band(Matrix<TestType>(values), 2, 1);
+  const auto expanded = band.ToMatrix().GetMatrixValues();
+
+  // Assert
+  for (unsigned i = 0; i < 6; ++i)
+    for (unsigned j = 0; j < 6; ++j)
+    {
+      const auto inBand = j + 2 >= i && j <= i + 1;
+      REQUIRE(band.Get(i, j) == (inBand ? values[i][j] : 0));
+      REQUIRE(expanded[i][j] == band.Get(i, j));
+    }
+}
+
+TEST_CASE("Band matrix rejects values outside of the band", "[BandMatrix]")
+{
+  BandMatrix<double> matrix(5, 1, 2);
+
+  REQUIRE_NOTHROW(matrix.Set(0, 2, 1));
+  REQUIRE_NOTHROW(matrix.Set(4, 3, 1));
+  REQUIRE_THROWS_AS(matrix.Set(0, 3, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(matrix.Set(4, 2, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(matrix.Set(5, 5, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(BandMatrix<double>(0, 1, 1), std::invalid_argument);
+  // Bandwidths are limited by the size of the matrix
+  REQUIRE(BandMatrix<double>(3, 7, 9).GetLower() == 2);
+}
+
+// OPERATIONS
+
+TEMPLATE_TEST_CASE("Band product equals full product", "[BandMatrix][Template]", int, long, double, float)
+{
+  for (const auto &[lower, upper] : { std::pair<unsigned, unsigned> { 0, 0 }, { 1, 1 }, { 3, 0 }, { 2, 4 } })
+  {
+    SECTION("Lower: " + std::to_string(lower) + ", upper: " + std::to_string(upper))
+    {
+      // Arrange
+      const auto band = CreateBand<TestType>(13, lower, upper, 1);
+      const auto vector = CreateVector<TestType>(13, 2);
+
+      // Act
+      const auto product = band * vector;
+
+      // Assert
+      REQUIRE(product == band.ToMatrix() * vector);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Band systems are solved with pivoting", "[BandMatrix][Template]", double, float)
+{
+  for (const auto &[lower, upper] : { std::pair<unsigned, unsigned> { 0, 0 }, { 1, 1 }, { 3, 0 }, { 2, 4 }, { 0, 3 } })
+  {
+    SECTION("Lower: " + std::to_string(lower) + ", upper: " + std::to_string(upper))
+    {
+      // Arrange
+      auto band = CreateBand<TestType>(40, lower, upper, 3);
+      // Small diagonal values force row interchanges, triangular bands cannot exchange rows and stay dominant
+      const auto pivoting = lower > 0 && upper > 0;
+      for (unsigned i = 0; i < 40; ++i)
+        band.Set(i, i, static_cast<TestType>(pivoting && i % 3 == 0 ? 0.01 : 7));
+      const auto vector = CreateVector<TestType>(40, 4);
+
+      // Act
+      const auto solution = band.Solve(vector);
+
+      // Assert
+      const auto restored = band * solution;
+      for (unsigned i = 0; i < 40; ++i)
+        REQUIRE(restored[i] == Approx(vector[i]).margin(1e-3));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Band determinant equals the cofactor expansion", "[BandMatrix][Template]", double, float)
+{
+  // Arrange
+  const auto band = CreateBand<TestType>(7, 2, 1, 5);
+
+  // Act
+  const auto determinant = band.GetDeterminant();
+
+  // Assert
+  REQUIRE(determinant == Approx(band.ToMatrix().GetDeterminant()));
+  REQUIRE(BandMatrix<TestType>(4, 1, 1).GetDeterminant() == 0);
+}
+
+TEST_CASE("Band factorization is reusable", "[BandMatrix]")
+{
+  // Arrange
+  const auto band = CreateBand<double>(25, 2, 2, 7);
+  const auto factorization = band.Factorize();
+
+  for (const auto seed : { 1, 2, 3 })
+  {
+    // Act
+    const auto vector = CreateVector<double>(25, seed);
+    const auto solution = factorization.Solve(vector);
+
+    // Assert
+    REQUIRE(solution == band.Solve(vector));
+  }
+  REQUIRE_THROWS_AS(BandMatrix<double>(4, 1, 1).Solve(std::vector<double>(4, 1)), InvertableMatrixOperationException);
+  REQUIRE_THROWS_AS(band.Solve(std::vector<double>(24, 1)), MatrixDimensionException);
+}
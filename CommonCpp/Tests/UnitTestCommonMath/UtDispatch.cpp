@@ -0,0 +1,116 @@
+#include <string>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/MatrixKernels.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+// DISPATCH
+
+TEST_CASE("Instruction set names are parsed", "[Dispatch]")
+{
+  for (const auto instructionSet : { InstructionSet::Scalar, InstructionSet::Sse42, InstructionSet::Avx2, InstructionSet::Avx512 })
+    REQUIRE(Dispatch::ParseInstructionSet(Dispatch::GetInstructionSetName(instructionSet)) == instructionSet);
+
+  REQUIRE(Dispatch::ParseInstructionSet(nullptr) == InstructionSet::Avx512);
+}
+
+TEST_CASE("Selected instruction set is supported by the processor", "[Dispatch]")
+{
+  const auto supported = GetSupportedInstructionSets();
+
+  REQUIRE(Dispatch::GetInstructionSet() <= supported.back());
+  REQUIRE(GetMatrixKernels<double>().instructionSet == Dispatch::GetInstructionSet());
+  REQUIRE(GetMatrixKernels<int>().instructionSet == Dispatch::GetInstructionSet());
+}
+
+TEMPLATE_TEST_CASE("Kernel variants produce equal results", "[Dispatch][Template]", double, float, int)
+{
+  // Odd length exercises the remainder loops of all vector widths
+  const std::size_t count = 37;
+  std::vector<TestType> a(count), b(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    a[i] = static_cast<TestType>(i) * static_cast<TestType>(0.5) - 3;
+    b[i] = static_cast<TestType>(count - i) * static_cast<TestType>(0.25);
+  }
+
+  const auto reference = SelectMatrixKernels<TestType>(InstructionSet::Scalar);
+  for (const auto instructionSet : GetSupportedInstructionSets())
+  {
+    SECTION(std::string("Instruction set: ") + Dispatch::GetInstructionSetName(instructionSet))
+    {
+      const auto kernels = SelectMatrixKernels<TestType>(instructionSet);
+      REQUIRE(kernels.instructionSet == instructionSet);
+
+      std::vector<TestType> expected(count), actual(count);
+      reference.add(a.data(), b.data(), expected.data(), count);
+      kernels.add(a.data(), b.data(), actual.data(), count);
+      REQUIRE(actual == expected);
+
+      reference.subtract(a.data(), b.data(), expected.data(), count);
+      kernels.subtract(a.data(), b.data(), actual.data(), count);
+      REQUIRE(actual == expected);
+
+      reference.scale(a.data(), 3, expected.data(), count);
+      kernels.scale(a.data(), 3, actual.data(), count);
+      REQUIRE(actual == expected);
+
+      // Values are exactly representable, hence fused and separate multiply-add agree
+      expected = b;
+      actual = b;
+      reference.multiplyAdd(2, a.data(), expected.data(), count);
+      kernels.multiplyAdd(2, a.data(), actual.data(), count);
+      REQUIRE(actual == expected);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Tile kernel variants produce equal results", "[Dispatch][Template]", double, float, int, short)
+{
+  // Column count exercises the register groups and the remainder of every vector width
+  const std::size_t depth = 9, count = 45;
+  std::vector<std::vector<TestType>> a(Kernels::MaxTileRows, std::vector<TestType>(depth)), b(depth, std::vector<TestType>(count));
+  std::vector<const TestType *> aRows, bRows;
+  for (std::size_t r = 0; r < Kernels::MaxTileRows; ++r)
+  {
+    for (std::size_t k = 0; k < depth; ++k)
+      a[r][k] = static_cast<TestType>(static_cast<int>((r * 5 + k) % 7) - 3);
+    aRows.push_back(a[r].data());
+  }
+  for (std::size_t k = 0; k < depth; ++k)
+  {
+    for (std::size_t j = 0; j < count; ++j)
+      b[k][j] = static_cast<TestType>(static_cast<int>((k * 3 + j) % 11) - 5);
+    bRows.push_back(b[k].data());
+  }
+
+  const auto reference = SelectMatrixKernels<TestType>(InstructionSet::Scalar);
+  for (const auto instructionSet : GetSupportedInstructionSets())
+    for (std::size_t rows = 1; rows <= Kernels::MaxTileRows; ++rows)
+    {
+      SECTION(std::string("Instruction set: ") + Dispatch::GetInstructionSetName(instructionSet) + ", rows: " + std::to_string(rows))
+      {
+        // Arrange
+        const auto kernels = SelectMatrixKernels<TestType>(instructionSet);
+        std::vector<std::vector<TestType>> expected(rows, std::vector<TestType>(count, 1)), actual = expected;
+        std::vector<TestType *> expectedRows, actualRows;
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+          expectedRows.push_back(expected[r].data());
+          actualRows.push_back(actual[r].data());
+        }
+
+        // Act
+        reference.multiplyAddTile(aRows.data(), bRows.data(), expectedRows.data(), rows, depth, count);
+        kernels.multiplyAddTile(aRows.data(), bRows.data(), actualRows.data(), rows, depth, count);
+
+        // Assert
+        REQUIRE(actual == expected);
+        REQUIRE(expected[0][0] == static_cast<TestType>(1 + a[0][0] * b[0][0] + a[0][1] * b[1][0] + a[0][2] * b[2][0] + a[0][3] * b[3][0]
+          + a[0][4] * b[4][0] + a[0][5] * b[5][0] + a[0][6] * b[6][0] + a[0][7] * b[7][0] + a[0][8] * b[8][0]));
+      }
+    }
+}
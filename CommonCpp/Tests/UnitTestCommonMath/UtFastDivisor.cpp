@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/FastDivisor.hpp"
+
+using namespace Common::Math;
+
+template <typename T>
+static std::vector<T> GetValues()
+{
+  const auto max = std::numeric_limits<T>::max();
+  std::vector<T> values;
+  for (const unsigned long long value : { 0ull, 1ull, 2ull, 3ull, 5ull, 7ull, 10ull, 99ull, 100ull, 127ull, 128ull, 255ull, 641ull, 1000ull, 6700417ull })
+    if (value <= max)
+      values.push_back(static_cast<T>(value));
+  for (T power = 1; power != 0; power = static_cast<T>(power << 1))
+  {
+    values.push_back(static_cast<T>(power - 1));
+    values.push_back(power);
+    values.push_back(static_cast<T>(power + 1));
+  }
+  values.push_back(static_cast<T>(max / 3));
+  values.push_back(static_cast<T>(max / 2));
+  values.push_back(static_cast<T>(max - 1));
+  values.push_back(max);
+
+  return values;
+}
+
+/**
+ * \brief Reference product by doubling, sums of values less than the divisor are reduced before they overflow
+ */
+template <typename T>
+static T MultiplyModulo(const T left, const T right, const T divisor)
+{
+  const auto addModulo = [divisor](const T a, const T b)
+  {
+    return b >= divisor - a ? static_cast<T>(b - (divisor - a)) : static_cast<T>(a + b);
+  };
+
+  T result = 0, addend = left;
+  for (auto factor = right; factor != 0; factor = static_cast<T>(factor >> 1))
+  {
+    if (factor & 1u)
+      result = addModulo(result, addend);
+    addend = addModulo(addend, addend);
+  }
+
+  return result;
+}
+
+// DIVISION
+
+TEMPLATE_TEST_CASE("Divisor matches built-in division", "[FastDivisor][Template]", unsigned char, unsigned short, unsigned, unsigned long long)
+{
+  const auto values = GetValues<TestType>();
+  for (const auto divisor : values)
+  {
+    if (divisor == 0)
+      continue;
+
+    // Arrange
+    const FastDivisor<TestType> fastDivisor(divisor);
+
+    for (const auto value : values)
+    {
+      // Act
+      const auto quotient = fastDivisor.Divide(value);
+      const auto remainder = fastDivisor.Remainder(value);
+
+      // Assert
+      REQUIRE(quotient == static_cast<TestType>(value / divisor));
+      REQUIRE(remainder == static_cast<TestType>(value % divisor));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Modular product does not overflow", "[FastDivisor][Template]", unsigned char, unsigned short, unsigned, unsigned long long)
+{
+  const auto values = GetValues<TestType>();
+  for (const auto divisor : values)
+  {
+    if (divisor == 0)
+      continue;
+
+    // Arrange
+    const FastDivisor<TestType> fastDivisor(divisor);
+
+    for (const auto a : values)
+      for (const auto b : { TestType(0), TestType(1), TestType(2), static_cast<TestType>(divisor / 2), static_cast<TestType>(divisor - 1) })
+      {
+        const auto left = static_cast<TestType>(a % divisor);
+        const auto right = static_cast<TestType>(b % divisor);
+
+        // Act
+        const auto product = fastDivisor.MultiplyModulo(left, right);
+
+        // Assert
+        REQUIRE(product == MultiplyModulo(left, right, divisor));
+      }
+  }
+}
+
+TEST_CASE("Divisor matches built-in division for every 16-bit value", "[FastDivisor]")
+{
+  for (const std::uint32_t divisor : { 1u, 3u, 7u, 100u, 641u, 65535u, 65536u, 65537u, 4294967295u })
+  {
+    const FastDivisor<std::uint32_t> fastDivisor(divisor);
+    for (std::uint32_t value = 0; value <= 65536; ++value)
+    {
+      REQUIRE(fastDivisor.Divide(value) == value / divisor);
+      REQUIRE(fastDivisor.Remainder(value) == value % divisor);
+    }
+  }
+}
+
+TEST_CASE("Divisor keeps its value", "[FastDivisor]")
+{
+  // Arrange
+  const FastDivisor<unsigned> divisor(100);
+
+  // Act
+  const auto value = divisor.GetDivisor();
+
+  // Assert
+  REQUIRE(value == 100);
+}
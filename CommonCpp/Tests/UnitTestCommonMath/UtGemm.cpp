@@ -0,0 +1,117 @@
+#include <filesystem>
+#include <fstream>
+#include "../catch.hpp"
+#include "../../CommonMath/Gemm.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+// MULTIPLICATION
+
+TEMPLATE_TEST_CASE("Blocked multiplication equals unblocked multiplication", "[Gemm][Template]", int, long, double, float)
+{
+  const auto a = CreateValues<TestType>(37, 29, 1);
+  const auto b = CreateValues<TestType>(29, 41, 4);
+  const auto expected = MultiplyValues(a, b);
+
+  for (const auto & parameters : { Gemm::DefaultParameters, GemmParameters { 1, 1, 1, 1 }, GemmParameters { 5, 7, 9, 3 }, GemmParameters { 16, 8, 32, 8 } })
+  {
+    SECTION("Blocks: " + std::to_string(parameters.rowBlock) + "x" + std::to_string(parameters.depthBlock) + "x" + std::to_string(parameters.columnBlock) + ", micro rows: " + std::to_string(parameters.microRows))
+    {
+      // Arrange
+      std::vector<std::vector<TestType>> output(37, std::vector<TestType>(41));
+
+      // Act
+      Gemm::Multiply(a, b, output, parameters);
+
+      // Assert
+      REQUIRE(output == expected);
+    }
+  }
+}
+
+TEST_CASE("Packed operands are multiplied as nested ones", "[Gemm]")
+{
+  // Arrange
+  const auto a = CreateValues<double>(11, 6, 2);
+  const auto b = CreateValues<double>(6, 13, 5);
+  std::vector<double> packedA, packedB, output(11 * 13);
+  for (const auto & row : a)
+    packedA.insert(packedA.end(), row.begin(), row.end());
+  for (const auto & row : b)
+    packedB.insert(packedB.end(), row.begin(), row.end());
+
+  // Act
+  Gemm::Multiply(packedA.data(), packedB.data(), output.data(), 11, 6, 13, GemmParameters { 4, 5, 8, 3 });
+
+  // Assert
+  const auto expected = MultiplyValues(a, b);
+  for (std::size_t i = 0; i < 11; ++i)
+    for (std::size_t j = 0; j < 13; ++j)
+      REQUIRE(output[i * 13 + j] == expected[i][j]);
+}
+
+TEST_CASE("Invalid blocking is rejected", "[Gemm]")
+{
+  REQUIRE_THROWS_AS(Gemm::Validate({ 0, 1, 1, 1 }), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gemm::Validate({ 1, 1, 1, 0 }), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gemm::Validate({ 1, 1, 1, Gemm::MaxMicroRows + 1 }), std::invalid_argument);
+}
+
+// PROFILE
+
+TEST_CASE("Profile is saved and loaded", "[Gemm]")
+{
+  // Arrange
+  const auto path = GetTempFilePath("UtGemm.profile");
+  GemmProfile profile;
+  profile.Set<double>({ 32, 128, 512, 2 });
+  profile.Set<int>({ 16, 64, 256, 1 });
+
+  // Act
+  profile.Save(path);
+  const auto loaded = GemmProfile::Load(path);
+
+  // Assert
+  REQUIRE(loaded.Get<double>() == GemmParameters { 32, 128, 512, 2 });
+  REQUIRE(loaded.Get<int>() == GemmParameters { 16, 64, 256, 1 });
+  REQUIRE(loaded.Get<float>() == Gemm::DefaultParameters);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Missing profile yields the defaults", "[Gemm]")
+{
+  REQUIRE(GemmProfile::Load(GetTempFilePath("UtGemmMissing.profile")).Get<double>() == Gemm::DefaultParameters);
+  REQUIRE(GemmProfile::GetKey<double>() == "float64");
+  REQUIRE(GemmProfile::GetKey<unsigned short>() == "uint16");
+}
+
+TEST_CASE("Malformed profile is rejected", "[Gemm]")
+{
+  const auto path = GetTempFilePath("UtGemmMalformed.profile");
+
+  for (const std::string content : { "float64.rowBlock\n", "float64.rowBlock=many\n", "float64.microRows=0\n" })
+  {
+    SECTION("Content: " + content)
+    {
+      // Arrange
+      std::ofstream(path) << content;
+
+      // Act & Assert
+      REQUIRE_THROWS_AS(GemmProfile::Load(path), std::invalid_argument);
+    }
+  }
+
+  std::filesystem::remove(path);
+}
+
+// TUNING
+
+TEST_CASE("Tuner returns valid blocking", "[Gemm]")
+{
+  const auto parameters = GemmTuner::Tune<double>(24, 1);
+
+  REQUIRE_NOTHROW(Gemm::Validate(parameters));
+}
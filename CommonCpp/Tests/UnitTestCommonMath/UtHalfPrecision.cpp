@@ -0,0 +1,224 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "../catch.hpp"
+#include "../../CommonMath/Matrix.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+static std::uint32_t GetFloatBits(const float value)
+{
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static float FromFloatBits(const std::uint32_t bits)
+{
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+template <typename T>
+static std::vector<std::vector<T>> CreateFractionValues(const unsigned rows, const unsigned columns, const int seed)
+{
+  return CreateValues<T>(rows, columns, seed, [](const unsigned index) { return static_cast<float>(index) * 0.37f - 1.9f; });
+}
+
+template <typename T>
+static std::vector<std::vector<float>> ToFloat(const std::vector<std::vector<T>> & values)
+{
+  std::vector<std::vector<float>> result(values.size(), std::vector<float>(values[0].size()));
+  for (size_t i = 0; i < values.size(); ++i)
+    for (size_t j = 0; j < values[0].size(); ++j)
+      result[i][j] = values[i][j];
+
+  return result;
+}
+
+static_assert(NumericTraits<Float16>::IsNumeric && NumericTraits<BFloat16>::IsNumeric, "Half precision types are numeric.");
+static_assert(IsStorageOnly<Float16> && IsStorageOnly<BFloat16> && !IsStorageOnly<float>, "Only half precision types are storage-only.");
+static_assert(!NumericTraits<std::string>::IsNumeric, "Strings are not numeric.");
+
+// CONVERSION
+
+TEMPLATE_TEST_CASE("Conversion to float and back preserves every value", "[HalfPrecision][Template]", Float16, BFloat16)
+{
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+  {
+    const auto value = TestType::FromBits(static_cast<std::uint16_t>(bits));
+    const auto converted = static_cast<float>(value);
+
+    if (std::isnan(converted))
+      REQUIRE(std::isnan(static_cast<float>(TestType(converted))));
+    else
+      REQUIRE(TestType(converted).GetBits() == bits);
+  }
+}
+
+TEST_CASE("Float16 rounds to nearest even", "[HalfPrecision]")
+{
+  REQUIRE(Float16(1.0f).GetBits() == 0x3C00);
+  REQUIRE(Float16(-2.0f).GetBits() == 0xC000);
+  // Ties between representable values select the even mantissa
+  REQUIRE(Float16(1.0f + std::ldexp(1.0f, -11)).GetBits() == 0x3C00);
+  REQUIRE(Float16(1.0f + 3 * std::ldexp(1.0f, -11)).GetBits() == 0x3C02);
+  REQUIRE(Float16(65504.0f).GetBits() == 0x7BFF);
+  REQUIRE(Float16(65519.0f).GetBits() == 0x7BFF);
+  REQUIRE(Float16(65520.0f).GetBits() == 0x7C00);
+  REQUIRE(Float16(-std::numeric_limits<float>::infinity()).GetBits() == 0xFC00);
+  // Subnormals
+  REQUIRE(Float16(std::ldexp(1.0f, -24)).GetBits() == 0x0001);
+  REQUIRE(Float16(std::ldexp(1.0f, -25)).GetBits() == 0x0000);
+  REQUIRE(Float16(std::ldexp(1.5f, -25)).GetBits() == 0x0001);
+  REQUIRE(Float16(std::ldexp(1023.5f, -24)).GetBits() == 0x0400);
+  REQUIRE(static_cast<float>(Float16::FromBits(0x03FF)) == std::ldexp(1023.0f, -24));
+  REQUIRE(std::isnan(static_cast<float>(Float16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST_CASE("BFloat16 rounds to nearest even", "[HalfPrecision]")
+{
+  REQUIRE(BFloat16(1.0f).GetBits() == 0x3F80);
+  REQUIRE(BFloat16(FromFloatBits(0x3F808000)).GetBits() == 0x3F80);
+  REQUIRE(BFloat16(FromFloatBits(0x3F818000)).GetBits() == 0x3F82);
+  REQUIRE(BFloat16(FromFloatBits(0x3F808001)).GetBits() == 0x3F81);
+  REQUIRE(BFloat16(std::numeric_limits<float>::max()).GetBits() == 0x7F80);
+  // A NaN with only low payload bits must not become infinity
+  REQUIRE(std::isnan(static_cast<float>(BFloat16(FromFloatBits(0x7F800001)))));
+}
+
+TEST_CASE("Batch conversions equal the scalar conversions", "[HalfPrecision]")
+{
+  // Arrange
+  std::vector<Float16> halves(0x10000);
+  std::vector<BFloat16> brains(0x10000);
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+  {
+    halves[bits] = Float16::FromBits(static_cast<std::uint16_t>(bits));
+    brains[bits] = BFloat16::FromBits(static_cast<std::uint16_t>(bits));
+  }
+
+  std::vector<float> floats;
+  std::uint32_t state = 12345;
+  for (auto i = 0; i < 100003; ++i)
+  {
+    state = state * 1664525 + 1013904223;
+    floats.push_back(FromFloatBits(state));
+  }
+  for (const auto special : { 0x00000000u, 0x80000000u, 0x7F800000u, 0x7F800001u, 0x477FF000u, 0x33000000u, 0x33000001u, 0x3F808000u })
+    floats.push_back(FromFloatBits(special));
+
+  for (const auto instructionSet : { InstructionSet::Scalar, InstructionSet::Avx2, InstructionSet::Avx512 })
+  {
+    const auto kernels = SelectHalfKernels(instructionSet);
+    SECTION(std::string("Kernels: ") + Dispatch::GetInstructionSetName(kernels.instructionSet) + ", requested: " + Dispatch::GetInstructionSetName(instructionSet))
+    {
+      // Act
+      std::vector<float> fromHalves(halves.size()), fromBrains(brains.size());
+      std::vector<Float16> toHalves(floats.size());
+      std::vector<BFloat16> toBrains(floats.size());
+      kernels.float16ToFloat(halves.data(), fromHalves.data(), halves.size());
+      kernels.bfloat16ToFloat(brains.data(), fromBrains.data(), brains.size());
+      kernels.floatToFloat16(floats.data(), toHalves.data(), floats.size());
+      kernels.floatToBFloat16(floats.data(), toBrains.data(), floats.size());
+
+      // Assert
+      for (size_t i = 0; i < halves.size(); ++i)
+      {
+        REQUIRE(GetFloatBits(fromHalves[i]) == GetFloatBits(halves[i]));
+        REQUIRE(GetFloatBits(fromBrains[i]) == GetFloatBits(brains[i]));
+      }
+      for (size_t i = 0; i < floats.size(); ++i)
+      {
+        REQUIRE(toHalves[i].GetBits() == Float16(floats[i]).GetBits());
+        REQUIRE(toBrains[i].GetBits() == BFloat16(floats[i]).GetBits());
+      }
+    }
+  }
+}
+
+// MATRIX
+
+TEMPLATE_TEST_CASE("Half precision multiplication accumulates in float", "[HalfPrecision][Template]", Float16, BFloat16)
+{
+  const auto a = CreateFractionValues<TestType>(37, 29, 1);
+  const auto b = CreateFractionValues<TestType>(29, 41, 4);
+
+  for (const auto & parameters : { Gemm::DefaultParameters, GemmParameters { 1, 1, 1, 1 }, GemmParameters { 5, 7, 9, 3 } })
+  {
+    SECTION("Blocks: " + std::to_string(parameters.rowBlock) + "x" + std::to_string(parameters.depthBlock) + "x" + std::to_string(parameters.columnBlock) + ", micro rows: " + std::to_string(parameters.microRows))
+    {
+      // Arrange
+      std::vector<std::vector<TestType>> output(37, std::vector<TestType>(41));
+      std::vector<std::vector<float>> expected(37, std::vector<float>(41));
+      Gemm::Multiply(ToFloat(a), ToFloat(b), expected, parameters);
+
+      // Act
+      Gemm::Multiply(a, b, output, parameters);
+
+      // Assert
+      for (size_t i = 0; i < output.size(); ++i)
+        for (size_t j = 0; j < output[0].size(); ++j)
+          REQUIRE(output[i][j].GetBits() == TestType(expected[i][j]).GetBits());
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Half precision products do not stall on long sums", "[HalfPrecision][Template]", Float16, BFloat16)
+{
+  // Arrange
+  const Matrix<TestType> row(std::vector<std::vector<TestType>>(1, std::vector<TestType>(4096, 1.0f)));
+  const Matrix<TestType> column(std::vector<std::vector<TestType>>(4096, std::vector<TestType>(1, 1.0f)));
+  const std::vector<TestType> ones(4096, 1.0f);
+
+  // Act
+  const auto product = row * column;
+  const auto vectorProduct = row * ones;
+
+  // Assert
+  REQUIRE(static_cast<float>(product.GetMatrixValues()[0][0]) == 4096);
+  REQUIRE(static_cast<float>(vectorProduct[0]) == 4096);
+}
+
+TEMPLATE_TEST_CASE("Matrix-vector product equals matrix product", "[HalfPrecision][Template]", int, double, float, Float16, BFloat16)
+{
+  // Arrange
+  const Matrix<TestType> matrix(CreateFractionValues<TestType>(23, 19, 2));
+  const auto column = CreateFractionValues<TestType>(19, 1, 5);
+  std::vector<TestType> vector(19);
+  for (size_t i = 0; i < vector.size(); ++i)
+    vector[i] = column[i][0];
+
+  // Act
+  const auto product = matrix * vector;
+  const auto expected = matrix * Matrix<TestType>(column);
+
+  // Assert
+  REQUIRE(product.size() == 23);
+  for (size_t i = 0; i < product.size(); ++i)
+    REQUIRE(static_cast<float>(product[i]) == Approx(static_cast<float>(expected.GetMatrixValues()[i][0])).epsilon(1e-2));
+  REQUIRE_THROWS_AS(matrix * std::vector<TestType>(18), MatrixDimensionException);
+}
+
+TEMPLATE_TEST_CASE("Half precision matrices support element-wise operations", "[HalfPrecision][Template]", Float16, BFloat16)
+{
+  // Arrange
+  const Matrix<TestType> identity(3, true);
+  const Matrix<TestType> values(std::vector<std::vector<TestType>> { { 1.5f, 2.0f }, { -3.0f, 0.25f } });
+
+  // Act
+  const auto sum = values + values;
+  const auto scaled = values * 2;
+  auto divided = values;
+  divided /= 2;
+
+  // Assert
+  REQUIRE((identity.GetMatrixType() && Type::Identity));
+  REQUIRE(sum.GetMatrixValues() == scaled.GetMatrixValues());
+  REQUIRE(static_cast<float>(sum.GetMatrixValues()[1][0]) == -6.0f);
+  REQUIRE(static_cast<float>(divided.GetMatrixValues()[0][1]) == 1.0f);
+  REQUIRE(values.GetDeterminant() == Approx(6.375));
+}
@@ -0,0 +1,113 @@
+#include <thread>
+#include "../catch.hpp"
+#include "../../CommonMath/Matrix.hpp"
+
+using namespace Common::Math;
+
+#ifdef COMMON_MATH_INSTRUMENTATION
+
+static_assert(noexcept(Instrumentation::RecordOperation(Operation::Add, 0, 0, 0)), "Recording from scope destructors does not throw.");
+static_assert(noexcept(Instrumentation::RecordAllocation(0, 0)), "Recording allocations does not throw.");
+
+// OPERATIONS
+
+TEMPLATE_TEST_CASE("Matrix operations are counted", "[Instrumentation][Template]", int, double)
+{
+  // Arrange
+  const Matrix<TestType> a(2, 3);
+  const Matrix<TestType> b(3, 4);
+  const Matrix<TestType> c(2, 3);
+  Instrumentation::Reset();
+
+  // Act
+  const auto sum = a + c;
+  const auto product = a * b;
+  const auto transposed = product.Transpose();
+  const auto snapshot = Instrumentation::Snapshot();
+
+  // Assert
+  REQUIRE(snapshot[Operation::Add].calls == 1);
+  REQUIRE(snapshot[Operation::Add].elements == 6);
+  REQUIRE(snapshot[Operation::Add].flops == 6);
+  REQUIRE(snapshot[Operation::Multiply].calls == 1);
+  REQUIRE(snapshot[Operation::Multiply].elements == 8);
+  REQUIRE(snapshot[Operation::Multiply].flops == 2 * 2 * 3 * 4);
+  REQUIRE(snapshot[Operation::Transpose].calls == 1);
+  REQUIRE(snapshot[Operation::Subtract].calls == 0);
+  REQUIRE(snapshot.allocations == 3 + 3 + 5);
+  REQUIRE(snapshot.bytesAllocated == (2 + 2 + 4) * sizeof(std::vector<TestType>) + (6 + 8 + 8) * sizeof(TestType));
+}
+
+TEST_CASE("Cached properties are counted once", "[Instrumentation]")
+{
+  // Arrange
+  const Matrix<double> matrix(std::vector<std::vector<double>> { { 2, 1 }, { 1, 3 } });
+  Instrumentation::Reset();
+
+  // Act
+  matrix.GetDeterminant();
+  matrix.GetDeterminant();
+  matrix.GetInverse();
+  const auto snapshot = Instrumentation::Snapshot();
+
+  // Assert
+  REQUIRE(snapshot[Operation::Determinant].calls == 1);
+  REQUIRE(snapshot[Operation::Inverse].calls == 1);
+}
+
+TEST_CASE("Determinant and inverse count the operations of their algorithm", "[Instrumentation]")
+{
+  // Arrange
+  const Matrix<double> general(std::vector<std::vector<double>> { { 2, 1, 0, 1 }, { 1, 3, 1, 0 }, { 0, 1, 4, 1 }, { 1, 0, 1, 5 } });
+  const Matrix<double> upper(std::vector<std::vector<double>> { { 1, 2, 3 }, { 0, 4, 5 }, { 0, 0, 6 } });
+  Instrumentation::Reset();
+
+  // Act
+  general.GetInverse();
+  const auto generalSnapshot = Instrumentation::Snapshot();
+  Instrumentation::Reset();
+  upper.GetInverse();
+  const auto upperSnapshot = Instrumentation::Snapshot();
+
+  // Assert
+  // Four 3x3 minors of 17 operations, each multiplied by its value and sign and summed
+  REQUIRE(generalSnapshot[Operation::Determinant].flops == 4 * (17 + 3));
+  // Sixteen signed 3x3 minors divided by the determinant
+  REQUIRE(generalSnapshot[Operation::Inverse].flops == 16 * (17 + 3));
+  // Product of the diagonal, then substitution of the rows and their scaling
+  REQUIRE(upperSnapshot[Operation::Determinant].flops == 3);
+  REQUIRE(upperSnapshot[Operation::Inverse].flops == 3 * 8 / 3 + 9 + 3);
+}
+
+// THREADS
+
+TEST_CASE("Counters of exited threads are kept until reset", "[Instrumentation]")
+{
+  // Arrange
+  const Matrix<int> matrix(4, 4);
+  Instrumentation::Reset();
+
+  // Act
+  std::thread worker([&matrix] { const auto result = matrix * 2; });
+  worker.join();
+  const auto result = matrix * 2;
+  const auto snapshot = Instrumentation::Snapshot();
+  Instrumentation::Reset();
+
+  // Assert
+  REQUIRE(snapshot[Operation::Scale].calls == 2);
+  REQUIRE(snapshot[Operation::Scale].elements == 32);
+  REQUIRE(Instrumentation::Snapshot()[Operation::Scale].calls == 0);
+  REQUIRE(Instrumentation::Snapshot().allocations == 0);
+}
+
+#else
+
+TEST_CASE("Disabled instrumentation counts nothing", "[Instrumentation]")
+{
+  const auto result = Matrix<int>(4, 4) * 2;
+
+  REQUIRE(Instrumentation::Snapshot()[Operation::Scale].calls == 0);
+}
+
+#endif
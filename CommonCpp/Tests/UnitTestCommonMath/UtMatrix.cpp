@@ -1,6 +1,7 @@
 #include<vector>
 #include "../catch.hpp"
 #include "../../CommonMath/Matrix.hpp"
+#include "DataFixtures.hpp"
 #include "DataMatrix.hpp"
 
 using namespace Common::Math;
@@ -91,3 +92,288 @@ TEMPLATE_TEST_CASE("Add two matricies together", "[Operator][Template]", short,
     }
   }
 }
+
+TEMPLATE_TEST_CASE("Subtract two matricies", "[Operator][Template]", short, int, long, double, float)
+{
+  for (const auto &[dataLeft, dataRight, expected] : DataMatrix<TestType>::GetAdditionClassClassData())
+  {
+    SECTION("Subtracting matricies...")
+    {
+      Matrix<TestType> matrixA(expected);
+      const Matrix<TestType> matrixB(dataRight);
+
+      const auto result = matrixA - matrixB;
+      matrixA -= matrixB;
+
+      REQUIRE(Compare2DVectors<TestType>(result.GetMatrixValues(), dataLeft));
+      REQUIRE(Compare2DVectors<TestType>(matrixA.GetMatrixValues(), dataLeft));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Multiply two matricies", "[Operator][Template]", short, int, long, double, float)
+{
+  for (const auto &[dataLeft, dataRight, expected] : DataMatrix<TestType>::GetMultiplicationClassClassData())
+  {
+    SECTION("Multiplying matricies...")
+    {
+      const Matrix<TestType> matrixA(dataLeft);
+      const Matrix<TestType> matrixB(dataRight);
+
+      const auto result = matrixA * matrixB;
+
+      REQUIRE(Compare2DVectors<TestType>(result.GetMatrixValues(), expected));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Cannot multiply matricies with non-matching dimensions", "[Operator][Template]", int, double)
+{
+  const Matrix<TestType> matrixA(2, 3);
+  const Matrix<TestType> matrixB(2, 3);
+
+  REQUIRE_THROWS_AS(matrixA * matrixB, MatrixDimensionException);
+}
+
+TEMPLATE_TEST_CASE("Multiply matrix by scalar", "[Operator][Template]", short, int, long, double, float)
+{
+  for (const auto &[dataLeft, dataRight, expected] : DataMatrix<TestType>::GetAdditionClassClassData())
+  {
+    SECTION("Multiplying matrix...")
+    {
+      Matrix<TestType> matrix(dataLeft);
+      auto doubled = dataLeft;
+      for (auto & row : doubled)
+        for (auto & value : row)
+          value *= 2;
+
+      const auto result = matrix * static_cast<TestType>(2);
+      matrix *= static_cast<TestType>(2);
+
+      REQUIRE(Compare2DVectors<TestType>(result.GetMatrixValues(), doubled));
+      REQUIRE(Compare2DVectors<TestType>(matrix.GetMatrixValues(), doubled));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Transpose a matrix", "[Method][Template]", unsigned, int, double, float)
+{
+  const Matrix<TestType> matrix(std::vector<std::vector<TestType>> { { 1, 2, 3 }, { 4, 5, 6 } });
+
+  const auto result = matrix.Transpose();
+
+  REQUIRE(result.GetMatrixValues() == std::vector<std::vector<TestType>> { { 1, 4 }, { 2, 5 }, { 3, 6 } });
+}
+
+TEMPLATE_TEST_CASE("Calculate determinant of a matrix", "[Method][Template]", int, long, double, float)
+{
+  const Matrix<TestType> matrix(std::vector<std::vector<TestType>> { { 2, 0, 1, 3 }, { 1, 1, 0, 2 }, { 0, 4, 1, 1 }, { 3, 1, 2, 0 } });
+
+  REQUIRE(matrix.GetDeterminant() == Approx(-28));
+  REQUIRE_THROWS_AS(Matrix<TestType>(2, 3).GetDeterminant(), InvertableMatrixOperationException);
+}
+
+TEMPLATE_TEST_CASE("Calculate inverse of a matrix", "[Method][Template]", double, float)
+{
+  const Matrix<TestType> matrix(std::vector<std::vector<TestType>> { { 2, 0, 1 }, { 1, 3, 2 }, { 1, 1, 2 } });
+
+  const auto product = matrix * matrix.GetInverse();
+
+  REQUIRE(Compare2DVectors<TestType>(product.GetMatrixValues(), { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }));
+  REQUIRE_THROWS_AS(Matrix<TestType>(3, 3).GetInverse(), InvertableMatrixOperationException);
+}
+
+// STRUCTURE
+
+template <typename T>
+static bool IsIdentity(const Matrix<T> & matrix)
+{
+  for (unsigned i = 0; i < matrix.GetRows(); ++i)
+    for (unsigned j = 0; j < matrix.GetColumns(); ++j)
+      if (matrix.GetMatrixValues()[i][j] != Approx(i == j ? 1 : 0).margin(1e-5))
+        return false;
+
+  return true;
+}
+
+static const Type DiagonalType = Type::Invertable | Type::Diagonal | Type::UpperTriangular | Type::LowerTriangular | Type::Symmetric;
+static const Type IdentityType = DiagonalType | Type::Identity | Type::Permutation;
+
+TEMPLATE_TEST_CASE("Matrix structure is classified", "[Method][Template]", int, double, float)
+{
+  using Values = std::vector<std::vector<TestType>>;
+  const std::vector<std::pair<Values, Type>> data
+  {
+    { { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }, IdentityType },
+    { { { 2, 0, 0 }, { 0, 3, 0 }, { 0, 0, 4 } }, DiagonalType },
+    { { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } }, Type::Invertable | Type::Permutation },
+    { { { 0, 1 }, { 1, 0 } }, Type::Invertable | Type::Permutation | Type::Symmetric },
+    { { { 1, 2 }, { 0, 3 } }, Type::Invertable | Type::UpperTriangular },
+    { { { 1, 0 }, { 2, 3 } }, Type::Invertable | Type::LowerTriangular },
+    { { { 1, 0 }, { 1, 0 } }, Type::Invertable | Type::LowerTriangular },
+    { { { 1, 2 }, { 2, 1 } }, Type::Invertable | Type::Symmetric },
+    { { { 1, 2 }, { 3, 1 } }, Type::Invertable },
+    { { { 1, 0, 0 }, { 0, 1, 0 } }, Type::NonInvertable }
+  };
+
+  for (const auto & [values, type] : data)
+  {
+    SECTION("Type: " + std::to_string(unsigned(type)) + ", size: [" + std::to_string(values.size()) + ", " + std::to_string(values[0].size()) + "]")
+    {
+      REQUIRE(Matrix<TestType>(values).GetMatrixType() == type);
+    }
+  }
+
+  REQUIRE(Matrix<TestType>(3, true).GetMatrixType() == IdentityType);
+  REQUIRE(Matrix<TestType>(3, 3).GetMatrixType() == DiagonalType);
+}
+
+TEMPLATE_TEST_CASE("Matrix structure is tracked through operations", "[Method][Template]", int, double)
+{
+  // Arrange
+  const Matrix<TestType> upper(std::vector<std::vector<TestType>> { { 1, 2, 3 }, { 0, 4, 5 }, { 0, 0, 6 } });
+  const Matrix<TestType> diagonal(std::vector<std::vector<TestType>> { { 2, 0, 0 }, { 0, 3, 0 }, { 0, 0, 4 } });
+  const Matrix<TestType> cycle(std::vector<std::vector<TestType>> { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } });
+  auto scaled = Matrix<TestType>(3, true);
+
+  // Act
+  scaled *= 2;
+  const auto halved = scaled / 2;
+
+  // Assert
+  REQUIRE(upper.Transpose().GetMatrixType() == (Type::Invertable | Type::LowerTriangular));
+  REQUIRE((upper + diagonal).GetMatrixType() == (Type::Invertable | Type::UpperTriangular));
+  REQUIRE((diagonal * upper).GetMatrixType() == (Type::Invertable | Type::UpperTriangular));
+  REQUIRE((diagonal - diagonal).GetMatrixType() == DiagonalType);
+  REQUIRE((cycle * cycle).GetMatrixType() == (Type::Invertable | Type::Permutation));
+  REQUIRE((cycle * cycle.Transpose()).GetMatrixType() == IdentityType);
+  REQUIRE(scaled.GetMatrixType() == DiagonalType);
+  REQUIRE(halved.GetMatrixType() == IdentityType);
+  REQUIRE((cycle * 2).GetMatrixType() == Type::Invertable);
+}
+
+TEMPLATE_TEST_CASE("Structured products equal the general product", "[Operator][Template]", int, double, float)
+{
+  const std::vector<std::vector<TestType>> general { { 1, -2, 3, 4 }, { 5, 6, -7, 8 }, { 9, 10, 11, -12 }, { -1, 2, 5, 3 } };
+  const std::vector<std::vector<TestType>> wide { { 1, -2, 3 }, { 5, 6, -7 }, { 9, 10, 11 }, { -1, 2, 5 } };
+  const std::vector<std::vector<TestType>> diagonal { { 2, 0, 0, 0 }, { 0, -3, 0, 0 }, { 0, 0, 4, 0 }, { 0, 0, 0, 5 } };
+  const std::vector<std::vector<TestType>> permutation { { 0, 0, 1, 0 }, { 1, 0, 0, 0 }, { 0, 0, 0, 1 }, { 0, 1, 0, 0 } };
+  const std::vector<std::vector<TestType>> identity { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };
+
+  for (const auto & structured : { diagonal, permutation, identity })
+  {
+    SECTION("Structure: " + std::to_string(unsigned(Matrix<TestType>(structured).GetMatrixType())))
+    {
+      // Act
+      const auto left = Matrix<TestType>(structured) * Matrix<TestType>(wide);
+      const auto right = Matrix<TestType>(general) * Matrix<TestType>(structured);
+      const auto vector = Matrix<TestType>(structured) * std::vector<TestType> { 1, -2, 3, 7 };
+
+      // Assert
+      REQUIRE(left.GetMatrixValues() == MultiplyValues(structured, wide));
+      REQUIRE(right.GetMatrixValues() == MultiplyValues(general, structured));
+      const auto column = MultiplyValues(structured, std::vector<std::vector<TestType>> { { 1 }, { -2 }, { 3 }, { 7 } });
+      for (size_t i = 0; i < vector.size(); ++i)
+        REQUIRE(vector[i] == column[i][0]);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Structured determinants", "[Method][Template]", int, double)
+{
+  using Values = std::vector<std::vector<TestType>>;
+  const std::vector<std::pair<Values, double>> data
+  {
+    { { { 2, 7, 1 }, { 0, 3, -4 }, { 0, 0, 5 } }, 30 },
+    { { { 2, 0, 0 }, { 7, -3, 0 }, { 1, 4, 5 } }, -30 },
+    { { { 0, 1, 0, 0 }, { 1, 0, 0, 0 }, { 0, 0, 0, 1 }, { 0, 0, 1, 0 } }, 1 },
+    { { { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 }, { 1, 0, 0, 0 } }, -1 },
+    { { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } }, 1 },
+    { { { 1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } }, -1 }
+  };
+
+  for (const auto & [values, determinant] : data)
+  {
+    SECTION("Determinant: " + std::to_string(determinant) + ", type: " + std::to_string(unsigned(Matrix<TestType>(values).GetMatrixType())))
+    {
+      const Matrix<TestType> matrix(values);
+
+      REQUIRE(matrix.GetDeterminant() == Approx(determinant));
+      REQUIRE(matrix.GetDeterminant(Accumulation::KahanNeumaier) == Approx(determinant));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Structured inverses", "[Method][Template]", double, float)
+{
+  using Values = std::vector<std::vector<TestType>>;
+  const std::vector<Values> data
+  {
+    { { 2, 0, 0, 0 }, { 0, -4, 0, 0 }, { 0, 0, 0.5, 0 }, { 0, 0, 0, 8 } },
+    { { 0, 0, 1, 0 }, { 1, 0, 0, 0 }, { 0, 0, 0, 1 }, { 0, 1, 0, 0 } },
+    { { 2, 7, 1, 3 }, { 0, 3, -4, 1 }, { 0, 0, 5, 2 }, { 0, 0, 0, -1 } },
+    { { 2, 0, 0, 0 }, { 7, 3, 0, 0 }, { 1, -4, 5, 0 }, { 3, 1, 2, -1 } }
+  };
+
+  for (const auto & values : data)
+  {
+    SECTION("Type: " + std::to_string(unsigned(Matrix<TestType>(values).GetMatrixType())))
+    {
+      // Arrange
+      const Matrix<TestType> matrix(values);
+
+      // Act
+      const auto & inverse = matrix.GetInverse();
+
+      // Assert
+      REQUIRE(IsIdentity(matrix * inverse));
+      REQUIRE((inverse.GetMatrixType() & (Type::UpperTriangular | Type::LowerTriangular | Type::Permutation)) == (matrix.GetMatrixType() & (Type::UpperTriangular | Type::LowerTriangular | Type::Permutation)));
+    }
+  }
+
+  REQUIRE_THROWS_AS(Matrix<TestType>(std::vector<std::vector<TestType>> { { 1, 0 }, { 0, 0 } }).GetInverse(), InvertableMatrixOperationException);
+}
+
+TEMPLATE_TEST_CASE("Raise a matrix to a power", "[Method][Template]", int, double)
+{
+  using Values = std::vector<std::vector<TestType>>;
+  const std::vector<Values> data
+  {
+    { { 1, 2, 0 }, { -1, 1, 3 }, { 2, 0, 1 } },
+    { { 2, 0, 0 }, { 0, -3, 0 }, { 0, 0, 1 } },
+    { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } },
+    { { 1, 1, 0 }, { 0, 1, 1 }, { 0, 0, 1 } }
+  };
+
+  for (const auto & values : data)
+  {
+    SECTION("Type: " + std::to_string(unsigned(Matrix<TestType>(values).GetMatrixType())))
+    {
+      const Matrix<TestType> matrix(values);
+      for (auto exponent = 0; exponent <= 7; ++exponent)
+      {
+        // Arrange
+        auto expected = Values { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+        for (auto i = 0; i < exponent; ++i)
+          expected = MultiplyValues(expected, values);
+
+        // Act
+        const auto result = matrix.Power(exponent);
+
+        // Assert
+        REQUIRE(result.GetMatrixValues() == expected);
+      }
+    }
+  }
+
+  REQUIRE_THROWS_AS(Matrix<TestType>(2, 3).Power(2), InvertableMatrixOperationException);
+}
+
+TEST_CASE("Raise a matrix to a negative power", "[Method]")
+{
+  const Matrix<double> matrix(std::vector<std::vector<double>> { { 2, 1 }, { 1, 3 } });
+  const Matrix<double> diagonal(std::vector<std::vector<double>> { { 2, 0 }, { 0, -4 } });
+
+  REQUIRE(IsIdentity(matrix.Power(-3) * matrix.Power(3)));
+  REQUIRE(diagonal.Power(-2).GetMatrixValues() == std::vector<std::vector<double>> { { 0.25, 0 }, { 0, 0.0625 } });
+}
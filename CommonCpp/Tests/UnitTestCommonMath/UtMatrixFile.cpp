@@ -0,0 +1,102 @@
+#include <filesystem>
+#include <fstream>
+#include "../catch.hpp"
+#include "../../CommonMath/MatrixFile.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+// SAVE & MAP
+
+TEMPLATE_TEST_CASE("Saved matrix can be mapped back", "[MatrixFile][Template]", unsigned short, unsigned, unsigned long, short, int, long, double, float)
+{
+  // Arrange
+  const auto path = GetTempFilePath("UtMatrixFile.cmmx");
+  const Matrix<TestType> matrix(std::vector<std::vector<TestType>>
+  {
+    { 1, 2, 3 },
+    { 4, 5, 6 }
+  });
+
+  // Act
+  MatrixFile::Save(matrix, path);
+  const MappedMatrix<TestType> mapped(path, true);
+
+  // Assert
+  REQUIRE(mapped.GetRows() == 2);
+  REQUIRE(mapped.GetColumns() == 3);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(mapped.GetData()) % 64 == 0);
+  REQUIRE(mapped.GetView()(1, 2) == 6);
+  REQUIRE(mapped.ToMatrix().GetMatrixValues() == matrix.GetMatrixValues());
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Mapping with a different element type fails", "[MatrixFile]")
+{
+  // Arrange
+  const auto path = GetTempFilePath("UtMatrixFileType.cmmx");
+  MatrixFile::Save(Matrix<int>(std::vector<std::vector<int>> { { 1, 2 }, { 3, 4 } }), path);
+
+  // Act & Assert
+  REQUIRE_THROWS_AS(MappedMatrix<float>(path), MatrixFileException);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupted payload fails checksum verification", "[MatrixFile]")
+{
+  // Arrange
+  const auto path = GetTempFilePath("UtMatrixFileChecksum.cmmx");
+  MatrixFile::Save(Matrix<double>(std::vector<std::vector<double>> { { 1, 2 }, { 3, 4 } }), path);
+  const auto header = MatrixFile::ReadHeader(path);
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(header.payloadOffset));
+    file.put('\x7f');
+  }
+
+  // Act & Assert
+  REQUIRE_NOTHROW(MappedMatrix<double>(path));
+  REQUIRE_THROWS_AS(MappedMatrix<double>(path, true), MatrixFileException);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Truncated file cannot be mapped", "[MatrixFile]")
+{
+  // Arrange
+  const auto path = GetTempFilePath("UtMatrixFileTruncated.cmmx");
+  MatrixFile::Save(Matrix<double>(3, 3), path);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+
+  // Act & Assert
+  REQUIRE_THROWS_AS(MappedMatrix<double>(path), MatrixFileException);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupted header cannot be mapped", "[MatrixFile]")
+{
+  // Arrange, an offset near the maximum wraps the end of the payload around to a small value
+  const auto path = GetTempFilePath("UtMatrixFileHeader.cmmx");
+  MatrixFile::Save(Matrix<double>(3, 3), path);
+  auto header = MatrixFile::ReadHeader(path);
+  const auto fileSize = static_cast<std::uint64_t>(std::filesystem::file_size(path));
+  header.payloadOffset = std::numeric_limits<std::uint64_t>::max() - header.alignment + 1;
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+  auto misaligned = MatrixFile::CreateHeader<double>(3, 3, 64);
+  misaligned.alignment = 24;
+  misaligned.payloadOffset = 72;
+
+  // Act & Assert
+  REQUIRE_THROWS_AS(MappedMatrix<double>(path), MatrixFileException);
+  REQUIRE_THROWS_AS(MatrixFile::ValidateHeader<double>(misaligned, fileSize + 8), MatrixFileException);
+  REQUIRE_NOTHROW(MatrixFile::ValidateHeader<double>(MatrixFile::CreateHeader<double>(3, 3, 64), fileSize));
+
+  std::filesystem::remove(path);
+}
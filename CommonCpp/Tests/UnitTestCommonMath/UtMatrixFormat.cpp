@@ -0,0 +1,108 @@
+#include <limits>
+#include <sstream>
+#include "../catch.hpp"
+#include "../../CommonMath/MatrixFormat.hpp"
+#include "../../CommonMath/MatrixReader.hpp"
+
+using namespace Common::Math;
+
+// FORMATTING
+
+TEST_CASE("Matrix is formatted with delimiters", "[MatrixFormat]")
+{
+  // Arrange
+  const Matrix<int> matrix(std::vector<std::vector<int>> { { 1, -2, 3 }, { 40, 50, 60 } });
+
+  // Act & Assert
+  REQUIRE(matrix.ToString() == "1,-2,3\n40,50,60");
+  REQUIRE(matrix.ToString({ ' ', ';' }) == "1 -2 3;40 50 60");
+}
+
+TEST_CASE("Matrix is formatted with given precision", "[MatrixFormat]")
+{
+  // Arrange
+  const Matrix<double> matrix(std::vector<std::vector<double>> { { 1.0 / 3, 2.5 } });
+  MatrixFormat format;
+  format.precision = 3;
+  format.notation = std::chars_format::fixed;
+
+  // Act & Assert
+  REQUIRE(matrix.ToString(format) == "0.333,2.500");
+}
+
+TEST_CASE("Matrix is formatted into a caller-provided buffer", "[MatrixFormat]")
+{
+  // Arrange
+  const Matrix<unsigned> matrix(std::vector<std::vector<unsigned>> { { 7, 8 }, { 9, 10 } });
+  char buffer[16];
+  char small[4];
+
+  // Act
+  const auto end = matrix.Format(buffer, buffer + sizeof(buffer));
+
+  // Assert
+  REQUIRE(std::string(buffer, end) == "7,8\n9,10");
+  REQUIRE_THROWS_AS(matrix.Format(small, small + sizeof(small)), std::length_error);
+}
+
+TEMPLATE_TEST_CASE("Formatted matrix is parsed back exactly", "[MatrixFormat][Template]", short, int, long, double, float)
+{
+  // Arrange
+  const Matrix<TestType> matrix(std::vector<std::vector<TestType>>
+  {
+    { std::numeric_limits<TestType>::max(), std::numeric_limits<TestType>::lowest(), static_cast<TestType>(1) },
+    { static_cast<TestType>(-7), std::numeric_limits<TestType>::min(), static_cast<TestType>(0) }
+  });
+  std::ostringstream output;
+
+  // Act
+  matrix.Write(output);
+  std::istringstream input(output.str());
+  const auto parsed = MatrixReader::ReadCsv<TestType>(input);
+
+  // Assert
+  REQUIRE(output.str() == matrix.ToString());
+  REQUIRE(parsed.GetMatrixValues() == matrix.GetMatrixValues());
+}
+
+TEMPLATE_TEST_CASE("Half precision matrix is formatted through float", "[MatrixFormat][Template]", Float16, BFloat16)
+{
+  // Arrange
+  const Matrix<TestType> matrix(std::vector<std::vector<TestType>>
+  {
+    { TestType(1.5f), TestType(-0.25f), TestType(0.1f) },
+    { std::numeric_limits<float>::infinity(), TestType(3.0f), TestType(-1024.0f) }
+  });
+  std::ostringstream output;
+
+  // Act
+  matrix.Write(output);
+  std::istringstream input(output.str());
+  const auto parsed = MatrixReader::ReadCsv<float>(input);
+
+  // Assert
+  REQUIRE(output.str() == matrix.ToString());
+  REQUIRE(output.str().rfind("1.5,-0.25,0.", 0) == 0);
+  for (unsigned i = 0; i < matrix.GetRows(); ++i)
+    for (unsigned j = 0; j < matrix.GetColumns(); ++j)
+      REQUIRE(TestType(parsed.GetMatrixValues()[i][j]).GetBits() == matrix.GetMatrixValues()[i][j].GetBits());
+}
+
+TEST_CASE("Large matrix is formatted in chunks", "[MatrixFormat]")
+{
+  // Arrange
+  const Matrix<double> matrix(std::vector<std::vector<double>>(300, std::vector<double>(300, 0.1)));
+  std::string expected;
+  for (unsigned i = 0; i < 300; ++i)
+    for (unsigned j = 0; j < 300; ++j)
+      expected += j != 0 ? ",0.1" : i != 0 ? "\n0.1" : "0.1";
+  std::ostringstream output;
+
+  // Act
+  matrix.Write(output);
+  const auto result = matrix.ToString();
+
+  // Assert
+  REQUIRE(output.str() == expected);
+  REQUIRE(result == expected);
+}
@@ -0,0 +1,169 @@
+#include <sstream>
+#include "../catch.hpp"
+#include "../../CommonMath/MatrixReader.hpp"
+
+using namespace Common::Math;
+
+// CSV
+
+TEMPLATE_TEST_CASE("CSV input is read into a matrix", "[MatrixReader][Template]", unsigned short, unsigned, unsigned long, short, int, long, double, float)
+{
+  // Arrange
+  std::istringstream input("1,2,3\n4, 5 ,6\r\n\n");
+
+  // Act
+  const auto matrix = MatrixReader::ReadCsv<TestType>(input);
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues() == std::vector<std::vector<TestType>> { { 1, 2, 3 }, { 4, 5, 6 } });
+}
+
+TEST_CASE("CSV input with blank delimiters is read into a matrix", "[MatrixReader]")
+{
+  // Arrange
+  std::istringstream input("1.5  -2\t3e2\n4 5 6");
+
+  // Act
+  const auto matrix = MatrixReader::ReadCsv<double>(input, ' ');
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues() == std::vector<std::vector<double>> { { 1.5, -2, 300 }, { 4, 5, 6 } });
+}
+
+TEST_CASE("Large CSV input is parsed in parallel", "[MatrixReader]")
+{
+  // Arrange
+  const auto rows = 20000, columns = 16;
+  std::ostringstream text;
+  for (auto row = 0; row < rows; ++row)
+    for (auto column = 0; column < columns; ++column)
+      text << row * columns + column << (column == columns - 1 ? '\n' : ',');
+  std::istringstream input(text.str());
+
+  // Act
+  const auto matrix = MatrixReader::ReadCsv<long>(input, ',', 4);
+
+  // Assert
+  REQUIRE(matrix.GetRows() == static_cast<unsigned>(rows));
+  REQUIRE(matrix.GetColumns() == static_cast<unsigned>(columns));
+  REQUIRE(matrix.GetMatrixValues()[rows - 1][columns - 1] == rows * columns - 1);
+  REQUIRE(matrix.GetMatrixValues()[12345][7] == 12345 * columns + 7);
+}
+
+TEST_CASE("CSV input starting with blank lines is read into a matrix", "[MatrixReader]")
+{
+  // Arrange
+  std::istringstream input("\n \t\r\n1,2\n3,4\n");
+
+  // Act
+  const auto matrix = MatrixReader::ReadCsv<int>(input);
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues() == std::vector<std::vector<int>> { { 1, 2 }, { 3, 4 } });
+}
+
+TEST_CASE("Jagged CSV input cannot be read", "[MatrixReader]")
+{
+  std::istringstream input("1,2,3\n4,5\n");
+
+  REQUIRE_THROWS_AS(MatrixReader::ReadCsv<int>(input), MatrixParseException);
+}
+
+TEST_CASE("CSV input with invalid values cannot be read", "[MatrixReader]")
+{
+  std::istringstream input("1,2,x\n");
+
+  REQUIRE_THROWS_AS(MatrixReader::ReadCsv<int>(input), MatrixParseException);
+}
+
+// MATRIX MARKET
+
+TEST_CASE("Matrix Market array input is read column by column", "[MatrixReader]")
+{
+  // Arrange
+  std::istringstream input(
+    "%%MatrixMarket matrix array real general\n"
+    "% comment\n"
+    "2 3\n"
+    "1\n4\n2\n5\n3\n6\n");
+
+  // Act
+  const auto matrix = MatrixReader::ReadMatrixMarket<double>(input);
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues() == std::vector<std::vector<double>> { { 1, 2, 3 }, { 4, 5, 6 } });
+}
+
+TEST_CASE("Matrix Market symmetric array input is mirrored", "[MatrixReader]")
+{
+  // Arrange
+  std::istringstream input(
+    "%%MatrixMarket matrix array integer symmetric\n"
+    "3 3\n"
+    "1\n2\n3\n4\n5\n6\n");
+
+  // Act
+  const auto matrix = MatrixReader::ReadMatrixMarket<int>(input);
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues() == std::vector<std::vector<int>> { { 1, 2, 3 }, { 2, 4, 5 }, { 3, 5, 6 } });
+}
+
+TEST_CASE("Matrix Market coordinate input is read", "[MatrixReader]")
+{
+  // Arrange
+  std::istringstream input(
+    "%%MatrixMarket matrix coordinate real skew-symmetric\n"
+    "3 3 2\n"
+    "2 1 1.5\n"
+    "3 2 -4\n");
+
+  // Act
+  const auto matrix = MatrixReader::ReadMatrixMarket<float>(input);
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues() == std::vector<std::vector<float>> { { 0, -1.5f, 0 }, { 1.5f, 0, 4 }, { 0, -4, 0 } });
+}
+
+TEST_CASE("Large Matrix Market coordinate input keeps the last of repeated entries", "[MatrixReader]")
+{
+  // Arrange, the repeated entries end up in different parts
+  const auto size = 400;
+  std::ostringstream text;
+  text << "%%MatrixMarket matrix coordinate integer symmetric\n" << size << ' ' << size << ' ' << size * (size + 1) / 2 + 2 << '\n';
+  for (auto column = 1; column <= size; ++column)
+    for (auto row = column; row <= size; ++row)
+      text << row << ' ' << column << ' ' << row * size + column << '\n';
+  text << "1 1 -1\n" << "2 1 -2\n";
+  std::istringstream input(text.str());
+
+  // Act
+  const auto matrix = MatrixReader::ReadMatrixMarket<long>(input, 4);
+
+  // Assert
+  REQUIRE(matrix.GetMatrixValues()[0][0] == -1);
+  REQUIRE(matrix.GetMatrixValues()[1][0] == -2);
+  REQUIRE(matrix.GetMatrixValues()[0][1] == -2);
+  REQUIRE(matrix.GetMatrixValues()[size - 1][7] == size * size + 8);
+  REQUIRE(matrix.GetMatrixValues()[7][size - 1] == size * size + 8);
+}
+
+TEST_CASE("Matrix Market input with a wrong number of entries cannot be read", "[MatrixReader]")
+{
+  std::istringstream input(
+    "%%MatrixMarket matrix coordinate pattern general\n"
+    "3 3 2\n"
+    "2 1\n");
+
+  REQUIRE_THROWS_AS(MatrixReader::ReadMatrixMarket<int>(input), MatrixParseException);
+}
+
+TEST_CASE("Matrix Market entries outside of the matrix cannot be read", "[MatrixReader]")
+{
+  std::istringstream input(
+    "%%MatrixMarket matrix coordinate integer general\n"
+    "2 2 1\n"
+    "3 1 7\n");
+
+  REQUIRE_THROWS_AS(MatrixReader::ReadMatrixMarket<int>(input), MatrixParseException);
+}
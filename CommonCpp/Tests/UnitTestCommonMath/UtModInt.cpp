@@ -0,0 +1,226 @@
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/ModInt.hpp"
+
+using namespace Common::Math;
+
+template <typename T>
+static std::vector<T> GetModuli()
+{
+  std::vector<T> moduli;
+  for (const unsigned long long modulus : { 3ull, 5ull, 7ull, 255ull, 641ull, 65537ull, 1000000007ull, 4294967291ull, 4294967295ull, 2305843009213693951ull, 18446744073709551557ull })
+    if (modulus <= std::numeric_limits<T>::max())
+      moduli.push_back(static_cast<T>(modulus));
+  moduli.push_back(std::numeric_limits<T>::max());
+
+  return moduli;
+}
+
+template <typename T>
+static std::vector<T> GetValues(const T modulus)
+{
+  const auto max = std::numeric_limits<T>::max();
+  return { 0, 1, 2, static_cast<T>(modulus / 2), static_cast<T>(modulus - 2), static_cast<T>(modulus - 1), modulus, static_cast<T>(max / 3), static_cast<T>(max - 1), max };
+}
+
+/**
+ * \brief Reference product by doubling, sums of values less than the modulus are reduced before they overflow
+ */
+template <typename T>
+static T MultiplyModulo(const T left, const T right, const T modulus)
+{
+  const auto addModulo = [modulus](const T a, const T b)
+  {
+    return b >= modulus - a ? static_cast<T>(b - (modulus - a)) : static_cast<T>(a + b);
+  };
+
+  T result = 0, addend = static_cast<T>(left % modulus);
+  for (auto factor = static_cast<T>(right % modulus); factor != 0; factor = static_cast<T>(factor >> 1))
+  {
+    if (factor & 1u)
+      result = addModulo(result, addend);
+    addend = addModulo(addend, addend);
+  }
+
+  return result;
+}
+
+// CONSTRUCTION
+
+TEMPLATE_TEST_CASE("Modular integer reduces its value", "[ModInt][Template]", unsigned, unsigned long long)
+{
+  for (const auto modulus : GetModuli<TestType>())
+    for (const auto value : GetValues(modulus))
+    {
+      // Arrange
+      const ModInt<TestType> number(value, modulus);
+
+      // Act
+      const auto result = number.GetValue();
+
+      // Assert
+      REQUIRE(result == value % modulus);
+      REQUIRE(number.GetMin() == 0);
+      REQUIRE(number.GetMax() == modulus - 1);
+    }
+}
+
+TEST_CASE("Modular integer rejects even moduli", "[ModInt]")
+{
+  REQUIRE_THROWS_AS(ModInt<unsigned>(1, 0), std::invalid_argument);
+  REQUIRE_THROWS_AS(ModInt<unsigned>(1, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(ModInt<unsigned>(1, 1000000000), std::invalid_argument);
+  REQUIRE_THROWS_AS(MontgomeryModulus<unsigned long long>(1ull << 63), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("Montgomery conversions round trip", "[ModInt][Template]", unsigned, unsigned long long)
+{
+  for (const auto modulus : GetModuli<TestType>())
+  {
+    // Arrange
+    const MontgomeryModulus<TestType> montgomery(modulus);
+    const auto values = GetValues(modulus);
+    std::vector<TestType> converted(values.size());
+
+    // Act
+    montgomery.ToMontgomeryRange(values.data(), converted.data(), values.size());
+    montgomery.FromMontgomeryRange(converted.data(), converted.data(), converted.size());
+
+    // Assert
+    for (std::size_t i = 0; i < values.size(); ++i)
+      REQUIRE(converted[i] == values[i] % modulus);
+  }
+}
+
+// OPERATORS
+
+TEMPLATE_TEST_CASE("Modular integer operators match the reference", "[ModInt][Template]", unsigned, unsigned long long)
+{
+  for (const auto modulus : GetModuli<TestType>())
+  {
+    const MontgomeryModulus<TestType> montgomery(modulus);
+    for (const auto a : GetValues(modulus))
+      for (const auto b : GetValues(modulus))
+      {
+        const ModInt<TestType> left(a, montgomery);
+        const ModInt<TestType> right(b, montgomery);
+        const auto x = static_cast<TestType>(a % modulus), y = static_cast<TestType>(b % modulus);
+
+        REQUIRE((left * right).GetValue() == MultiplyModulo(a, b, modulus));
+        REQUIRE((left * b).GetValue() == MultiplyModulo(a, b, modulus));
+        REQUIRE((left + right).GetValue() == (y >= modulus - x ? y - (modulus - x) : x + y));
+        REQUIRE((left - right).GetValue() == (x >= y ? x - y : x + (modulus - y)));
+        REQUIRE((left - b).GetValue() == (x >= y ? x - y : x + (modulus - y)));
+      }
+  }
+}
+
+TEST_CASE("Modular integer operators require the same modulus", "[ModInt]")
+{
+  // Arrange
+  const ModInt<unsigned> left(3, 7);
+  const ModInt<unsigned> right(3, 11);
+
+  // Act & Assert
+  REQUIRE_THROWS_AS(left + right, std::invalid_argument);
+  REQUIRE_THROWS_AS(left - right, std::invalid_argument);
+  REQUIRE_THROWS_AS(left * right, std::invalid_argument);
+  REQUIRE(left != right);
+  REQUIRE(left == ModInt<unsigned>(10, 7));
+}
+
+TEST_CASE("Modular integers copy the constants of their modulus", "[ModInt]")
+{
+  // Arrange
+  const auto create = [](const unsigned value)
+  {
+    const MontgomeryModulus<unsigned> modulus(7);
+    return ModInt<unsigned>(value, modulus);
+  };
+  const ModInt<unsigned> plain(3, 7);
+
+  // Act
+  const auto copied = create(10);
+
+  // Assert
+  REQUIRE(copied.GetModulus() == plain.GetModulus());
+  REQUIRE(copied == plain);
+  REQUIRE((copied + plain).GetValue() == 6);
+  REQUIRE((copied * plain).GetValue() == 2);
+}
+
+TEST_CASE("Modular integer compound assignment", "[ModInt]")
+{
+  // Arrange
+  ModInt<unsigned long long> number(5, 1000000007ull);
+  const ModInt<unsigned long long> other(1000000006ull, 1000000007ull);
+
+  // Act
+  number *= other;
+  number += other;
+  number -= ModInt<unsigned long long>(3, 1000000007ull);
+
+  // Assert
+  REQUIRE(number.GetValue() == 1000000007ull - 9);
+  REQUIRE(number.ToString() == "999999998");
+}
+
+// POWER AND INVERSE
+
+TEMPLATE_TEST_CASE("Modular power matches repeated multiplication", "[ModInt][Template]", unsigned, unsigned long long)
+{
+  for (const auto modulus : GetModuli<TestType>())
+    for (const auto base : GetValues(modulus))
+    {
+      // Arrange
+      const ModInt<TestType> number(base, modulus);
+      TestType expected = 1 % modulus;
+
+      for (TestType exponent = 0; exponent < 70; ++exponent)
+      {
+        // Act
+        const auto result = number.Pow(exponent);
+
+        // Assert
+        REQUIRE(result.GetValue() == expected);
+        expected = MultiplyModulo(expected, base, modulus);
+      }
+    }
+}
+
+TEST_CASE("Fermat's little theorem holds for large primes", "[ModInt]")
+{
+  for (const auto prime : { 1000000007ull, 2305843009213693951ull, 18446744073709551557ull })
+    for (const auto value : { 2ull, 3ull, 123456789ull, prime - 1 })
+      REQUIRE(ModInt<unsigned long long>(value, prime).Pow(prime - 1).GetValue() == 1);
+}
+
+TEMPLATE_TEST_CASE("Modular inverse gives one", "[ModInt][Template]", unsigned, unsigned long long)
+{
+  for (const auto modulus : GetModuli<TestType>())
+    for (const auto value : GetValues(modulus))
+    {
+      // Arrange
+      const ModInt<TestType> number(value, modulus);
+      const auto one = ModInt<TestType>(1, modulus);
+
+      // Act
+      TestType a = static_cast<TestType>(value % modulus), b = modulus;
+      while (b != 0)
+      {
+        a %= b;
+        std::swap(a, b);
+      }
+
+      // Assert
+      if (a != 1)
+        REQUIRE_THROWS_AS(number.GetInverse(), std::domain_error);
+      else
+      {
+        REQUIRE(number * number.GetInverse() == one);
+        REQUIRE((one / number).GetValue() == number.GetInverse().GetValue());
+      }
+    }
+}
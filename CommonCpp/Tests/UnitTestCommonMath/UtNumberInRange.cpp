@@ -1,3 +1,6 @@
+#include <climits>
+#include <limits>
+#include <utility>
 #include "../catch.hpp"
 #include "../../CommonMath/NumberInRange.hpp"
 #include "DataNumberInRange.hpp"
@@ -35,6 +38,52 @@ TEMPLATE_TEST_CASE("Value is adjusted to range", "[Constructor][Template]", shor
   }
 }
 
+TEMPLATE_TEST_CASE("Value is wrapped as Min + (Value - Min) mod (Max - Min + 1)", "[Constructor][Template]", short, int, long long)
+{
+  for (const auto &[min, max] : { std::make_pair(-3, 4), std::make_pair(-180, 179), std::make_pair(1, 64), std::make_pair(-8, -4), std::make_pair(0, 99) })
+  {
+    const auto length = static_cast<long long>(max) - min + 1;
+    for (long long value = -1000; value <= 1000; ++value)
+    {
+      const auto remainder = (value - min) % length;
+      const auto expected = min + (remainder < 0 ? remainder + length : remainder);
+
+      REQUIRE(NumberInRange<TestType>(static_cast<TestType>(value), static_cast<TestType>(min), static_cast<TestType>(max)).GetValue() == expected);
+    }
+  }
+}
+
+static_assert(NumberInRange<int>::AdjustValue(-23, -8, -4) == -8, "Static adjustment is constexpr.");
+static_assert(NumberInRange<unsigned>::AdjustValue(130, 0, 63) == 2, "Static adjustment is constexpr.");
+static_assert(noexcept(NumberInRange<int>::AdjustValue(0, 1, 2)), "Static adjustment does not throw.");
+
+TEMPLATE_TEST_CASE("Static adjustment matches the constructor", "[AdjustValue][Template]", short, int, long long)
+{
+  for (const auto &[min, max] : { std::make_pair(-3, 4), std::make_pair(-180, 179), std::make_pair(1, 64), std::make_pair(-8, -4), std::make_pair(0, 99) })
+    for (long long value = -1000; value <= 1000; ++value)
+    {
+      const auto number = static_cast<TestType>(value);
+      const NumberInRange<TestType> expected(number, static_cast<TestType>(min), static_cast<TestType>(max));
+
+      REQUIRE(NumberInRange<TestType>::AdjustValue(number, static_cast<TestType>(min), static_cast<TestType>(max)) == expected.GetValue());
+    }
+
+  constexpr auto lowest = std::numeric_limits<TestType>::min();
+  constexpr auto highest = std::numeric_limits<TestType>::max();
+  REQUIRE(NumberInRange<TestType>::AdjustValue(highest, lowest, highest) == highest);
+  REQUIRE(NumberInRange<TestType>::AdjustValue(lowest, static_cast<TestType>(highest - 4), highest) == NumberInRange<TestType>(lowest, static_cast<TestType>(highest - 4), highest).GetValue());
+  REQUIRE(NumberInRange<TestType>::AdjustValue(highest, lowest, static_cast<TestType>(highest - 1)) == lowest);
+}
+
+TEST_CASE("Value is adjusted at the limits of the type", "[Constructor]")
+{
+  REQUIRE(NumberInRange<int>(INT_MIN, INT_MIN, INT_MAX).GetValue() == INT_MIN);
+  REQUIRE(NumberInRange<int>(INT_MAX, INT_MIN, INT_MAX).GetValue() == INT_MAX);
+  REQUIRE(NumberInRange<long long>(LLONG_MAX, LLONG_MIN, LLONG_MAX - 1).GetValue() == LLONG_MIN);
+  REQUIRE(NumberInRange<int>(0, INT_MAX - 4, INT_MAX).GetValue() == INT_MAX - 2);
+  REQUIRE(NumberInRange<unsigned>(UINT_MAX, 3, 9).GetValue() == 3 + (UINT_MAX - 3) % 7);
+}
+
 // OPERATORS
 
 TEST_CASE("Add Int to Class", "[Operator]")
@@ -112,6 +161,89 @@ TEST_CASE("Multiply Class by Class", "[Operator]")
   REQUIRE(result == 3);
 }
 
+TEST_CASE("Operators wrap results in a range crossing zero", "[Operator]")
+{
+  for (int a = -5; a <= 10; ++a)
+    for (int b = -20; b <= 20; ++b)
+    {
+      // Arrange
+      const auto numberInRange = NumberInRange<int>(a, -5, 10);
+      const auto adjusted = NumberInRange<int>::AdjustValue(b, -5, 10);
+
+      // Act
+      const auto sum = numberInRange + b;
+      const auto difference = numberInRange - b;
+      const auto product = numberInRange * b;
+
+      // Assert
+      REQUIRE(sum == NumberInRange<int>::AdjustValue(a + adjusted, -5, 10));
+      REQUIRE(difference == NumberInRange<int>::AdjustValue(a - adjusted, -5, 10));
+      REQUIRE(product == NumberInRange<int>::AdjustValue(a * adjusted, -5, 10));
+    }
+}
+
+TEST_CASE("Add at the limits of the type", "[Operator]")
+{
+  // Arrange
+  const auto full = NumberInRange<int>(INT_MAX, INT_MIN, INT_MAX);
+  const auto upper = NumberInRange<int>(INT_MAX, INT_MAX - 4, INT_MAX);
+
+  // Act
+  const auto wrapped = full + 1;
+  const auto sum = upper + INT_MAX;
+  const auto difference = upper - (INT_MAX - 4);
+
+  // Assert
+  REQUIRE(wrapped == INT_MIN);
+  REQUIRE(sum == INT_MAX - 3);
+  REQUIRE(difference == INT_MAX - 3);
+}
+
+TEST_CASE("Multiply does not overflow near the limits of the type", "[Operator]")
+{
+  for (const auto &[min, max] : { std::make_pair(-5, 10), std::make_pair(0, INT_MAX), std::make_pair(INT_MIN, 7), std::make_pair(-1000000, 1000000), std::make_pair(INT_MAX - 99, INT_MAX) })
+  {
+    const auto length = static_cast<long long>(max) - min + 1;
+    const auto reference = [min = min, length](const long long value)
+    {
+      const auto remainder = (value - min) % length;
+      return min + (remainder < 0 ? remainder + length : remainder);
+    };
+
+    for (const auto a : { min, max, 0, -1, 7, INT_MAX - 1, INT_MIN + 3 })
+      for (const auto b : { min, max, 3, -2, INT_MAX, INT_MIN, 1000003 })
+      {
+        // Arrange
+        const auto numberInRange = NumberInRange<int>(a, min, max);
+
+        // Act
+        const auto product = numberInRange * b;
+
+        // Assert
+        REQUIRE(product == reference(static_cast<long long>(reference(a)) * reference(b)));
+      }
+  }
+}
+
+TEST_CASE("Multiply 64-bit values in a wide range", "[Operator]")
+{
+  // Arrange
+  const long long limit = 1000000000000000000;
+  const auto top = NumberInRange<long long>(limit, 0, limit);
+  const auto belowTop = NumberInRange<long long>(limit - 1, 0, limit);
+  const auto crossing = NumberInRange<long long>(limit, -limit, limit);
+
+  // Act
+  const auto square = top * limit;
+  const auto tripled = belowTop * 3;
+  const auto doubled = crossing * 2;
+
+  // Assert
+  REQUIRE(square == 1);
+  REQUIRE(tripled == limit - 5);
+  REQUIRE(doubled == -1);
+}
+
 TEST_CASE("Divide Class by Int", "[Operator]")
 {
   // Arrange
@@ -0,0 +1,75 @@
+#include <filesystem>
+#include "../catch.hpp"
+#include "../../CommonMath/OutOfCore.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+// MULTIPLICATION
+
+TEMPLATE_TEST_CASE("File-backed matrices are multiplied tile by tile", "[OutOfCore][Template]", int, long, double, float)
+{
+  const auto pathA = GetTempFilePath("UtOutOfCoreA.cmmx");
+  const auto pathB = GetTempFilePath("UtOutOfCoreB.cmmx");
+  const auto pathC = GetTempFilePath("UtOutOfCoreC.cmmx");
+
+  for (const auto budget : { sizeof(TestType) * 5 * 4 * 4, sizeof(TestType) * 5 * 7 * 7, std::size_t(1) << 20 })
+  {
+    SECTION("Memory budget: " + std::to_string(budget))
+    {
+      // Arrange
+      const auto valuesA = CreateValues<TestType>(13, 9, 1);
+      const auto valuesB = CreateValues<TestType>(9, 17, 4);
+      MatrixFile::Save(Matrix<TestType>(valuesA), pathA);
+      MatrixFile::Save(Matrix<TestType>(valuesB), pathB);
+
+      // Act
+      const auto product = OutOfCore::Multiply(FileMatrix<TestType>(pathA), FileMatrix<TestType>(pathB), pathC, budget);
+      const MappedMatrix<TestType> result(product.GetPath(), true);
+
+      // Assert
+      REQUIRE(result.GetRows() == 13);
+      REQUIRE(result.GetColumns() == 17);
+      REQUIRE(result.ToMatrix().GetMatrixValues() == MultiplyValues(valuesA, valuesB));
+    }
+  }
+
+  std::filesystem::remove(pathA);
+  std::filesystem::remove(pathB);
+  std::filesystem::remove(pathC);
+}
+
+TEST_CASE("File-backed matrices with non-matching dimensions cannot be multiplied", "[OutOfCore]")
+{
+  // Arrange
+  const auto pathA = GetTempFilePath("UtOutOfCoreInvalidA.cmmx");
+  const auto pathB = GetTempFilePath("UtOutOfCoreInvalidB.cmmx");
+  MatrixFile::Save(Matrix<double>(2, 3), pathA);
+  MatrixFile::Save(Matrix<double>(2, 3), pathB);
+
+  // Act & Assert
+  REQUIRE_THROWS_AS(OutOfCore::Multiply(FileMatrix<double>(pathA), FileMatrix<double>(pathB), GetTempFilePath("UtOutOfCoreInvalidC.cmmx"), 1 << 20), MatrixDimensionException);
+  REQUIRE_THROWS_AS(OutOfCore::GetTileSize<double>(16), std::invalid_argument);
+
+  std::filesystem::remove(pathA);
+  std::filesystem::remove(pathB);
+}
+
+TEST_CASE("Failure of the background reads is reported", "[OutOfCore]")
+{
+  // Arrange, the operand is truncated after its header was validated
+  const auto pathA = GetTempFilePath("UtOutOfCoreTruncatedA.cmmx");
+  const auto pathB = GetTempFilePath("UtOutOfCoreTruncatedB.cmmx");
+  MatrixFile::Save(Matrix<double>(6, 6), pathA);
+  MatrixFile::Save(Matrix<double>(6, 6), pathB);
+  const FileMatrix<double> a(pathA), b(pathB);
+  std::filesystem::resize_file(pathB, std::filesystem::file_size(pathB) - 16);
+
+  // Act & Assert
+  REQUIRE_THROWS_AS(OutOfCore::Multiply(a, b, GetTempFilePath("UtOutOfCoreTruncatedC.cmmx"), sizeof(double) * 5 * 2 * 2), MatrixFileException);
+
+  std::filesystem::remove(pathA);
+  std::filesystem::remove(pathB);
+  std::filesystem::remove(GetTempFilePath("UtOutOfCoreTruncatedC.cmmx"));
+}
@@ -0,0 +1,151 @@
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/NumberInRange.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+template <typename T>
+static std::vector<T> CreateValues(const std::size_t count, const unsigned seed)
+{
+  // Extremes of the type followed by values spread over the whole type
+  std::vector<T> values { std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), 0, 1, static_cast<T>(-1) };
+  std::uint64_t state = seed;
+  while (values.size() < count)
+  {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    const auto bits = static_cast<T>(state >> 33);
+    values.push_back(values.size() % 3 == 0 ? bits : static_cast<T>(bits % 1000));
+  }
+
+  return values;
+}
+
+template <typename T>
+static std::vector<std::pair<T, T>> GetRanges()
+{
+  std::vector<std::pair<T, T>> ranges { { 0, 99 }, { 0, 127 }, { 3, 9 }, { 1, 64 },
+    { std::numeric_limits<T>::min(), std::numeric_limits<T>::max() },
+    { static_cast<T>(std::numeric_limits<T>::max() - 4), std::numeric_limits<T>::max() },
+    { std::numeric_limits<T>::min(), static_cast<T>(std::numeric_limits<T>::max() - 1) } };
+  if constexpr (std::is_signed<T>::value)
+  {
+    ranges.emplace_back(-3, 4);
+    ranges.emplace_back(-180, 179);
+    ranges.emplace_back(-8, -4);
+  }
+
+  return ranges;
+}
+
+// KERNELS
+
+TEMPLATE_TEST_CASE("Batch operations match the operators", "[NumberInRange][RangeKernels][Template]", int, unsigned, short, long long)
+{
+  // Odd length exercises the remainder loops of all vector widths
+  const std::size_t count = 101;
+  const auto a = CreateValues<TestType>(count, 1);
+  const auto b = CreateValues<TestType>(count, 2);
+
+  for (const auto &[min, max] : GetRanges<TestType>())
+  {
+    SECTION("Min: " + std::to_string(min) + ", Max: " + std::to_string(max))
+    {
+      // Arrange
+      std::vector<TestType> adjusted(count), sums(count), differences(count), products(count);
+
+      // Act
+      NumberInRange<TestType>::AdjustRange(a.data(), adjusted.data(), count, min, max);
+      NumberInRange<TestType>::AddRange(a.data(), b.data(), sums.data(), count, min, max);
+      NumberInRange<TestType>::SubtractRange(a.data(), b.data(), differences.data(), count, min, max);
+      NumberInRange<TestType>::MultiplyRange(a.data(), b.data(), products.data(), count, min, max);
+
+      // Assert
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const NumberInRange<TestType> number(a[i], min, max);
+        REQUIRE(adjusted[i] == number.GetValue());
+        REQUIRE(sums[i] == number + b[i]);
+        REQUIRE(differences[i] == number - b[i]);
+        REQUIRE(products[i] == number * b[i]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Batch operations accept the output in place of an operand", "[NumberInRange][RangeKernels]")
+{
+  // Arrange
+  std::vector<int> values { 5, -1, 12, 7, 100, -33, 4, 0, 9 };
+  const std::vector<int> other(values.size(), 6);
+
+  // Act
+  NumberInRange<int>::AddRange(values.data(), other.data(), values.data(), values.size(), 0, 4);
+
+  // Assert
+  REQUIRE(values == std::vector<int> { 1, 0, 3, 3, 1, 3, 0, 1, 0 });
+}
+
+TEMPLATE_TEST_CASE("Range kernel variants produce equal results", "[RangeKernels][Dispatch][Template]", int, unsigned)
+{
+  const std::size_t count = 203;
+  const auto a = CreateValues<TestType>(count, 3);
+  const auto b = CreateValues<TestType>(count, 4);
+  const auto reference = SelectRangeKernels<TestType>(InstructionSet::Scalar);
+
+  for (const auto instructionSet : GetSupportedInstructionSets())
+  {
+    SECTION(std::string("Instruction set: ") + Dispatch::GetInstructionSetName(instructionSet))
+    {
+      // There are no SSE4.2 range kernels, the scalar ones are selected instead
+      const auto kernels = SelectRangeKernels<TestType>(instructionSet);
+      REQUIRE(kernels.instructionSet == (instructionSet == InstructionSet::Sse42 ? InstructionSet::Scalar : instructionSet));
+
+      for (const auto &[min, max] : GetRanges<TestType>())
+      {
+        const auto parameters = NumberInRange<TestType>(min, min, max).GetParameters();
+        std::vector<TestType> expected(count), actual(count);
+
+        reference.adjust(a.data(), expected.data(), count, parameters);
+        kernels.adjust(a.data(), actual.data(), count, parameters);
+        REQUIRE(actual == expected);
+
+        reference.add(a.data(), b.data(), expected.data(), count, parameters);
+        kernels.add(a.data(), b.data(), actual.data(), count, parameters);
+        REQUIRE(actual == expected);
+
+        reference.subtract(a.data(), b.data(), expected.data(), count, parameters);
+        kernels.subtract(a.data(), b.data(), actual.data(), count, parameters);
+        REQUIRE(actual == expected);
+
+        reference.multiply(a.data(), b.data(), expected.data(), count, parameters);
+        kernels.multiply(a.data(), b.data(), actual.data(), count, parameters);
+        REQUIRE(actual == expected);
+
+        if (parameters.length != 0)
+        {
+          std::vector<RandomWord<TestType>> words;
+          for (const auto value : a)
+            words.push_back(static_cast<RandomWord<TestType>>(value));
+          const auto expectedSuspect = reference.bound(words.data(), expected.data(), count, parameters);
+          REQUIRE(kernels.bound(words.data(), actual.data(), count, parameters) == expectedSuspect);
+          REQUIRE(actual == expected);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Selected range kernels follow the dispatcher", "[RangeKernels][Dispatch]")
+{
+  const auto expected = Dispatch::GetInstructionSet() >= InstructionSet::Avx2 ? Dispatch::GetInstructionSet() : InstructionSet::Scalar;
+
+  REQUIRE(GetRangeKernels<int>().instructionSet == expected);
+  REQUIRE(GetRangeKernels<unsigned>().instructionSet == expected);
+  REQUIRE(GetRangeKernels<long long>().instructionSet == InstructionSet::Scalar);
+}
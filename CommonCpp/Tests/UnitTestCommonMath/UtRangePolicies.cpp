@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/NumberInRange.hpp"
+
+using namespace Common::Math;
+
+static long long Reflect(const long long value, const long long min, const long long max)
+{
+  const auto length = max - min + 1;
+  const auto period = 2 * (length - 1);
+  const auto offset = ((value - min) % period + period) % period;
+  return min + (offset >= length ? period - offset : offset);
+}
+
+static long long Saturate(const long long value, const long long min, const long long max)
+{
+  return std::min(std::max(value, min), max);
+}
+
+template <typename T>
+static std::vector<std::pair<T, T>> GetRanges()
+{
+  std::vector<std::pair<T, T>> ranges { { 0, 4 }, { 0, 99 }, { 1, 64 }, { 3, 9 }, { 0, 1 } };
+  if constexpr (std::is_signed<T>::value)
+  {
+    ranges.emplace_back(-3, 4);
+    ranges.emplace_back(-180, 179);
+    ranges.emplace_back(-8, -4);
+  }
+
+  return ranges;
+}
+
+static_assert(sizeof(NumberInRange<int, RangePolicy::Saturate>) == sizeof(NumberInRange<int>), "Empty policies take no space.");
+static_assert(sizeof(NumberInRange<int, RangePolicy::Reflect>) == sizeof(NumberInRange<int>), "Empty policies take no space.");
+
+static_assert(NumberInRange<int, RangePolicy::Reflect>::AdjustValue(5, 0, 4) == 3, "Reflection is constexpr.");
+static_assert(NumberInRange<int, RangePolicy::Reflect>::AdjustValue(-1, 0, 4) == 1, "Reflection is constexpr.");
+static_assert(NumberInRange<std::uint8_t, RangePolicy::Reflect>::AdjustValue(200, 0, 128) == 56, "Reflection of periods wider than the type is constexpr.");
+static_assert(NumberInRange<int, RangePolicy::Saturate>::AdjustValue(-1, 0, 4) == 0, "Saturation is constexpr.");
+static_assert(NumberInRange<unsigned, RangePolicy::Checked>::AdjustValue(9, 0, 4) == 4, "Checked adjustment is constexpr.");
+
+// REFLECT
+
+TEMPLATE_TEST_CASE("Reflected values run back and forth between the bounds", "[NumberInRange][RangePolicy][Template]", short, int, long long, unsigned)
+{
+  using Number = NumberInRange<TestType, RangePolicy::Reflect>;
+  for (const auto &[min, max] : GetRanges<TestType>())
+    for (long long a = -300; a <= 300; a += 7)
+    {
+      if (a < static_cast<long long>(std::numeric_limits<TestType>::min()))
+        continue;
+
+      const Number number(static_cast<TestType>(a), min, max);
+      REQUIRE(number.GetValue() == Reflect(a, min, max));
+      REQUIRE(Number::AdjustValue(static_cast<TestType>(a), min, max) == Reflect(a, min, max));
+
+      for (long long b = 0; b <= 200; b += 13)
+      {
+        const auto value = static_cast<long long>(number.GetValue());
+        REQUIRE(number + static_cast<TestType>(b) == Reflect(value + b, min, max));
+        REQUIRE(number * static_cast<TestType>(b) == Reflect(value * b, min, max));
+        if (std::is_signed<TestType>::value)
+          REQUIRE(number - static_cast<TestType>(b) == Reflect(value - b, min, max));
+      }
+    }
+}
+
+TEST_CASE("Reflected values at the limits of the type", "[NumberInRange][RangePolicy]")
+{
+  using Number = NumberInRange<long long, RangePolicy::Reflect>;
+  const long long limit = 1000000000000000000;
+
+  REQUIRE(Number(-5000000000000000007, 0, limit).GetValue() == 999999999999999993);
+  REQUIRE(Number(limit - 1, 0, limit) * (limit - 1) == 1);
+  REQUIRE(Number(123456789123456789, 0, limit) * 987654321987654321 == 652796830887364731);
+  // The reflected value of LLONG_MAX and LLONG_MAX add up to a multiple of the period
+  REQUIRE(Number(LLONG_MAX, 0, limit) + LLONG_MAX == 0);
+  REQUIRE(NumberInRange<int, RangePolicy::Reflect>(INT_MIN, 0, INT_MAX).GetValue() == INT_MAX - 1);
+  REQUIRE(NumberInRange<int, RangePolicy::Reflect>(INT_MAX, INT_MIN + 1, 0).GetValue() == INT_MIN + 1);
+}
+
+TEST_CASE("Reflection requires the period to fit into the type", "[NumberInRange][RangePolicy]")
+{
+  using Number = NumberInRange<int, RangePolicy::Reflect>;
+  using Unsigned = NumberInRange<unsigned, RangePolicy::Reflect>;
+
+  REQUIRE_NOTHROW(Number(0, 0, INT_MAX));
+  REQUIRE_THROWS_AS(Number(0, -1, INT_MAX), std::invalid_argument);
+  REQUIRE_THROWS_AS(Unsigned(0, 0, UINT_MAX), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("Reflected values of ranges with a period wider than the type are adjusted", "[NumberInRange][RangePolicy][Template]", std::uint8_t, std::int8_t)
+{
+  // Arrange, the period 2 * (max - min) does not fit into the unsigned type, constructors reject such ranges
+  using Number = NumberInRange<TestType, RangePolicy::Reflect>;
+  const std::vector<std::pair<TestType, TestType>> ranges = std::is_signed<TestType>::value
+    ? std::vector<std::pair<TestType, TestType>> { { -100, 100 }, { -128, 0 }, { -1, 127 } }
+    : std::vector<std::pair<TestType, TestType>> { { 0, 128 }, { 10, 200 }, { 1, 255 } };
+
+  for (const auto &[min, max] : ranges)
+  {
+    REQUIRE_THROWS_AS(Number(min, min, max), std::invalid_argument);
+
+    // Act & Assert
+    for (auto a = static_cast<long long>(std::numeric_limits<TestType>::min()); a <= static_cast<long long>(std::numeric_limits<TestType>::max()); ++a)
+      REQUIRE(Number::AdjustValue(static_cast<TestType>(a), min, max) == Reflect(a, min, max));
+  }
+}
+
+// SATURATE
+
+TEMPLATE_TEST_CASE("Saturated values are clamped to the bounds", "[NumberInRange][RangePolicy][Template]", short, int, long long, unsigned)
+{
+  using Number = NumberInRange<TestType, RangePolicy::Saturate>;
+  for (const auto &[min, max] : GetRanges<TestType>())
+    for (long long a = -300; a <= 300; a += 7)
+    {
+      if (a < static_cast<long long>(std::numeric_limits<TestType>::min()))
+        continue;
+
+      const Number number(static_cast<TestType>(a), min, max);
+      REQUIRE(number.GetValue() == Saturate(a, min, max));
+      REQUIRE(Number::AdjustValue(static_cast<TestType>(a), min, max) == Saturate(a, min, max));
+
+      for (long long b = 0; b <= 200; b += 13)
+      {
+        const auto value = static_cast<long long>(number.GetValue());
+        REQUIRE(number + static_cast<TestType>(b) == Saturate(value + b, min, max));
+        REQUIRE(number * static_cast<TestType>(b) == Saturate(value * b, min, max));
+        REQUIRE(number - static_cast<TestType>(b) == Saturate(std::is_signed<TestType>::value ? value - b : std::max(value - b, 0LL), min, max));
+      }
+    }
+}
+
+TEST_CASE("Saturated results do not overflow the type", "[NumberInRange][RangePolicy]")
+{
+  using Number = NumberInRange<int, RangePolicy::Saturate>;
+  using Unsigned = NumberInRange<unsigned, RangePolicy::Saturate>;
+
+  REQUIRE(Number(INT_MAX, 0, INT_MAX) + INT_MAX == INT_MAX);
+  REQUIRE(Number(INT_MAX - 1, -5, INT_MAX) * -3 == -5);
+  REQUIRE(Number(INT_MIN, INT_MIN, 0) - INT_MAX == INT_MIN);
+  REQUIRE(Number(INT_MIN, INT_MIN, 0) * INT_MIN == 0);
+  REQUIRE(Number(INT_MIN, INT_MIN, INT_MAX) * -1 == INT_MAX);
+  REQUIRE(Number(-2, INT_MIN, INT_MAX) * (INT_MIN / 2) == INT_MAX);
+  REQUIRE(Number(2, INT_MIN, INT_MAX) * (INT_MIN / 2) == INT_MIN);
+  REQUIRE(Unsigned(5, 0, UINT_MAX) - 6u == 0);
+  REQUIRE(Unsigned(UINT_MAX, 1, UINT_MAX) * UINT_MAX == UINT_MAX);
+  REQUIRE(NumberInRange<long long, RangePolicy::Saturate>(LLONG_MAX, 0, LLONG_MAX) * 3 == LLONG_MAX);
+}
+
+// CHECKED
+
+TEST_CASE("Checked values record assignments out of range", "[NumberInRange][RangePolicy]")
+{
+  // Arrange
+  NumberInRange<int, RangePolicy::Checked> number(5, 0, 9);
+  NumberInRange<int, RangePolicy::Checked> invalid(12, 0, 9);
+  NumberInRange<int, RangePolicy::Checked> limit(INT_MAX, 0, INT_MAX);
+
+  // Act
+  const auto inRange = number.IsOutOfRange();
+  const auto sum = number + 7;
+  const auto sumChecked = number.IsOutOfRange();
+  number += 4;
+  const auto assignedInRange = number.IsOutOfRange();
+  number *= 2;
+  limit += 1;
+
+  // Assert
+  REQUIRE_FALSE(inRange);
+  REQUIRE(sum == 9);
+  REQUIRE_FALSE(sumChecked);
+  REQUIRE_FALSE(assignedInRange);
+  REQUIRE(number.IsOutOfRange());
+  REQUIRE(number.GetValue() == 9);
+  REQUIRE(invalid.IsOutOfRange());
+  REQUIRE(invalid.GetValue() == 9);
+  REQUIRE(limit.IsOutOfRange());
+  REQUIRE(limit.GetValue() == INT_MAX);
+
+  number.ClearOutOfRange();
+  number -= 9;
+  REQUIRE_FALSE(number.IsOutOfRange());
+  number.SetValue(-1);
+  REQUIRE(number.IsOutOfRange());
+  REQUIRE(number.GetValue() == 0);
+}
+
+// BATCH
+
+TEMPLATE_TEST_CASE("Policy batch operations match the operators", "[NumberInRange][RangePolicy][Template]", int, unsigned, short, long long)
+{
+  std::vector<TestType> a, b;
+  for (long long i = -260; i <= 260; i += 3)
+  {
+    a.push_back(static_cast<TestType>(i * 7));
+    b.push_back(static_cast<TestType>(i % 2 == 0 ? i : -i * 13));
+  }
+  a.push_back(std::numeric_limits<TestType>::max());
+  b.push_back(std::numeric_limits<TestType>::max());
+  a.push_back(std::numeric_limits<TestType>::min());
+  b.push_back(std::numeric_limits<TestType>::min());
+
+  const auto check = [&](auto policy)
+  {
+    using Number = NumberInRange<TestType, decltype(policy)>;
+    std::vector<TestType> adjusted(a.size()), sum(a.size()), difference(a.size()), product(a.size());
+    for (const auto &[min, max] : GetRanges<TestType>())
+    {
+      Number::AdjustRange(a.data(), adjusted.data(), a.size(), min, max);
+      Number::AddRange(a.data(), b.data(), sum.data(), a.size(), min, max);
+      Number::SubtractRange(a.data(), b.data(), difference.data(), a.size(), min, max);
+      Number::MultiplyRange(a.data(), b.data(), product.data(), a.size(), min, max);
+
+      for (std::size_t i = 0; i < a.size(); ++i)
+      {
+        const Number number(a[i], min, max);
+        REQUIRE(adjusted[i] == number.GetValue());
+        REQUIRE(sum[i] == number + b[i]);
+        REQUIRE(difference[i] == number - b[i]);
+        REQUIRE(product[i] == number * b[i]);
+      }
+    }
+  };
+
+  check(RangePolicy::Reflect());
+  check(RangePolicy::Saturate());
+  check(RangePolicy::Checked());
+}
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/RingBuffer.hpp"
+
+using namespace Common::Math;
+
+/**
+ * \brief Pushes and pops single values and batches in a fixed pattern and compares the buffer with a queue
+ */
+template <typename TBuffer>
+static void CheckAgainstQueue(TBuffer & buffer)
+{
+  std::deque<int> expected;
+  std::vector<int> batch(7), popped(7);
+  auto next = 0;
+
+  for (auto step = 0; step < 500; ++step)
+  {
+    if (step % 5 < 3)
+    {
+      for (auto & value : batch)
+        value = next++;
+      const auto count = static_cast<std::size_t>(step % 4 == 0 ? 1 : step % 7);
+      const auto pushed = step % 2 == 0 ? buffer.PushRange(batch.data(), count) : static_cast<std::size_t>(buffer.TryPush(batch[0]));
+      const auto free = buffer.GetCapacity() - expected.size();
+
+      REQUIRE(pushed == std::min(step % 2 == 0 ? count : 1, free));
+      expected.insert(expected.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(pushed));
+      next = batch[0] + static_cast<int>(pushed);
+    }
+    else
+    {
+      const auto count = static_cast<std::size_t>(step % 6);
+      const auto poppedCount = step % 3 == 0 ? buffer.PopRange(popped.data(), count) : static_cast<std::size_t>(buffer.TryPop(popped[0]));
+
+      REQUIRE(poppedCount == std::min(step % 3 == 0 ? count : 1, expected.size()));
+      for (std::size_t i = 0; i < poppedCount; ++i)
+      {
+        REQUIRE(popped[i] == expected.front());
+        expected.pop_front();
+      }
+    }
+
+    REQUIRE(buffer.GetSize() == expected.size());
+    REQUIRE(buffer.IsEmpty() == expected.empty());
+  }
+}
+
+// SINGLE PRODUCER
+
+TEST_CASE("Single producer buffer keeps the order of a queue", "[RingBuffer]")
+{
+  for (const auto capacity : { 1, 3, 4, 10, 16 })
+  {
+    // Arrange
+    SpscRingBuffer<int> buffer(static_cast<std::size_t>(capacity));
+
+    // Act & Assert
+    REQUIRE(buffer.GetCapacity() == static_cast<std::size_t>(capacity));
+    CheckAgainstQueue(buffer);
+  }
+}
+
+TEST_CASE("Single producer buffer reports full and empty", "[RingBuffer]")
+{
+  // Arrange
+  SpscRingBuffer<int> buffer(3);
+  int value = 0;
+
+  // Act
+  const auto poppedEmpty = buffer.TryPop(value);
+  const auto pushed = buffer.TryPush(1) && buffer.TryPush(2) && buffer.TryPush(3);
+  const auto pushedFull = buffer.TryPush(4);
+
+  // Assert
+  REQUIRE_FALSE(poppedEmpty);
+  REQUIRE(pushed);
+  REQUIRE_FALSE(pushedFull);
+  REQUIRE(buffer.GetSize() == 3);
+  REQUIRE(buffer.TryPop(value));
+  REQUIRE(value == 1);
+  REQUIRE(buffer.TryPush(4));
+  REQUIRE_THROWS_AS(SpscRingBuffer<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("Single producer buffer moves values", "[RingBuffer]")
+{
+  // Arrange
+  SpscRingBuffer<std::unique_ptr<int>> buffer(2);
+  std::unique_ptr<int> value;
+
+  // Act
+  buffer.TryPush(std::make_unique<int>(5));
+  buffer.TryPop(value);
+
+  // Assert
+  REQUIRE(*value == 5);
+}
+
+TEST_CASE("Single producer buffer passes values between threads", "[RingBuffer]")
+{
+  // Arrange
+  const auto count = 100000;
+  SpscRingBuffer<int> buffer(100);
+  std::vector<int> received;
+  received.reserve(count);
+
+  // Act
+  std::thread producer([&buffer]
+  {
+    std::vector<int> batch(13);
+    for (auto next = 0; next < count;)
+      if (next % 3 == 0)
+      {
+        for (std::size_t i = 0; i < batch.size(); ++i)
+          batch[i] = next + static_cast<int>(i);
+        const auto pushed = buffer.PushRange(batch.data(), std::min(batch.size(), static_cast<std::size_t>(count - next)));
+        next += static_cast<int>(pushed);
+        if (pushed == 0)
+          std::this_thread::yield();
+      }
+      else if (buffer.TryPush(next))
+        ++next;
+      else
+        std::this_thread::yield();
+  });
+  std::vector<int> batch(17);
+  while (received.size() < static_cast<std::size_t>(count))
+  {
+    const auto popped = buffer.PopRange(batch.data(), batch.size());
+    received.insert(received.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(popped));
+    if (popped == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+
+  // Assert
+  for (auto i = 0; i < count; ++i)
+    REQUIRE(received[i] == i);
+  REQUIRE(buffer.IsEmpty());
+}
+
+// MULTIPLE PRODUCERS
+
+TEST_CASE("Multiple producer buffer keeps the order of a queue", "[RingBuffer]")
+{
+  for (const auto capacity : { 2, 3, 4, 10, 16 })
+  {
+    // Arrange
+    MpmcRingBuffer<int> buffer(static_cast<std::size_t>(capacity));
+
+    // Act & Assert
+    REQUIRE(buffer.GetCapacity() == static_cast<std::size_t>(capacity));
+    CheckAgainstQueue(buffer);
+  }
+
+  REQUIRE_THROWS_AS(MpmcRingBuffer<int>(1), std::invalid_argument);
+}
+
+TEST_CASE("Multiple producer buffer passes every value exactly once", "[RingBuffer]")
+{
+  for (const auto capacity : { 64, 100 })
+  {
+    // Arrange
+    const int producerCount = 4, consumerCount = 4, perProducer = 20000;
+    MpmcRingBuffer<int> buffer(static_cast<std::size_t>(capacity));
+    std::vector<std::vector<int>> received(consumerCount);
+    std::atomic<int> remaining(producerCount * perProducer);
+    std::vector<std::thread> threads;
+
+    // Act, values encode the producer in the lowest bits
+    for (auto p = 0; p < producerCount; ++p)
+      threads.emplace_back([&buffer, p]
+      {
+        std::vector<int> batch(5);
+        for (auto i = 0; i < perProducer;)
+          if (i % 2 == 0 && i + static_cast<int>(batch.size()) <= perProducer)
+          {
+            for (std::size_t j = 0; j < batch.size(); ++j)
+              batch[j] = (i + static_cast<int>(j)) * producerCount + p;
+            const auto pushed = static_cast<int>(buffer.PushRange(batch.data(), batch.size()));
+            i += pushed;
+            if (pushed == 0)
+              std::this_thread::yield();
+          }
+          else if (buffer.TryPush(i * producerCount + p))
+            ++i;
+          else
+            std::this_thread::yield();
+      });
+    for (auto c = 0; c < consumerCount; ++c)
+      threads.emplace_back([&buffer, &received, &remaining, c]
+      {
+        std::vector<int> batch(3);
+        while (remaining.load() > 0)
+        {
+          const auto popped = c % 2 == 0 ? buffer.PopRange(batch.data(), batch.size()) : static_cast<std::size_t>(buffer.TryPop(batch[0]));
+          received[c].insert(received[c].end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(popped));
+          remaining -= static_cast<int>(popped);
+          if (popped == 0)
+            std::this_thread::yield();
+        }
+      });
+    for (auto & thread : threads)
+      thread.join();
+
+    // Assert, every consumer sees the values of a producer in order
+    std::vector<int> counts(producerCount * perProducer);
+    for (const auto & values : received)
+    {
+      std::vector<int> last(producerCount, -1);
+      for (const auto value : values)
+      {
+        ++counts[value];
+        REQUIRE(value / producerCount > last[value % producerCount]);
+        last[value % producerCount] = value / producerCount;
+      }
+    }
+    for (const auto count : counts)
+      REQUIRE(count == 1);
+    REQUIRE(buffer.IsEmpty());
+  }
+}
@@ -0,0 +1,143 @@
+#include <climits>
+#include "../catch.hpp"
+#include "../../CommonMath/StaticNumberInRange.hpp"
+
+using namespace Common::Math;
+
+template <typename T, T Min, T Max>
+static long long Reference(const long long value)
+{
+  const auto length = static_cast<long long>(Max) - Min + 1;
+  const auto remainder = (value - Min) % length;
+  return Min + (remainder < 0 ? remainder + length : remainder);
+}
+
+template <typename T, T Min, T Max>
+static void CheckRange(const long long first, const long long last)
+{
+  using Number = StaticNumberInRange<T, Min, Max>;
+  for (auto value = first; value <= last; ++value)
+  {
+    if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max())
+      continue;
+
+    REQUIRE(Number::AdjustValue(static_cast<T>(value)) == Reference<T, Min, Max>(value));
+    REQUIRE(Number(static_cast<T>(value)).GetValue() == Reference<T, Min, Max>(value));
+  }
+}
+
+template <typename T, T Min, T Max>
+static void CheckOperators()
+{
+  using Number = StaticNumberInRange<T, Min, Max>;
+  for (auto a = static_cast<long long>(Min); a <= Max; ++a)
+    for (auto b = static_cast<long long>(Min); b <= Max; ++b)
+    {
+      const Number left(static_cast<T>(a));
+      const Number right(static_cast<T>(b));
+
+      REQUIRE((left + right).GetValue() == Reference<T, Min, Max>(a + b));
+      REQUIRE((left - right).GetValue() == Reference<T, Min, Max>(a - b));
+      REQUIRE((left * right).GetValue() == Reference<T, Min, Max>(a * b));
+      if (b != 0)
+        REQUIRE((left / right).GetValue() == Reference<T, Min, Max>(a / b));
+    }
+}
+
+static_assert(sizeof(StaticNumberInRange<int, 0, 7>) == sizeof(int), "Only the value is stored.");
+static_assert(sizeof(StaticNumberInRange<short, -180, 179>) == sizeof(short), "Only the value is stored.");
+
+static_assert(StaticNumberInRange<int, 0, 4>(5).GetValue() == 0, "Construction is constexpr.");
+static_assert(StaticNumberInRange<int, -8, -4>(-23).GetValue() == -8, "Construction is constexpr.");
+static_assert((StaticNumberInRange<int, 0, 4>(5) + 6).GetValue() == 1, "Addition is constexpr.");
+static_assert((StaticNumberInRange<int, 0, 4>(5) - 6).GetValue() == 4, "Subtraction is constexpr.");
+static_assert((StaticNumberInRange<int, 0, 4>(9) * 7).GetValue() == 3, "Multiplication is constexpr.");
+static_assert((StaticNumberInRange<int, 0, 4>(9) / 7).GetValue() == 2, "Division is constexpr.");
+static_assert(StaticNumberInRange<unsigned, 0, 63>::AdjustValue(130) == 2, "Adjustment is constexpr.");
+static_assert((StaticNumberInRange<int, 0, 2147483646>(2147483646) * 2147483646).GetValue() == 1, "Multiplication does not overflow.");
+static_assert((StaticNumberInRange<long long, 0, 1000000000000000000>(1000000000000000000) * 1000000000000000000).GetValue() == 1, "Multiplication does not overflow.");
+
+// ADJUSTMENT
+
+TEST_CASE("Static range wraps values", "[StaticNumberInRange]")
+{
+  CheckRange<int, 0, 4>(-300, 300);
+  CheckRange<int, -8, -4>(-300, 300);
+  CheckRange<int, -180, 179>(-1000, 1000);
+  CheckRange<int, -3, 4>(-300, 300);
+  CheckRange<long, 1, 64>(-300, 300);
+  CheckRange<short, -100, 27>(-40000, 40000);
+  CheckRange<unsigned, 3, 9>(0, 300);
+  CheckRange<unsigned, 0, 15>(0, 300);
+  CheckRange<unsigned char, 10, 20>(0, 255);
+}
+
+TEST_CASE("Static range wraps values at the limits of the type", "[StaticNumberInRange]")
+{
+  using Full = StaticNumberInRange<int, INT_MIN, INT_MAX>;
+  using AlmostFull = StaticNumberInRange<long long, LLONG_MIN, LLONG_MAX - 1>;
+  using Upper = StaticNumberInRange<int, INT_MAX - 4, INT_MAX>;
+
+  REQUIRE(Full::AdjustValue(INT_MIN) == INT_MIN);
+  REQUIRE(Full::AdjustValue(INT_MAX) == INT_MAX);
+  REQUIRE((Full(INT_MAX) + 1).GetValue() == INT_MIN);
+  REQUIRE((Upper(INT_MAX) + INT_MAX).GetValue() == Reference<int, INT_MAX - 4, INT_MAX>(2LL * INT_MAX));
+  REQUIRE((Upper(INT_MAX - 4) - INT_MAX).GetValue() == Reference<int, INT_MAX - 4, INT_MAX>(-4));
+  REQUIRE(AlmostFull::AdjustValue(LLONG_MAX) == LLONG_MIN);
+  REQUIRE(AlmostFull::AdjustValue(LLONG_MIN) == LLONG_MIN);
+  REQUIRE(Upper::AdjustValue(INT_MIN) == Reference<int, INT_MAX - 4, INT_MAX>(INT_MIN));
+  REQUIRE(Upper::AdjustValue(0) == INT_MAX - 2);
+  REQUIRE(StaticNumberInRange<unsigned char, 0, 255>::AdjustValue(200) == 200);
+}
+
+// OPERATORS
+
+TEST_CASE("Static range operators wrap their results", "[StaticNumberInRange]")
+{
+  CheckOperators<int, 0, 4>();
+  CheckOperators<int, -8, -4>();
+  CheckOperators<int, -5, 10>();
+  CheckOperators<short, -16, 15>();
+  CheckOperators<unsigned, 2, 12>();
+  CheckOperators<unsigned char, 0, 31>();
+}
+
+TEST_CASE("Static range multiplication does not overflow", "[StaticNumberInRange]")
+{
+  using Wide = StaticNumberInRange<int, -1000000, 1000000>;
+  using Upper = StaticNumberInRange<int, INT_MAX - 99, INT_MAX>;
+  using Unsigned = StaticNumberInRange<unsigned, 5, 4000000000u>;
+
+  for (const long long a : { -1000000, 999999, 123457, -65537 })
+    for (const long long b : { 1000000, -999983, 77777 })
+      REQUIRE((Wide(static_cast<int>(a)) * Wide(static_cast<int>(b))).GetValue() == Reference<int, -1000000, 1000000>(a * b));
+
+  for (const long long a : { INT_MAX - 99, INT_MAX - 50, INT_MAX })
+    for (const long long b : { INT_MAX - 98, INT_MAX - 1 })
+      REQUIRE((Upper(static_cast<int>(a)) * Upper(static_cast<int>(b))).GetValue() == Reference<int, INT_MAX - 99, INT_MAX>(a * b));
+
+  REQUIRE((Unsigned(3999999999u) * Unsigned(3999999998u)).GetValue() == 5 + (3999999999ull * 3999999998ull - 5) % 3999999996ull);
+}
+
+TEST_CASE("Static range increments and decrements wrap", "[StaticNumberInRange]")
+{
+  // Arrange
+  StaticNumberInRange<int, 0, 63> ring(62);
+  StaticNumberInRange<int, -2, 2> small(2);
+
+  // Act
+  const auto before = ring++;
+  ++ring;
+  ++small;
+  --small;
+  --small;
+  small -= 7;
+
+  // Assert
+  REQUIRE(before.GetValue() == 62);
+  REQUIRE(ring.GetValue() == 0);
+  REQUIRE((--ring).GetValue() == 63);
+  REQUIRE(small.GetValue() == -1);
+  REQUIRE(small == StaticNumberInRange<int, -2, 2>(4));
+  REQUIRE(small.ToString() == "-1");
+}
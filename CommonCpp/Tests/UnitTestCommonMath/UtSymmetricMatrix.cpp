@@ -0,0 +1,86 @@
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/SymmetricMatrix.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+template <typename T>
+static Matrix<T> CreateSymmetric(const unsigned size, const int seed)
+{
+  // The lower triangle mirrors the upper one
+  auto values = CreateValues<T>(size, size, seed);
+  for (unsigned i = 0; i < size; ++i)
+    for (unsigned j = 0; j < i; ++j)
+      values[i][j] = values[j][i];
+
+  return Matrix<T>(std::move(values));
+}
+
+// STORAGE
+
+TEMPLATE_TEST_CASE("Symmetric matrix stores only its upper triangle", "[SymmetricMatrix][Template]", int, long, double, float)
+{
+  // Arrange
+  const auto matrix = CreateSymmetric<TestType>(6, 1);
+
+  // Act
+  SymmetricMatrix<TestType> packed(matrix);
+
+  // Assert
+  REQUIRE(packed.GetPackedValues().size() == 21);
+  REQUIRE(packed.GetMatrixType() == (Type::Invertable | Type::Symmetric));
+  REQUIRE(packed.ToMatrix().GetMatrixValues() == matrix.GetMatrixValues());
+
+  packed.Set(4, 1, 9);
+  REQUIRE(packed.Get(1, 4) == 9);
+  REQUIRE(packed.Get(4, 1) == 9);
+  REQUIRE_THROWS_AS(packed.Set(6, 1, 9), std::invalid_argument);
+  REQUIRE_THROWS_AS(SymmetricMatrix<TestType>(Matrix<TestType>(2, 3)), std::invalid_argument);
+}
+
+// OPERATIONS
+
+TEMPLATE_TEST_CASE("Symmetric products equal full products", "[SymmetricMatrix][Template]", int, long, double, float)
+{
+  // Arrange
+  const auto matrix = CreateSymmetric<TestType>(11, 2);
+  const SymmetricMatrix<TestType> packed(matrix);
+  std::vector<std::vector<TestType>> values(11, std::vector<TestType>(5));
+  for (unsigned i = 0; i < 11; ++i)
+    for (unsigned j = 0; j < 5; ++j)
+      values[i][j] = static_cast<TestType>((i * 5 + j) % 7) - 3;
+  const Matrix<TestType> other(values);
+  const auto column = other.Transpose().GetMatrixValues()[2];
+
+  // Act
+  const auto product = packed * other;
+  const auto vectorProduct = packed * column;
+
+  // Assert
+  REQUIRE(product.GetMatrixValues() == (matrix * other).GetMatrixValues());
+  REQUIRE(vectorProduct == matrix * column);
+}
+
+TEMPLATE_TEST_CASE("Symmetric determinant equals the cofactor expansion", "[SymmetricMatrix][Template]", int, long, double, float)
+{
+  for (const auto size : { 1u, 2u, 5u, 7u })
+  {
+    SECTION("Size: " + std::to_string(size))
+    {
+      // Arrange
+      const auto matrix = CreateSymmetric<TestType>(size, 3);
+
+      // Act
+      const auto determinant = SymmetricMatrix<TestType>(matrix).GetDeterminant();
+
+      // Assert
+      REQUIRE(determinant == Approx(matrix.GetDeterminant()).margin(1e-6));
+      REQUIRE(SymmetricMatrix<TestType>(matrix).IsSingular() == (matrix.GetDeterminant() == 0));
+    }
+  }
+
+  REQUIRE(SymmetricMatrix<TestType>(3).GetDeterminant() == 0);
+  REQUIRE(SymmetricMatrix<TestType>(3).IsSingular());
+}
@@ -0,0 +1,127 @@
+#include <sstream>
+#include <thread>
+#include "../catch.hpp"
+#include "../../CommonMath/Matrix.hpp"
+
+using namespace Common::Math;
+
+static std::size_t CountOccurrences(const std::string & text, const std::string & pattern)
+{
+  std::size_t count = 0;
+  for (auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+    ++count;
+
+  return count;
+}
+
+static std::string WriteTrace()
+{
+  std::ostringstream output;
+  Tracing::Write(output);
+  return output.str();
+}
+
+#ifdef COMMON_MATH_TRACING
+
+// SCOPES
+
+TEST_CASE("Expensive operations are traced", "[Tracing]")
+{
+  // Arrange
+  const Matrix<double> matrix(std::vector<std::vector<double>> { { 2, 0, 1 }, { 1, 3, 2 }, { 1, 1, 2 } });
+  Tracing::Clear();
+
+  // Act
+  const auto product = matrix * matrix;
+  matrix.GetInverse();
+  const auto trace = WriteTrace();
+
+  // Assert
+  REQUIRE(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Matrix::Multiply\"") == 1);
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Matrix::Inverse\"") == 1);
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Matrix::Determinant\"") == 1);
+  REQUIRE(CountOccurrences(trace, "\"args\":{\"size\":27}") == 1);
+}
+
+TEST_CASE("Disabled tracing records nothing", "[Tracing]")
+{
+  // Arrange
+  const Matrix<int> matrix(std::vector<std::vector<int>>(4, std::vector<int>(4, 1)));
+  Tracing::Clear();
+  Tracing::SetEnabled(false);
+
+  // Act
+  const auto product = matrix * matrix;
+  Tracing::SetEnabled(true);
+
+  // Assert
+  REQUIRE(CountOccurrences(WriteTrace(), "\"ph\":\"X\"") == 0);
+}
+
+// THREADS
+
+TEST_CASE("Events are attributed to their threads", "[Tracing]")
+{
+  // Arrange
+  const Matrix<int> matrix(std::vector<std::vector<int>>(4, std::vector<int>(4, 1)));
+  Tracing::Clear();
+
+  // Act
+  std::thread worker([&matrix] { const auto product = matrix * matrix; });
+  worker.join();
+  const auto product = matrix * matrix;
+  const auto trace = WriteTrace();
+
+  // Assert
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Matrix::Multiply\"") == 2);
+  REQUIRE(CountOccurrences(trace, "\"name\":\"thread_name\"") >= 2);
+}
+
+TEST_CASE("Ring buffer keeps the most recent events", "[Tracing]")
+{
+  // Arrange
+  Tracing::Clear();
+
+  // Act
+  for (std::size_t i = 0; i < Tracing::Capacity + 10; ++i)
+    Tracing::Record({ i < 10 ? "Old" : "Recent", i, 1, 0 });
+  const auto trace = WriteTrace();
+
+  // Assert
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Old\"") == 0);
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Recent\"") == Tracing::Capacity);
+  REQUIRE(trace.find("\"ts\":0.010,\"dur\":0.001") != std::string::npos);
+}
+
+TEST_CASE("Events of exited threads are kept up to the retired capacity", "[Tracing]")
+{
+  // Arrange
+  Tracing::Clear();
+  const auto threads = Tracing::RetiredCapacity / Tracing::Capacity + 2;
+
+  // Act
+  for (std::size_t thread = 0; thread < threads; ++thread)
+    std::thread([thread]
+    {
+      for (std::size_t i = 0; i < Tracing::Capacity; ++i)
+        Tracing::Record({ thread < 2 ? "Old" : "Retired", i, 1, 0 });
+    }).join();
+  const auto trace = WriteTrace();
+
+  // Assert
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Old\"") == 0);
+  REQUIRE(CountOccurrences(trace, "\"name\":\"Retired\"") == Tracing::RetiredCapacity);
+}
+
+#else
+
+TEST_CASE("Disabled tracing records nothing", "[Tracing]")
+{
+  Tracing::Clear();
+  const auto product = Matrix<int>(4, 4) * Matrix<int>(4, 4);
+
+  REQUIRE(CountOccurrences(WriteTrace(), "\"ph\":\"X\"") == 0);
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/TriangularMatrix.hpp"
+#include "DataFixtures.hpp"
+
+using namespace Common::Math;
+using namespace Common::Math::Tests;
+
+template <typename T>
+static std::vector<std::vector<T>> CreateDominantValues(const unsigned rows, const unsigned columns, const int seed)
+{
+  auto values = CreateValues<T>(rows, columns, seed);
+
+  // Dominant diagonal keeps the substitution well conditioned
+  for (unsigned i = 0; i < rows && i < columns; ++i)
+    values[i][i] = static_cast<T>(3 * rows);
+
+  return values;
+}
+
+template <typename T>
+static Matrix<T> MaskTriangle(const Matrix<T> & matrix, const Triangle triangle)
+{
+  auto values = matrix.GetMatrixValues();
+  for (unsigned i = 0; i < matrix.GetRows(); ++i)
+    for (unsigned j = 0; j < matrix.GetColumns(); ++j)
+      if (triangle == Triangle::Upper ? j < i : j > i)
+        values[i][j] = 0;
+
+  return Matrix<T>(std::move(values));
+}
+
+// STORAGE
+
+TEMPLATE_TEST_CASE("Triangular matrix stores only its triangle", "[TriangularMatrix][Template]", int, long, double, float)
+{
+  const Matrix<TestType> matrix(CreateDominantValues<TestType>(7, 7, 1));
+
+  for (const auto triangle : { Triangle::Upper, Triangle::Lower })
+  {
+    SECTION(triangle == Triangle::Upper ? "Upper" : "Lower")
+    {
+      // Act
+      const TriangularMatrix<TestType> packed(matrix, triangle);
+      const auto expected = MaskTriangle(matrix, triangle);
+
+      // Assert
+      REQUIRE(packed.GetPackedValues().size() == 28);
+      REQUIRE(packed.GetMatrixType() == (Type::Invertable | (triangle == Triangle::Upper ? Type::UpperTriangular : Type::LowerTriangular)));
+      REQUIRE(packed.ToMatrix().GetMatrixValues() == expected.GetMatrixValues());
+      REQUIRE(packed.Transpose().ToMatrix().GetMatrixValues() == expected.Transpose().GetMatrixValues());
+      for (unsigned i = 0; i < 7; ++i)
+        for (unsigned j = 0; j < 7; ++j)
+          REQUIRE(packed.Get(i, j) == expected.GetMatrixValues()[i][j]);
+    }
+  }
+}
+
+TEST_CASE("Triangular matrix rejects values outside of the triangle", "[TriangularMatrix]")
+{
+  TriangularMatrix<double> matrix(3, Triangle::Lower);
+
+  REQUIRE_NOTHROW(matrix.Set(2, 0, 4));
+  REQUIRE(matrix.Get(2, 0) == 4);
+  REQUIRE_THROWS_AS(matrix.Set(0, 2, 4), std::invalid_argument);
+  REQUIRE_THROWS_AS(matrix.Set(3, 0, 4), std::invalid_argument);
+  REQUIRE_THROWS_AS(TriangularMatrix<double>(0, Triangle::Upper), std::invalid_argument);
+  REQUIRE_THROWS_AS(TriangularMatrix<double>(Matrix<double>(2, 3), Triangle::Upper), std::invalid_argument);
+}
+
+// OPERATIONS
+
+TEMPLATE_TEST_CASE("Triangular products equal full products", "[TriangularMatrix][Template]", int, long, double, float)
+{
+  const Matrix<TestType> matrix(CreateDominantValues<TestType>(9, 9, 2));
+  const Matrix<TestType> other(CreateDominantValues<TestType>(9, 4, 5));
+  const auto column = other.Transpose().GetMatrixValues()[0];
+
+  for (const auto triangle : { Triangle::Upper, Triangle::Lower })
+  {
+    SECTION(triangle == Triangle::Upper ? "Upper" : "Lower")
+    {
+      // Arrange
+      const TriangularMatrix<TestType> packed(matrix, triangle);
+      const auto full = MaskTriangle(matrix, triangle);
+
+      // Act
+      const auto product = packed * other;
+      const auto vectorProduct = packed * column;
+
+      // Assert
+      REQUIRE(product.GetMatrixValues() == (full * other).GetMatrixValues());
+      REQUIRE(vectorProduct == full * column);
+      REQUIRE(packed.GetDeterminant() == Approx(full.GetDeterminant()));
+      REQUIRE(packed.IsSingular() == (full.GetDeterminant() == 0));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Triangular systems are solved by substitution", "[TriangularMatrix][Template]", double, float)
+{
+  const Matrix<TestType> matrix(CreateDominantValues<TestType>(12, 12, 3));
+  const Matrix<TestType> rightHandSides(CreateDominantValues<TestType>(12, 3, 7));
+
+  for (const auto triangle : { Triangle::Upper, Triangle::Lower })
+  {
+    SECTION(triangle == Triangle::Upper ? "Upper" : "Lower")
+    {
+      // Arrange
+      const TriangularMatrix<TestType> packed(matrix, triangle);
+      const auto vector = rightHandSides.Transpose().GetMatrixValues()[1];
+
+      // Act
+      const auto solution = packed.Solve(rightHandSides);
+      const auto vectorSolution = packed.Solve(vector);
+
+      // Assert
+      const auto restored = (packed * solution).GetMatrixValues();
+      const auto restoredVector = packed * vectorSolution;
+      for (unsigned i = 0; i < 12; ++i)
+      {
+        REQUIRE(vectorSolution[i] == Approx(solution.GetMatrixValues()[i][1]));
+        REQUIRE(restoredVector[i] == Approx(vector[i]).margin(1e-4));
+        for (unsigned j = 0; j < 3; ++j)
+          REQUIRE(restored[i][j] == Approx(rightHandSides.GetMatrixValues()[i][j]).margin(1e-4));
+      }
+    }
+  }
+}
+
+TEST_CASE("Singular triangular system cannot be solved", "[TriangularMatrix]")
+{
+  const TriangularMatrix<double> matrix(Matrix<double>(std::vector<std::vector<double>> { { 1, 2 }, { 0, 0 } }), Triangle::Upper);
+
+  REQUIRE(matrix.GetDeterminant() == 0);
+  REQUIRE(matrix.GetMatrixType() == (Type::Invertable | Type::UpperTriangular));
+  REQUIRE(matrix.IsSingular());
+  REQUIRE_THROWS_AS(matrix.Solve(std::vector<double> { 1, 1 }), InvertableMatrixOperationException);
+  REQUIRE_THROWS_AS(matrix.Solve(std::vector<double> { 1 }), MatrixDimensionException);
+}
@@ -0,0 +1,100 @@
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/TridiagonalMatrix.hpp"
+
+using namespace Common::Math;
+
+template <typename T>
+static TridiagonalMatrix<T> CreateTridiagonal(const unsigned size, const T diagonal)
+{
+  std::vector<T> lower(size - 1), values(size), upper(size - 1);
+  for (unsigned i = 0; i < size; ++i)
+  {
+    values[i] = diagonal + static_cast<T>(i % 3);
+    if (i + 1 < size)
+    {
+      lower[i] = static_cast<T>(i % 5) - 2;
+      upper[i] = static_cast<T>(i % 4) - 1;
+    }
+  }
+
+  return TridiagonalMatrix<T>(lower, values, upper);
+}
+
+// STORAGE
+
+TEST_CASE("Tridiagonal matrix validates its diagonals", "[TridiagonalMatrix]")
+{
+  REQUIRE_NOTHROW(TridiagonalMatrix<double>({ }, { 1 }, { }));
+  REQUIRE_THROWS_AS(TridiagonalMatrix<double>(0), std::invalid_argument);
+  REQUIRE_THROWS_AS(TridiagonalMatrix<double>({ 1 }, { 1, 2 }, { }), std::invalid_argument);
+  REQUIRE_THROWS_AS(TridiagonalMatrix<double>({ 1, 2 }, { 1, 2 }, { 1 }), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("Tridiagonal matrix expands to full storage", "[TridiagonalMatrix][Template]", int, long, double, float)
+{
+  // Arrange
+  const TridiagonalMatrix<TestType> matrix({ 1, 2 }, { 3, 4, 5 }, { 6, 7 });
+
+  // Act
+  const auto values = matrix.ToMatrix().GetMatrixValues();
+
+  // Assert
+  REQUIRE(values == std::vector<std::vector<TestType>> { { 3, 6, 0 }, { 1, 4, 7 }, { 0, 2, 5 } });
+  REQUIRE(matrix.Get(2, 0) == 0);
+  REQUIRE(matrix.Get(1, 0) == 1);
+}
+
+// OPERATIONS
+
+TEMPLATE_TEST_CASE("Tridiagonal product and determinant equal the full ones", "[TridiagonalMatrix][Template]", int, long, double, float)
+{
+  // Arrange
+  const auto matrix = CreateTridiagonal<TestType>(8, 2);
+  std::vector<TestType> vector(8);
+  for (unsigned i = 0; i < 8; ++i)
+    vector[i] = static_cast<TestType>(i % 3) - 1;
+
+  // Act
+  const auto product = matrix * vector;
+  const auto determinant = matrix.GetDeterminant();
+
+  // Assert
+  REQUIRE(product == matrix.ToMatrix() * vector);
+  REQUIRE(determinant == Approx(matrix.ToMatrix().GetDeterminant()));
+}
+
+TEMPLATE_TEST_CASE("Tridiagonal systems are solved by the Thomas algorithm", "[TridiagonalMatrix][Template]", double, float)
+{
+  for (const unsigned size : { 1u, 2u, 17u, 100000u })
+  {
+    SECTION("Size: " + std::to_string(size))
+    {
+      // Arrange
+      const auto matrix = CreateTridiagonal<TestType>(size, 8);
+      std::vector<TestType> vector(size);
+      for (unsigned i = 0; i < size; ++i)
+        vector[i] = static_cast<TestType>(i % 7) - 3;
+
+      // Act
+      const auto solution = matrix.Solve(vector);
+
+      // Assert
+      const auto restored = matrix * solution;
+      const auto banded = matrix.ToBandMatrix().Solve(vector);
+      for (unsigned i = 0; i < size; ++i)
+      {
+        REQUIRE(restored[i] == Approx(vector[i]).margin(1e-4));
+        REQUIRE(solution[i] == Approx(banded[i]).margin(1e-5));
+      }
+    }
+  }
+}
+
+TEST_CASE("Tridiagonal system without a usable pivot is rejected", "[TridiagonalMatrix]")
+{
+  const TridiagonalMatrix<double> matrix({ 1 }, { 0, 1 }, { 1 });
+
+  REQUIRE_THROWS_AS(matrix.Solve({ 1, 1 }), InvertableMatrixOperationException);
+  REQUIRE(matrix.ToBandMatrix().Solve({ 1, 1 }) == std::vector<double> { 0, 1 });
+}
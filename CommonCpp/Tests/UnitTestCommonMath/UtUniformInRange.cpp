@@ -0,0 +1,165 @@
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../catch.hpp"
+#include "../../CommonMath/UniformInRange.hpp"
+
+using namespace Common::Math;
+
+/**
+ * \brief Generator returning a scripted sequence of 32-bit words
+ */
+class ScriptedGenerator
+{
+  std::vector<std::uint32_t> m_words;
+  std::size_t m_next = 0;
+
+public:
+  using result_type = std::uint32_t;
+
+  explicit ScriptedGenerator(std::vector<std::uint32_t> words) : m_words(std::move(words)) { }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+  result_type operator ()() { return m_words.at(m_next++); }
+
+  std::size_t GetDrawn() const { return m_next; }
+};
+
+template <typename T>
+static std::vector<std::pair<T, T>> GetRanges()
+{
+  std::vector<std::pair<T, T>> ranges { { 0, 1 }, { 0, 5 }, { 0, 99 }, { 0, 127 }, { 3, 9 },
+    { std::numeric_limits<T>::min(), std::numeric_limits<T>::max() },
+    { static_cast<T>(std::numeric_limits<T>::max() - 4), std::numeric_limits<T>::max() },
+    { std::numeric_limits<T>::min(), static_cast<T>(std::numeric_limits<T>::max() / 3 * 2) } };
+  if constexpr (std::is_signed<T>::value)
+  {
+    ranges.emplace_back(-3, 4);
+    ranges.emplace_back(-180, 179);
+  }
+
+  return ranges;
+}
+
+// DRAWING
+
+TEMPLATE_TEST_CASE("Drawn values lie in range", "[UniformInRange][Template]", short, int, unsigned, long long, unsigned long long)
+{
+  std::mt19937 generator32(1);
+  std::mt19937_64 generator64(2);
+  std::minstd_rand generatorPartial(3);
+
+  for (const auto &[min, max] : GetRanges<TestType>())
+  {
+    // Arrange
+    const UniformInRange<TestType> distribution(min, max);
+    std::vector<TestType> filled(1001), filledSplit(1001), filledPartial(1001);
+
+    // Act
+    distribution.Fill(generator32, filled.data(), filled.size());
+    distribution.Fill(generator64, filledSplit.data(), filledSplit.size());
+    distribution.Fill(generatorPartial, filledPartial.data(), filledPartial.size());
+
+    // Assert
+    REQUIRE(distribution.GetMin() == min);
+    REQUIRE(distribution.GetMax() == max);
+    for (std::size_t i = 0; i < filled.size(); ++i)
+    {
+      for (const auto value : { distribution(generator32), distribution(generator64), distribution(generatorPartial), filled[i], filledSplit[i], filledPartial[i] })
+      {
+        REQUIRE(value >= min);
+        REQUIRE(value <= max);
+      }
+    }
+  }
+}
+
+TEST_CASE("Drawn values cover the range evenly", "[UniformInRange]")
+{
+  // Arrange
+  const UniformInRange<int> distribution(-3, 2);
+  std::mt19937 generator(42);
+  std::vector<int> values(60000);
+  std::vector<int> counts(6);
+
+  // Act
+  distribution.Fill(generator, values.data(), values.size() / 2);
+  for (auto i = values.size() / 2; i < values.size(); ++i)
+    values[i] = distribution(generator);
+  for (const auto value : values)
+    ++counts[value + 3];
+
+  // Assert
+  for (const auto count : counts)
+  {
+    REQUIRE(count > 9500);
+    REQUIRE(count < 10500);
+  }
+}
+
+TEST_CASE("Drawn values are not biased like wrapped words", "[UniformInRange]")
+{
+  // Arrange, wrapping 32-bit words into a range of 3 * 2^30 values draws the first third twice as often
+  const unsigned max = 3u * (1u << 30) - 1;
+  const UniformInRange<unsigned> distribution(0, max);
+  std::mt19937 generator(7);
+  std::vector<unsigned> values(30000);
+
+  // Act
+  distribution.Fill(generator, values.data(), values.size());
+  std::size_t low = 0, lowWrapped = 0;
+  for (const auto value : values)
+  {
+    low += value < (1u << 30);
+    lowWrapped += NumberInRange<unsigned>::AdjustValue(static_cast<unsigned>(generator()), 0, max) < (1u << 30);
+  }
+
+  // Assert
+  REQUIRE(low > 9500);
+  REQUIRE(low < 10500);
+  REQUIRE(lowWrapped > 14000);
+}
+
+// REJECTION
+
+TEST_CASE("Words of the biased remainder are rejected", "[UniformInRange]")
+{
+  // Arrange, 2^32 mod 3 is 1 so only the word zero is rejected
+  const UniformInRange<int> distribution(10, 12);
+  ScriptedGenerator single({ 0, 0, 0xFFFFFFFFu });
+  ScriptedGenerator batch({ 0x55555556u, 0, 0xAAAAAAABu, 0x80000000u, 0x55555555u });
+  std::vector<int> values(4);
+
+  // Act
+  const auto value = distribution(single);
+  distribution.Fill(batch, values.data(), values.size());
+
+  // Assert
+  REQUIRE(value == 12);
+  REQUIRE(single.GetDrawn() == 3);
+  REQUIRE(values == std::vector<int> { 11, 10, 12, 11 });
+  REQUIRE(batch.GetDrawn() == 5);
+}
+
+TEST_CASE("Distribution takes the range of a number", "[UniformInRange]")
+{
+  // Arrange
+  const NumberInRange<long long, RangePolicy::Saturate> number(0, -5, 5);
+  std::mt19937_64 generator(5);
+
+  // Act
+  const UniformInRange<long long> distribution(number);
+  const auto value = distribution(generator);
+
+  // Assert
+  REQUIRE(distribution.GetMin() == -5);
+  REQUIRE(distribution.GetMax() == 5);
+  REQUIRE(value >= -5);
+  REQUIRE(value <= 5);
+  REQUIRE_THROWS_AS(UniformInRange<int>(5, 5), std::invalid_argument);
+  REQUIRE_THROWS_AS(UniformInRange<int>(6, 5), std::invalid_argument);
+}